@@ -0,0 +1,252 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../utils/Defines.h"
+
+/*
+	Parent name space
+*/
+namespace cmll
+{
+	/*
+		Name space for data related operations, functions and classes
+	*/
+	namespace data
+	{
+	/**
+		* Class Name : BatchReader
+
+		* Class Description : Reader of numeric delimited files (csv) that hands out the observations in batches of at most BatchSize rows,
+							  so files larger than the memory can be learned from batch by batch (for example with KMeans::partialFit()).
+							  Only the current batch is held in memory and its rows are reused from one batch to the next.
+							  Unlike cmll::data::read() values are not label encoded : every value has to be a number and every row
+							  has to have as many values as the first one.
+
+		* Attributes :
+
+		1) BatchSize : Maximum number of observations in a batch
+
+		2) ColumnNames : Names read from the first row (empty if the file has no header)
+
+		* Functions :
+
+		1) _parse @protected
+
+		2) _readHeader @protected
+
+		3) next
+
+		4) rows
+
+		*
+		*/
+		class BatchReader
+		{
+		protected:
+
+			// Owned file (when constructed from a file name) with its read buffer, and the stream actually read
+			std::vector<char> _buffer;
+			std::ifstream _file;
+			std::istream* _in;
+
+			std::string _line;
+			char _columnSeparator;
+			char _rowSeparator;
+			std::size_t _cols;
+			std::size_t _rows;
+
+		/**
+		   * Function Name :  parse (internal)
+
+		   * Function Description :  Function to read the values of _line into a row
+
+		   * Parameters :
+
+		   1) row :			The row to fill (its memory is reused)
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If a value is not a number or the row does not have as many values as the first one
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _parse(std::vector<double>& row); // throws std::runtime_error
+
+		/**
+		   * Function Name :  read header (internal)
+
+		   * Function Description :  Function to read the column names from the first row
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _readHeader();
+
+		public:
+
+			std::size_t BatchSize;
+			std::vector<std::string> ColumnNames;
+
+		/**
+		   * Constructor Name : BatchReader[Parameterized]
+
+		   * Constructor Description :  Constructor to open a file and read its header
+
+		   * Parameters :
+
+		   1) filename			The file to read
+
+								Type Expected : std::string
+
+								Method of passing :  constant and by reference
+
+		   2) batchSize			Maximum number of observations in a batch
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   3) header			If the first row holds the names of the columns
+
+								Type Expected : bool
+
+								Method of passing :  constant and by reference
+
+		   4) columnSeparator	The delimiter for values
+
+								Type Expected : char
+
+								Method of passing :  constant and by reference
+
+		   5) rowSeparator		The delimiter for rows
+
+								Type Expected : char
+
+								Method of passing :  constant and by reference
+
+		   * Throws    :  std::runtime_error : If the file can not be opened
+
+		   * Example
+
+			   #include<Data/BatchReader.h>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::data::BatchReader reader("Clicks.csv", 100000);
+
+				   cmll::data::Storage batch;
+
+				   while (reader.next(batch))
+				   {
+					   // batch holds the next observations
+				   }
+
+				   return 0;
+			   }
+
+		   */
+			BatchReader(const std::string& filename, const std::size_t& batchSize = static_cast<std::size_t>(defaults::BATCH_SIZE), const bool& header = true, const char& columnSeparator = ',', const char& rowSeparator = '\n'); // throws std::runtime_error
+
+		/**
+		   * Constructor Name : BatchReader[Parameterized]
+
+		   * Constructor Description :  Constructor to read from a stream (for example std::cin or a pipe from a decompressor).
+										  The stream has to outlive the reader
+
+		   * Parameters :
+
+		   1) in				The stream to read
+
+								Type Expected : std::istream
+
+								Method of passing :  by reference
+
+		   2) to 5)			As for the file name constructor
+
+		   * Example
+
+			   cmll::data::BatchReader reader(std::cin, 100000, false);
+
+		   */
+			BatchReader(std::istream& in, const std::size_t& batchSize = static_cast<std::size_t>(defaults::BATCH_SIZE), const bool& header = true, const char& columnSeparator = ',', const char& rowSeparator = '\n');
+
+			BatchReader(const BatchReader&) = delete;
+			BatchReader& operator=(const BatchReader&) = delete;
+
+		/**
+		   * Function Name :  next
+
+		   * Function Description :  Function to read the next observations. Empty rows are skipped
+
+		   * Parameters :
+
+		   1) batch :		The next (at most BatchSize) observations. Its rows are reused
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  by reference
+
+		   * Return :		bool - > false (and batch empty) once every observation has been read
+
+		   * Throws    :  std::runtime_error : If a value is not a number or a row does not have as many values as the first one
+		*/
+			bool next(Storage& batch); // throws std::runtime_error
+
+		/**
+		   * Function Name :  rows
+
+		   * Function Description :  Function to get the number of observations read so far
+
+		   * Return :		std::size_t - > observations read
+		*/
+			std::size_t rows() const noexcept;
+		};
+	}
+}
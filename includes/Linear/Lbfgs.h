@@ -0,0 +1,158 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <vector>
+
+#include "../utils/Defines.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		linear name space : Name space for linear models of regression and classification
+	*/
+	namespace linear
+	{
+	/**
+		* Class Name : Lbfgs
+
+		* Class Description : Limited memory BFGS minimizer of a smooth function (Nocedal and Wright, Algorithm 7.5).
+							  The inverse Hessian is never formed : the last History steps and gradient changes (2 x History vectors)
+							  give the search direction by the two loop recursion, so memory is O(History x variables) instead of
+							  the O(variables^2) of Newton's method. The step length is found by backtracking until the Armijo
+							  condition holds, and a pair is only kept when its curvature is positive.
+							  Stops once the largest gradient value is at most Tolerance, when the function stops decreasing, or
+							  after MaximumIterations iterations.
+
+		* Attributes :
+
+		1) History : Pairs of steps and gradient changes kept (m)
+
+		2) MaximumIterations : Maximum iterations
+
+		3) Tolerance : Largest gradient value at which the minimization stops
+
+		* Functions :
+
+		1) minimize
+
+		*
+		*/
+		class Lbfgs
+		{
+		public:
+
+			// The function to minimize : returns its value at x and writes its gradient
+			typedef std::function<double(const std::vector<double>&, std::vector<double>&)> Objective;
+
+			std::size_t History;
+			std::size_t MaximumIterations;
+			double Tolerance;
+
+		/**
+		   * Constructor Name : Lbfgs[Parameterized]
+
+		   * Constructor Description :  Constructor to load the options of the minimization
+
+		   * Parameters :
+
+		   1) history			Pairs of steps and gradient changes kept
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   2) maximumIterations	Maximum iterations
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   3) tolerance			Largest gradient value at which the minimization stops
+
+								Type Expected : double
+
+								Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<Linear/Lbfgs.h>
+
+			   int main()
+			   {
+				   cmll::linear::Lbfgs minimizer(10, 200);
+
+				   std::vector<double> x(2, 0);
+
+				   // (x0 - 1)^2 + 10 (x1 + 2)^2
+				   minimizer.minimize([](const std::vector<double>& x, std::vector<double>& gradient)
+				   {
+					   gradient = { 2 * (x[0] - 1), 20 * (x[1] + 2) };
+					   return (x[0] - 1) * (x[0] - 1) + 10 * (x[1] + 2) * (x[1] + 2);
+				   }, x);
+
+				   return 0;
+			   }
+
+		   */
+			Lbfgs(const std::size_t& history = static_cast<std::size_t>(defaults::HISTORY), const std::size_t& maximumIterations = static_cast<std::size_t>(defaults::MAXIMUM_ITERATIONS), const double& tolerance = defaultsd::TOLERANCE);
+
+		/**
+		   * Function Name :  minimize
+
+		   * Function Description :  Function to minimize a function starting from x
+
+		   * Parameters :
+
+		   1) objective :	The function and its gradient
+
+							Type Expected : Objective
+
+							Method of passing :  constant and by reference
+
+		   2) x :			The starting point and the minimum found
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  by reference
+
+		   * Return :		std::size_t - > iterations run
+		*/
+			std::size_t minimize(const Objective& objective, std::vector<double>& x) const;
+		};
+	}
+}
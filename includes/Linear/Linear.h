@@ -15,7 +15,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 15, 2020
-	* Last modified : April 16, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (0.1.0)
 
@@ -30,12 +30,23 @@
 	All the includes and functions are to be aligned in the alphabetical order Classes are aligned on basis of inheritance
 */
 #include<algorithm>
+#include<cmath>
+#include<functional>
+#include<future>
 #include<iostream>
+#include<numeric>
+#include<random>
+#include<stdexcept>
+#include<vector>
 
+#include"../Data/BatchReader.h"
 #include"../numeric/Array.h"
 #include"../utils/Defines.h"
 #include"../numeric/Function.h"
 #include"../numeric/Matrix.h"
+#include"../utils/Parallel.h"
+#include"Lbfgs.h"
+#include"Sgd.h"
 
 
 
@@ -58,39 +69,1434 @@ namespace cmll
 
         * Attributes :
 
-	    1) Coefficients : The variable holding calculated coefficients
+	    1) BatchSize : Observations per step of the SGD solver
+						   Type : std::size_t
+
+	    2) Coefficients : The variable holding calculated coefficients
 						   Type : cmll::data::Storage
 
-        * Functions : 
-        
-        1) model 
+	    3) Epochs : Maximum passes over the observations of the SGD solver
+						   Type : std::size_t
+
+	    4) Iterations : Iterations the CG or LSQR solver (epochs the SGD solver) ran for, the most over the outputs, on the last fit
+						   Type : std::size_t
+
+	    5) LearningRate : Initial step size of the SGD solver
+						   Type : double
+
+	    6) MaximumIterations : Maximum iterations of the CG and LSQR solvers
+						   Type : std::size_t
+
+	    7) Preconditioning : If the CG and LSQR solvers scale the features by the diagonal of X^T X (Jacobi preconditioning)
+						   Type : bool
+
+	    8) Schedule : How the step size of the SGD solver decreases (see cmll::linear::ScheduleType)
+						   Type : cmll::linear::ScheduleType
+
+	    9) Seed : Seed for the order of the observations in the SGD solver
+						   Type : unsigned int
+
+	    10) Solver : How the coefficients are solved for (see cmll::linear::SolverType)
+						   Type : cmll::linear::SolverType
+
+	    11) Threads : Threads used for adding up X^T X and X^T y, for the products by X and for SGD (0 for all hardware threads)
+						   Type : std::size_t
+
+	    12) Tolerance : Relative residual at which the CG and LSQR solvers stop (relative improvement of an epoch for SGD)
+						   Type : double
+
+	    13) WarmStart : If the CG, LSQR and SGD solvers start from the current coefficients (when they have the right shape)
+						   Type : bool
+
+        * Functions : 
+
+        1) _accumulate @protected
+
+        2) _conjugateGradient @protected
+
+        3) _fit @protected
+
+        4) _iterate @protected
+
+        5) _lsqr @protected
+
+        6) _product @protected
+
+        7) _solve @protected
+
+        8) _squares @protected
+
+        9) _transposedProduct @protected
+
+        10) accumulate
+
+        11) begin
+
+        12) finalize
+
+        13) merge
+        
+        14) model 
+        
+        15) predict
+
+        16) rss
+
+        17) score
+
+        18) tss
+         
+        *
+        */
+        class LinearRegression
+        {
+        protected:
+
+            /*
+                Sums of the observations added since begin() : the upper triangle of X^T X ( features X features ) and X^T y ( features X outputs ).
+                Their size does not depend on the number of observations
+            */
+            std::vector<double> _gram;
+            std::vector<double> _moment;
+            std::size_t _features;
+            std::size_t _outputs;
+            std::size_t _observations;
+
+            /**
+            * Function Name :  accumulate (internal)
+
+            * Function Description :  Function to add the observations of a chunk to the sums. The chunk is cut into a fixed number of
+                                      row blocks (whatever the number of threads, so the sums do not depend on it) and the rows of
+                                      X^T X into ranges of equal work, and threads take the (block, range) pairs
+
+            * Parameters :
+
+            1) X :			The feature matrix of the chunk
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction of the chunk. If empty, the columns of X after the first features are used
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            3) features :   Number of features (columns of X used as features)
+
+                            Type Expected : std::size_t
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            void _accumulate(const data::Storage& X, const data::Storage& y, const std::size_t& features);
+
+            // A product by a matrix given as a function ( vector -> result ), so the solvers work the same on dense and sparse X
+            typedef std::function<void(const std::vector<double>&, std::vector<double>&)> Operator;
+
+            /**
+            * Function Name :  conjugate gradient (internal)
+
+            * Function Description :  Function to solve ( A + penalty I ) b = rhs for a symmetric positive definite A with the
+                                      preconditioned conjugate gradient method, starting from b. Stops once the residual is at most
+                                      Tolerance times rhs, or after MaximumIterations iterations
+
+            * Parameters :
+
+            1) normal :		The product by A (X^T X)
+
+                            Type Expected : Operator
+
+                            Method of passing :  constant and by reference
+
+            2) diagonal :	The preconditioner (diagonal of A plus penalty, or ones)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            3) rhs :		The right hand side (X^T y)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            4) penalty :	Value added to the diagonal of A
+
+                            Type Expected : double
+
+                            Method of passing :  constant and by reference
+
+            5) b :			The starting point and the solution
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  by reference
+
+            * Return :		std::size_t - > iterations run
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            std::size_t _conjugateGradient(const Operator& normal, const std::vector<double>& diagonal, const std::vector<double>& rhs, const double& penalty, std::vector<double>& b) const;
+
+            /**
+            * Function Name :  fit (internal)
+
+            * Function Description :  Function to build the model with the penalty added to the diagonal of X^T X (0 for linear regression)
+                                      using the solver chosen in Solver. DIRECT accumulates X^T X (see _accumulate()), CG and LSQR only
+                                      multiply by X and X^T, SGD reads the observations in batches (see cmll::linear::Sgd).
+                                      With a sparse X, DIRECT is replaced by LSQR
+
+            * Parameters :
+
+            1) X :			The feature matrix (dense or sparse)
+
+                            Type Expected : cmll::data::Storage or cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            3) penalty :	Value added to the diagonal of X^T X
+
+                            Type Expected : double
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            void _fit(const data::Storage& X, const data::Storage& y, const double& penalty);
+            void _fit(const data::Sparse& X, const data::Storage& y, const double& penalty);
+
+            /**
+            * Function Name :  iterate (internal)
+
+            * Function Description :  Function to solve for every output (column of y) with CG or LSQR and store the coefficients
+
+            * Parameters :
+
+            1) product :	The product by X
+
+                            Type Expected : Operator
+
+                            Method of passing :  constant and by reference
+
+            2) transposedProduct :	The product by X^T
+
+                            Type Expected : Operator
+
+                            Method of passing :  constant and by reference
+
+            3) squares :	Sum of squares of every column of X (the diagonal of X^T X)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            4) y :		    Vector of prediction
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            5) penalty :	Value added to the diagonal of X^T X
+
+                            Type Expected : double
+
+                            Method of passing :  constant and by reference
+
+            6) solver :		CG or LSQR
+
+                            Type Expected : cmll::linear::SolverType
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            void _iterate(const Operator& product, const Operator& transposedProduct, const std::vector<double>& squares, const data::Storage& y, const double& penalty, const SolverType& solver);
+
+            /**
+            * Function Name :  lsqr (internal)
+
+            * Function Description :  Function to minimize ||X b - y||^2 + penalty ||b||^2 with LSQR (Golub-Kahan bidiagonalization of
+                                      X stacked over sqrt(penalty) I), starting from b. With preconditioning the columns are scaled by
+                                      1 / sqrt(diagonal). Stops once the residual or the normal equation residual is small
+                                      relative to Tolerance, or after MaximumIterations iterations
+
+            * Parameters :
+
+            1) product :	The product by X
+
+                            Type Expected : Operator
+
+                            Method of passing :  constant and by reference
+
+            2) transposedProduct :	The product by X^T
+
+                            Type Expected : Operator
+
+                            Method of passing :  constant and by reference
+
+            3) diagonal :	Diagonal of X^T X plus penalty (or ones)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            4) y :			The output
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            5) penalty :	The ridge penalty
+
+                            Type Expected : double
+
+                            Method of passing :  constant and by reference
+
+            6) b :			The starting point and the solution
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  by reference
+
+            * Return :		std::size_t - > iterations run
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            std::size_t _lsqr(const Operator& product, const Operator& transposedProduct, const std::vector<double>& diagonal, const std::vector<double>& y, const double& penalty, std::vector<double>& b) const;
+
+            /**
+            * Function Name :  product (internal)
+
+            * Function Description :  Function to multiply X by a vector, in parallel over blocks of rows
+
+            * Parameters :
+
+            1) X :			The feature matrix (dense or sparse)
+
+                            Type Expected : cmll::data::Storage or cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+
+            2) v :			The vector (one value per feature)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            3) result :		X v (one value per observation)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  by reference
+
+            * Return :		None
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            void _product(const data::Storage& X, const std::vector<double>& v, std::vector<double>& result) const;
+            void _product(const data::Sparse& X, const std::vector<double>& v, std::vector<double>& result) const;
+
+            /**
+            * Function Name :  solve (internal)
+
+            * Function Description :  Function to calculate the coefficients from the sums
+
+                                      Coefficients = ( X^T X + penalty I )^{-1} X^T y
+
+                                      by inverting with DIRECT, or with CG on the sums (products by X^T X) with CG and LSQR
+
+            * Parameters :
+
+            1) penalty :	Value added to the diagonal of X^T X
+
+                            Type Expected : double
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            void _solve(const double& penalty);
+
+            /**
+            * Function Name :  squares (internal)
+
+            * Function Description :  Function to calculate the sum of squares of every column of X (the diagonal of X^T X)
+
+            * Parameters :
+
+            1) X :			The feature matrix (dense or sparse)
+
+                            Type Expected : cmll::data::Storage or cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+
+            2) result :		The sums (one per feature)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  by reference
+
+            * Return :		None
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            void _squares(const data::Storage& X, std::vector<double>& result) const;
+            void _squares(const data::Sparse& X, std::vector<double>& result) const;
+
+            /**
+            * Function Name :  transposed product (internal)
+
+            * Function Description :  Function to multiply X^T by a vector. For a dense X threads take ranges of features and read
+                                      their columns of every row. For a sparse X threads add up a fixed number of blocks of rows,
+                                      whose sums are added in block order, so the result does not depend on the number of threads
+
+            * Parameters :
+
+            1) X :			The feature matrix (dense or sparse)
+
+                            Type Expected : cmll::data::Storage or cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+
+            2) u :			The vector (one value per observation)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            3) result :		X^T u (one value per feature)
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  by reference
+
+            * Return :		None
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            void _transposedProduct(const data::Storage& X, const std::vector<double>& u, std::vector<double>& result) const;
+            void _transposedProduct(const data::Sparse& X, const std::vector<double>& u, std::vector<double>& result) const;
+
+        public:
+
+            // Storage variable to hold coefficients
+            data::Storage Coefficients;
+
+            // Iterations of the last fit with CG or LSQR (epochs with SGD)
+            std::size_t Iterations;
+
+            // Options of the SGD solver
+            std::size_t BatchSize;
+            std::size_t Epochs;
+            double LearningRate;
+            ScheduleType Schedule;
+            unsigned int Seed;
+
+            // Options of the CG and LSQR solvers
+            std::size_t MaximumIterations;
+            bool Preconditioning;
+
+            // How the coefficients are solved for
+            SolverType Solver;
+
+            // Threads used for adding up the sums and for the products by X
+            std::size_t Threads;
+
+            double Tolerance;
+            bool WarmStart;
+
+           /**
+           * Constructor Name : LinearRegression[Parameterized]
+
+           * Constructor Description :  Constructor to load the number of threads. The solver is DIRECT, see the attributes for the others
+
+           * Parameters :
+
+           1) threads		Threads used for adding up X^T X and X^T y (0 for all hardware threads)
+
+                            Type Expected : std::size_t
+
+                            Method of passing :  constant and by reference
+
+           * Example
+
+               cmll::linear::LinearRegression l1(8);
+
+               // 50000 features : X^T X would take 20 GB
+               l1.Solver = cmll::linear::SolverType::LSQR;
+               l1.Tolerance = 1e-8;
+
+               // Or a few passes of stochastic gradient descent
+               l1.Solver = cmll::linear::SolverType::SGD;
+               l1.Epochs = 5;
+
+           */
+            LinearRegression(const std::size_t& threads = 0);
+
+            /* Functions */
+
+           /**
+            * Function Name :  accumulate
+
+            * Function Description :  Function to add a chunk of observations to the model without keeping them. Only X^T X and X^T y
+                                      are kept, so any number of chunks can be added in O(features^2) memory. finalize() calculates
+                                      the coefficients
+
+            * Parameters :
+
+            1) X :			The feature matrix of the chunk
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction of the chunk
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If X and y do not have the same number of rows or the columns differ from the earlier chunks (caught, the chunk is skipped)
+
+            * Example
+
+                #include<vector>
+                #include<linear/Linear.h>
+
+                int main()
+                {
+                    cmll::linear::LinearRegression l1;
+
+                    l1.begin();
+
+                    // Add the chunks one by one as they are read
+                    l1.accumulate(X1,y1);
+                    l1.accumulate(X2,y2);
+
+                    l1.finalize();
+
+                    return 0;
+
+                }
+
+
+            */
+            void accumulate(const data::Storage& X, const data::Storage& y);
+
+           /**
+            * Function Name :  accumulate
+
+            * Function Description :  Function to add every remaining batch of a reader. The last outputs columns of every row are
+                                      the vector of prediction and the others the features. The next batch is read and parsed on
+                                      its own thread while the current one is added, so only two batches are held in memory
+
+            * Parameters :
+
+            1) reader :		The reader of the observations
+
+                            Type Expected : cmll::data::BatchReader
+
+                            Method of passing :  by reference
+
+            2) outputs :	Number of columns (at the end of a row) holding the vector of prediction
+
+                            Type Expected : std::size_t
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If the reader finds a row that is not numeric or of the wrong size
+
+            * Example
+
+                #include<Data/BatchReader.h>
+                #include<linear/Linear.h>
+
+                int main()
+                {
+                    cmll::data::BatchReader reader("Sales.csv", 100000);
+
+                    cmll::linear::LinearRegression l1;
+
+                    l1.begin();
+                    l1.accumulate(reader);
+                    l1.finalize();
+
+                    return 0;
+
+                }
+
+
+            */
+            void accumulate(data::BatchReader& reader, const std::size_t& outputs = 1); // throws std::runtime_error
+
+           /**
+            * Function Name :  begin
+
+            * Function Description :  Function to start a new model : the observations added so far are forgotten
+
+            * Return :		None
+            */
+            void begin() noexcept;
+
+           /**
+            * Function Name :  finalize
+
+            * Function Description :  Function to calculate the coefficients from the observations added since begin().
+                                      More observations can be added afterwards and finalize() called again
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If no observation has been added (caught, the coefficients are not changed)
+            */
+            void finalize();
+
+           /**
+            * Function Name :  merge
+
+            * Function Description :  Function to add the observations added to another model, for example one that was given other
+                                      chunks on another thread or machine. The sums are added, so merging gives the same model as
+                                      adding every chunk to one model
+
+            * Parameters :
+
+            1) other :		The model to merge
+
+                            Type Expected : cmll::linear::LinearRegression
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If the models do not have the same number of features and outputs (caught, nothing is merged)
+
+            * Example
+
+                cmll::linear::LinearRegression l1, l2;
+
+                l1.accumulate(X1,y1);
+                l2.accumulate(X2,y2);
+
+                l1.merge(l2);
+                l1.finalize();
+
+            */
+            void merge(const LinearRegression& other);
+
+           /**
+            * Function Name :  model
+
+            * Function Description :  Function to built a linear regression model using Feature Matrix X and vector of prediction y.
+                                      Same as begin(), accumulate(X,y) and finalize()
+
+            * Parameters :
+
+            1) X :			The feature matrix
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+
+            * Example
+
+                #include<vector>
+                #include<linear/Linear.h>
+
+                int main()
+                {
+                    // vector creation and element adding here
+
+                    cmll::linear::LinearRegression l1;
+
+                    l1.model(X,y);
+
+                    return 0;
+
+                }
+
+
+            */
+            void model(const data::Storage& X, const data::Storage& y) noexcept;
+
+           /**
+            * Function Name :  model
+
+            * Function Description :  Function to built a linear regression model from a sparse feature matrix. Only the non zero values
+                                      are read, with CG or LSQR (LSQR when Solver is DIRECT)
+
+            * Parameters :
+
+            1) X :			The feature matrix
+
+                            Type Expected : cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction (one row per row of X)
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Example
+
+                cmll::data::Sparse X;
+
+                // Fill X.Rows, X.Cols, X.Offsets, X.Indexes and X.Values here
+
+                cmll::linear::LinearRegression l1;
+
+                l1.Solver = cmll::linear::SolverType::CG;
+
+                l1.model(X,y);
+
+            */
+            void model(const data::Sparse& X, const data::Storage& y) noexcept;
+
+           /**
+            * Function Name :  predict
+
+            * Function Description :  Function to predict using linear regression model built by model()
+
+            * Parameters :
+
+            1) XTest :		The test set feature matrix
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+            
+            2) result :		The predicted values
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  by reference
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If the coefficient vector is empty
+
+            * Example
+
+                #include<vector>
+                #include<linear/Linear.h>
+
+                int main()
+                {
+                    // vector creation and element adding here
+
+                    cmll::linear::LinearRegression l1;
+
+                    l1.model(X,y);
+
+                    l1.predict(XTest,result);
+
+                    return 0;
+
+                }
+
+
+            */
+            void predict(const data::Storage& XTest, data::Storage& result); //throws std::runtime_error
+
+           /**
+            * Function Name :  predict
+
+            * Function Description :  Function to predict for a sparse test set. result is resized to hold one row per observation
+
+            * Parameters :
+
+            1) XTest :		The test set feature matrix
+
+                            Type Expected : cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+            
+            2) result :		The predicted values
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  by reference
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If the coefficient vector is empty
+            */
+            void predict(const data::Sparse& XTest, data::Storage& result); //throws std::runtime_error
+
+           /**
+           * Function Name :  RSS
+
+           * Function Description :  Function to calculate Residual Sum of Squares of the model
+
+           * Parameters :
+
+           1) yPred:		The predicted values by the model
+
+                           Type Expected : cmll::data::Storage
+
+                           Method of passing :  constant and by reference
+
+           2) y:	        The actual values
+
+                           Type Expected : cmll::data::Storage
+
+                           Method of passing :  constant and by reference
+
+
+           * Return :		Residual sum of squares calculated
+
+
+           * Example
+
+               #include<vector>
+               #include<linear/Linear.h>
+               #include<iostream>
+
+               int main()
+               {
+                   // vector creation and element adding here
+
+                   cmll::linear::LinearRegression l1;
+
+                   l1.model(X,y);
+
+                   l1.predict(XTest,y_pred);
+
+                   std::cout<<l1.rss(yPred,y);
+
+                   return 0;
+
+               }
+
+
+           */
+            double rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+
+           /**
+            * Function Name :  score
+
+            * Function Description :  Function to calculate R^2 score of the linear Regression model built
+
+            * Parameters :
+
+            1) yPred:		The predicted values by the model
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            2) y:	        The actual values
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+
+            * Return :		R^2 score calculated
+
+
+            * Example
+
+                #include<vector>
+                #include<linear/Linear.h>
+                #include<iostream>
+
+                int main()
+                {
+                    // vector creation and element adding here
+
+                    cmll::linear::LinearRegression l1;
+
+                    l1.model(X,y);
+
+                    auto yPred = l1.predict(XTest);
+
+                    std::cout<<l1.score(yPred,y);
+
+                    return 0;
+
+                }
+
+
+            */
+            double score(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+
+           
+
+           /**
+           * Function Name :  TSS
+
+           * Function Description :  Function to calculate Total Sum of Squares of the model
+
+           * Parameters :
+
+           1) y:	        The actual values
+
+                           Type Expected : cmll::data::Storage
+
+                           Method of passing :  constant and by reference
+
+
+           * Return :		Total sum of squares calculated
+
+
+           * Example
+
+               #include<vector>
+               #include<linear/Linear.h>
+               #include<iostream>
+
+               int main()
+               {
+                   // vector creation and element adding here
+
+                   cmll::linear::LinearRegression l1;
+
+                   std::cout<<l1.tss(y);
+
+                   return 0;
+
+               }
+
+
+           */
+            double tss(const data::Storage& y) noexcept;
+
+        };
+
+        /**
+        * Class Name : RidgeRegression
+
+        * Class Description : Class containing functions required for building a Ridge regression model
+
+        * Attributes :
+
+        1) Gcv : Generalized cross validation error of every penalty of the last fitPath()
+
+        2) Lambda :  The value of Lambda penalty
+
+        3) Lambdas : The penalties of the last fitPath()
+
+        4) LeaveOneOut : Leave one out error of every penalty of the last fitPath()
+
+        5) Path : The coefficients for every penalty of the last fitPath()
+
+        * Functions :
+
+        1) accumulate - @inherited
+
+        2) begin - @inherited
+
+        3) finalize - @overriden
+
+        4) fitPath
+
+        5) merge - @inherited
+
+        6) model - @overriden
+
+        7) predict - @inherited
+
+		8) rss - @inherited
+
+		9) tss - @inherited
+
+        10) score - @inherited
+
+        */
+        class RidgeRegression : public LinearRegression
+        {
+        public:
+
+            // Penalty 
+            double Lambda;
+
+            // Penalties of the last fitPath(), their coefficients and their errors
+            std::vector<double> Gcv;
+            std::vector<double> Lambdas;
+            std::vector<double> LeaveOneOut;
+            std::vector<data::Storage> Path;
+
+           /**
+           * Constructor Name : RidgeRegression[Parameterized]
+
+           * Constructor Description :  Constructor to load value of lambda 
+
+           * Parameters :
+
+           1) lambda		    The penalty 
+
+                            Type Expected : double
+
+                            Method of passing :  constant
+
+           2) threads		Threads used for adding up X^T X and X^T y (0 for all hardware threads)
+
+                            Type Expected : std::size_t
+
+                            Method of passing :  constant and by reference
+
+
+           * Example
+
+               #include<vector>
+               #include<linear/Linear.h>
+               #include<iostream>
+
+               int main()
+               {
+
+                   cmll::linear::RidgeRegression r1(10);
+
+                   return 0;
+
+               }
+
+
+           */
+            RidgeRegression(const double lambda = static_cast<double>(defaults::LAMBDA), const std::size_t& threads = 0);
+
+           /**
+            * Function Name :  finalize
+
+            * Function Description :  Function to calculate the ridge coefficients from the observations added since begin()
+                                      (see LinearRegression::finalize()). Lambda is read here, so the same sums can be solved for several penalties
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If no observation has been added (caught, the coefficients are not changed)
+            */
+            void finalize();
+
+            /**
+            * Function Name :  fit path
+
+            * Function Description :  Function to solve for every penalty of lambdas from a single eigen decomposition
+                                      X^T X = V diag(e) V^T, so that
+
+                                                b(lambda) = V diag( 1 / (e + lambda) ) V^T X^T y
+
+                                      costs O(features^2) per penalty instead of a new X^T X and inverse. For every penalty the
+                                      exact leave one out error ( mean of ( r_i / (1 - h_ii) )^2, h_ii = x_i^T (X^T X + lambda I)^{-1} x_i )
+                                      and the generalized cross validation error ( (RSS / N) / (1 - trace(H) / N)^2 ) are kept in
+                                      LeaveOneOut and Gcv (averaged over the outputs). The h_ii of every penalty come from one more pass
+                                      over X, in parallel over blocks of rows.
+                                      Lambda and Coefficients are set to the penalty with the smallest leave one out error
+
+            * Parameters :
+
+            1) X :			The feature matrix
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            3) lambdas :	The penalties
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+
+            * Example
+
+                #include<vector>
+                #include<linear/Linear.h>
+
+                int main()
+                {
+                    // vector creation and element adding here
+
+                    cmll::linear::RidgeRegression r1;
+
+                    r1.fitPath(X,y,{ 0.01, 0.1, 1, 10, 100 });
+
+                    // r1.Lambda is the penalty with the smallest r1.LeaveOneOut, r1.Coefficients its coefficients
+
+                    return 0;
+
+                }
+            */
+            void fitPath(const data::Storage& X, const data::Storage& y, const std::vector<double>& lambdas) noexcept;
+
+            /**
+            * Function Name :  model
+
+            * Function Description :  Function to built a ridge regression model using Feature Matrix X and vector of prediction y.
+                                      Same as begin(), accumulate(X,y) and finalize()
+
+            * Parameters :
+
+            1) X :			The feature matrix
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+
+            * Example
+
+                #include<vector>
+                #include<linear/Linear.h>
+
+                int main()
+                {
+                    // vector creation and element adding here
+
+                    cmll::linear::RidgeRegression l1;
+
+                    l1.model(X,y);
+
+                    return 0;
+
+                }
+
+
+            */
+            void model(const data::Storage& X, const data::Storage& y) noexcept;
+
+            /**
+            * Function Name :  model
+
+            * Function Description :  Function to built a ridge regression model from a sparse feature matrix (see LinearRegression::model())
+
+            * Return :		None
+            */
+            void model(const data::Sparse& X, const data::Storage& y) noexcept;
+
+        };
+
+        /**
+        * Class Name : RidgeClassifier
+
+        * Class Description : Class containing functions required for building a Ridge classifier model
+
+        * Attributes :
+
+        1) Classes : Number of distinct classes
+
+        2) Lambda :  The value of Lambda penalty @inherited
+
+        3) Method : Either binary classification for Multi class
+
+        4) Y : The vector of prediction
+
+        * Functions :
+
+        1) _binarizer   @protected
         
-        2) predict
+        2) _decoder @protected
 
-        3) rss
+        3) _encoder @protected
 
-        4) score
+        4) _scores @protected
+
+        5) _sign @protected
+
+        6) accumulate - @privateScoped
+
+        7) begin - @privateScoped
+
+        8) finalize - @privateScoped
+
+        9) merge - @privateScoped
+
+        10) model - @overriden and called
+
+        11) predict - @overriden
+
+        12) predictScores
+		
+        13) rss - @privateScoped
+
+		14) tss - @privateScoped
+
+        15) score - @overrriden
+
+        
 
-        5) tss
-         
-        *
         */
-        class LinearRegression
+        class RidgeClassifier : public RidgeRegression
         {
+        protected:
+            
+			/*
+                In a classification setting, rss and tss are not required
+            */
+            using RidgeRegression::rss;
+			using RidgeRegression::tss;
+
+            /*
+                The labels have to be encoded before they are added up, so the classifier is only built with model()
+            */
+            using RidgeRegression::accumulate;
+            using RidgeRegression::begin;
+            using RidgeRegression::finalize;
+            using RidgeRegression::merge;
+
+            /**
+            * Function Name : Binarizer
+
+            * Function Description :  Function to encode create a multi output regression scenario with labels either -1 or 1
+
+            * Parameters :
+
+            1) yNew :			The new Y, encoded
+
+                                Type Expected : multidimensional vector
+
+                                Method of passing :  reference
+
+            * Return :		None
+
+
+            * Example
+
+               This function is internal and protected ;
+
+
+            */
+            void _binarizer(data::Storage& yNew) noexcept;
+
+            /**
+            * Function Name : Decoder
+
+            * Function Description :  Function to set the values earlier set to -1 to value
+
+            * Parameters :
+
+            1) value :			The value to place instead of -1
+
+                                Type Expected : double
+
+                                Method of passing :  constant
+
+            * Return :		None
+
+
+            * Example
+
+               This function is internal and protected ;
+
+
+            */
+            void _decoder(const double value) noexcept;
+
+
+            /**
+            * Function Name : Encoder
+
+            * Function Description :  Function to encode specific labels to -1 and rest to 1
+
+            * Parameters :
+
+            1) value :			The value to encode to -1
+
+                                Type Expected : double
+
+                                Method of passing :  constant 
+
+            * Return :		None
+
+
+            * Example
+
+               This function is internal and protected ;
+
+
+            */
+            void _encoder(const double value) noexcept;
+
+            /**
+            * Function Name : scores
+
+            * Function Description :  Function to multiply a block of rows of XTest by the Coefficients ( features X classes ) in one pass :
+                                      every coefficient row is read once per block and added, times x_ij, to the scores of every
+                                      row of the block, so it stays in cache while the block is scanned
+
+            * Parameters :
+
+            1) XTest :			The test set feature matrix
+
+                                Type Expected : cmll::data::Storage
+
+                                Method of passing :  constant and by reference
+
+            2) first :			First row of the block
+
+                                Type Expected : std::size_t
+
+                                Method of passing :  constant and by reference
+
+            3) last :			Row after the last row of the block
+
+                                Type Expected : std::size_t
+
+                                Method of passing :  constant and by reference
+
+            4) scores :			The scores of the block ( (last - first) X classes, row major, overwritten )
+
+                                Type Expected : double*
+
+                                Method of passing :  by pointer
+
+            * Return :		None
+
+
+            * Example
+
+               This function is internal and protected ;
+
+
+            */
+            void _scores(const data::Storage& XTest, const std::size_t& first, const std::size_t& last, double* scores) const;
+
+            /**
+            * Function Name : sign
+
+            * Function Description :  Function that returns 0 if the value is less than  or equal to 0 and 1 id value is grater than 0;
+
+            * Parameters :
+
+            1) value :			value to check
+
+                                Type Expected : double
+
+                                Method of passing :  constant
+
+            * Return :		    bool - >  0 or 1
+
+
+            * Example
+
+               This function is internal and protected ;
+
+
+            */
+            bool _sign(const double value) const;
 
 
         public:
 
-            // Storage variable to hold coefficients
-            data::Storage Coefficients;
+			// Number of classes
+			data::Storage::size_type Classes;
+
+            // Hold the classification type
+            ClassificationType Method;
 
+            // The vector of prediction is required
+            data::Storage Y;
 
-            /* Functions */
+            
 
            /**
+           * Constructor Name : RidgeClassifier[Parameterized]
+
+           * Constructor Description :  Constructor to load value of lambda and type of classification (binary, multi-class)
+
+           * Parameters :
+
+           1) lambda		The penalty
+
+                            Type Expected : double
+
+                            Method of passing :  constant
+           
+           2) method        The classification type ( cmll::linear::ClassificationType::BINARY or cmll::linear::ClassificationType::MULTI_CLASS    
+
+							Type Expected : cmll::linear::ClassificationType
+
+							Method of passing :  value
+
+           * Example
+
+               #include<vector>
+               #include<linear/Linear.h>
+               #include<iostream>
+
+               int main()
+               {
+
+                   cmll::linear::RidgeClasifier r1(10,cmll::linear::classificationType::MULTI_CLASS);
+
+                   return 0;
+
+               }
+
+
+           */
+            RidgeClassifier(const double lambda = static_cast<double>(defaults::LAMBDA), ClassificationType method = ClassificationType::BINARY);
+
+            /**
             * Function Name :  model
 
-            * Function Description :  Function to built a linear regression model using Feature Matrix X and vector of prediction y.
+            * Function Description :  Function to built a ridge classifier model using Feature Matrix X and vector of prediction y.
 
             * Parameters :
 
@@ -118,7 +1524,7 @@ namespace cmll
                 {
                     // vector creation and element adding here
 
-                    cmll::linear::LinearRegression l1;
+                    cmll::linear::RidgeClassifier l1;
 
                     l1.model(X,y);
 
@@ -130,10 +1536,13 @@ namespace cmll
             */
             void model(const data::Storage& X, const data::Storage& y) noexcept;
 
-           /**
+            /**
             * Function Name :  predict
 
-            * Function Description :  Function to predict using linear regression model built by model()
+            * Function Description :  Function to predict using RidgeClassifier model built by model(). The scores of a block of rows
+                                      are found by _scores() and the label of every row (the sign for BINARY, the class of the largest
+                                      score for MULTI_CLASS) is taken right away, so no rows X classes matrix is allocated.
+                                      The model is not changed, so several threads can predict with it at the same time
 
             * Parameters :
 
@@ -142,8 +1551,8 @@ namespace cmll
                             Type Expected : cmll::data::Storage
 
                             Method of passing :  constant and by reference
-            
-            2) result :		The predicted values
+
+            2) result :		The predicted values ( resized to rows X 1 )
 
                             Type Expected : cmll::data::Storage
 
@@ -151,7 +1560,7 @@ namespace cmll
 
             * Return :		None
 
-            * Throws    :  std::runtime_error : If the coefficient vector is empty
+            * Throws    :  std::runtime_error : If the coefficient vector is empty (caught, result is not changed)
 
             * Example
 
@@ -162,7 +1571,7 @@ namespace cmll
                 {
                     // vector creation and element adding here
 
-                    cmll::linear::LinearRegression l1;
+                    cmll::linear::RidgeClassifier l1;
 
                     l1.model(X,y);
 
@@ -174,61 +1583,60 @@ namespace cmll
 
 
             */
-            void predict(const data::Storage& XTest, data::Storage& result); //throws std::runtime_error
-
-           /**
-           * Function Name :  RSS
-
-           * Function Description :  Function to calculate Residual Sum of Squares of the model
-
-           * Parameters :
+            void predict(const data::Storage& XTest, data::Storage& result) const; // throws std::runtime_error
 
-           1) yPred:		The predicted values by the model
+            /**
+            * Function Name :  predict scores
 
-                           Type Expected : cmll::data::Storage
+            * Function Description :  Function to calculate the score of every class ( XTest times the Coefficients ) for every
+                                      observation, in parallel over blocks of rows (see _scores()). scores is only reallocated
+                                      when its shape changes, so the same buffer can be passed on every call. Const, as predict()
 
-                           Method of passing :  constant and by reference
+            * Parameters :
 
-           2) y:	        The actual values
+            1) XTest :		The test set feature matrix
 
-                           Type Expected : cmll::data::Storage
+                            Type Expected : cmll::data::Storage
 
-                           Method of passing :  constant and by reference
+                            Method of passing :  constant and by reference
 
+            2) scores :		The scores ( rows X classes, rows X 1 for BINARY )
 
-           * Return :		Residual sum of squares calculated
+                            Type Expected : cmll::data::Storage
 
+                            Method of passing :  by reference
 
-           * Example
+            * Return :		None
 
-               #include<vector>
-               #include<linear/Linear.h>
-               #include<iostream>
+            * Throws    :  std::runtime_error : If the coefficient vector is empty (caught, scores is not changed)
 
-               int main()
-               {
-                   // vector creation and element adding here
+            * Example
 
-                   cmll::linear::LinearRegression l1;
+                #include<vector>
+                #include<linear/Linear.h>
 
-                   l1.model(X,y);
+                int main()
+                {
+                    // vector creation and element adding here
 
-                   l1.predict(XTest,y_pred);
+                    cmll::linear::RidgeClassifier l1(1, cmll::linear::ClassificationType::MULTI_CLASS);
 
-                   std::cout<<l1.rss(yPred,y);
+                    l1.model(X,y);
 
-                   return 0;
+                    cmll::data::Storage scores;
 
-               }
+                    for (const cmll::data::Storage& batch : batches) l1.predictScores(batch,scores);
 
+                    return 0;
 
-           */
-            double rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+                }
+            */
+            void predictScores(const data::Storage& XTest, data::Storage& scores) const; // throws std::runtime_error
 
-           /**
+            /**
             * Function Name :  score
 
-            * Function Description :  Function to calculate R^2 score of the linear Regression model built
+            * Function Description :  Function to calculate accuracy of the RidgeClassifier model built
 
             * Parameters :
 
@@ -245,7 +1653,7 @@ namespace cmll
                             Method of passing :  constant and by reference
 
 
-            * Return :		R^2 score calculated
+            * Return :		Score calculated
 
 
             * Example
@@ -258,11 +1666,11 @@ namespace cmll
                 {
                     // vector creation and element adding here
 
-                    cmll::linear::LinearRegression l1;
+                    cmll::linear::RidgeClassifier l1;
 
                     l1.model(X,y);
 
-                    auto yPred = l1.predict(XTest);
+                    l1.predict(XTest,y_pred);
 
                     std::cout<<l1.score(yPred,y);
 
@@ -272,381 +1680,493 @@ namespace cmll
 
 
             */
-            double score(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+            double score(const data::Storage& y_pred, const data::Storage& y) noexcept;
+        };
 
-           
+        /**
+        * Class Name : ElasticNet
 
-           /**
-           * Function Name :  TSS
+        * Class Description : Class containing functions required for building an elastic net (and lasso) regression model. It minimizes
 
-           * Function Description :  Function to calculate Total Sum of Squares of the model
+                                    1/(2N) ||y - Xb||^2 + Lambda ( L1Ratio ||b||_1 + (1 - L1Ratio)/2 ||b||^2 )
 
-           * Parameters :
+                              for every output by coordinate descent : one coefficient at a time is set to the soft thresholded
+                              correlation of its feature with the residual, so most coefficients end up exactly zero.
+                              When there are at least as many observations as features, X^T X and X^T y are added up once
+                              (see LinearRegression::accumulate()) and the correlations X^T r / N are kept up to date with one column
+                              of X^T X per changed coefficient (covariance updates, no pass over X at all). Otherwise (and for a
+                              sparse X) X is copied column by column and the residual r is kept up to date instead.
+                              Only the features that pass the sequential strong rule are visited, passes over the non zero
+                              coefficients (the active set) alternate with passes over all of them, and the features left out
+                              are checked against the optimality conditions once converged.
+                              fitPath() solves for a decreasing sequence of penalties, each starting from the previous solution.
+                              No intercept is added : a column of ones is penalized like any other feature
 
-           1) y:	        The actual values
+        * Attributes :
 
-                           Type Expected : cmll::data::Storage
+        1) L1Ratio : Share of the L1 penalty, from 0 (ridge) to 1 (lasso)
 
-                           Method of passing :  constant and by reference
+        2) Lambda :  The value of Lambda penalty
 
+        3) Lambdas : The penalties of the last fit (those of the path for fitPath())
 
-           * Return :		Total sum of squares calculated
+        4) Path : The coefficients for every penalty of the last fitPath()
 
+        5) Selection : Order in which the coefficients are visited (see cmll::linear::SelectionType)
 
-           * Example
+        Iterations (passes over the coefficients), MaximumIterations (passes for one penalty), Seed (RANDOM selection),
+        Threads, Tolerance (largest change of a coefficient in a pass relative to the largest coefficient) and WarmStart are inherited
 
-               #include<vector>
-               #include<linear/Linear.h>
-               #include<iostream>
+        * Functions :
 
-               int main()
-               {
-                   // vector creation and element adding here
+        1) _descend @protected
 
-                   cmll::linear::LinearRegression l1;
+        2) _fit @protected
 
-                   std::cout<<l1.tss(y);
+        3) _lambdas @protected
 
-                   return 0;
+        4) _path @protected
 
-               }
+        5) accumulate - @inherited
 
+        6) begin - @inherited
 
-           */
-            double tss(const data::Storage& y) noexcept;
+        7) finalize - @overriden
 
-        };
+        8) fitPath
 
-        /**
-        * Class Name : RidgeRegression
+        9) merge - @inherited
 
-        * Class Description : Class containing functions required for building a Ridge regression model
+        10) model - @overriden
 
-        * Attributes :
+        11) predict - @inherited
 
-        1) Lambda :  The value of Lambda penalty
+        12) rss - @inherited
 
-        * Functions :
+        13) tss - @inherited
 
-        1) model - @overriden
+        14) score - @inherited
 
-        2) predict - @inherited
+        */
+        class ElasticNet : public LinearRegression
+        {
+        protected:
 
-		3) rss - @inherited
+            // Access to column j of X : returns the number of values, the values and their observations (nullptr for a dense column)
+            typedef std::function<std::size_t(const std::size_t&, const std::size_t*&, const double*&)> Column;
 
-		4) tss - @inherited
+            // Returns x_j^T r / N for the current coefficients
+            typedef std::function<double(const std::size_t&)> Correlation;
 
-        5) score - @inherited
+            // Writes x_j^T r / N of every feature
+            typedef std::function<void(std::vector<double>&)> Correlations;
 
-        */
-        class RidgeRegression : public LinearRegression
-        {
-        public:
+            // Coefficient j moved by delta : the residual (or the correlations) follow
+            typedef std::function<void(const std::size_t&, const double&)> Update;
 
-            // Penalty 
-            double Lambda;
+            /**
+            * Function Name :  descend (internal)
 
-           /**
-           * Constructor Name : RidgeRegression[Parameterized]
+            * Function Description :  Function to run coordinate descent over a set of features until the largest change of a pass is
+                                      at most Tolerance times the largest coefficient. A pass over the set is followed by passes over
+                                      its non zero coefficients until they converge, and again until a pass over the set changes nothing
 
-           * Constructor Description :  Constructor to load value of lambda 
+            * Parameters :
 
-           * Parameters :
+            1) squares :	x_j^T x_j / N for every feature
 
-           1) lambda		    The penalty 
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  constant and by reference
+
+            2) lambda :		The penalty
 
                             Type Expected : double
 
-                            Method of passing :  constant
+                            Method of passing :  constant and by reference
 
+            3) set :		The features visited
 
-           * Example
+                            Type Expected : std::vector<std::size_t>
 
-               #include<vector>
-               #include<linear/Linear.h>
-               #include<iostream>
+                            Method of passing :  constant and by reference
 
-               int main()
-               {
+            4) correlation : See Correlation
 
-                   cmll::linear::RidgeRegression r1(10);
+                            Type Expected : Correlation
 
-                   return 0;
+                            Method of passing :  constant and by reference
 
-               }
+            5) update :		See Update
 
+                            Type Expected : Update
 
-           */
-            RidgeRegression(const double lambda = static_cast<double>(defaults::LAMBDA));
+                            Method of passing :  constant and by reference
+
+            6) generator :	Random order of the features for RANDOM selection
+
+                            Type Expected : std::mt19937
+
+                            Method of passing :  by reference
+
+            7) b :			The coefficients
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  by reference
+
+            * Return :		std::size_t - > passes run
+
+            * Example
+                This function is internal and protected ;
+
+            */
+            std::size_t _descend(const std::vector<double>& squares, const double& lambda, const std::vector<std::size_t>& set, const Correlation& correlation, const Update& update, std::mt19937& generator, std::vector<double>& b) const;
 
             /**
-            * Function Name :  model
+            * Function Name :  fit (internal)
 
-            * Function Description :  Function to built a ridge regression model using Feature Matrix X and vector of prediction y.
+            * Function Description :  Function to solve every output for the penalties of _lambdas(), from the sums added by accumulate()
+                                      (covariance updates) or from the columns of X (residual updates). Sets Coefficients, Lambdas,
+                                      Path (if count is not 0) and Iterations
 
             * Parameters :
 
-            1) X :			The feature matrix
+            1) count :		Penalties of the path (0 for Lambda only)
 
-                            Type Expected : cmll::data::Storage
+                            Type Expected : std::size_t
 
                             Method of passing :  constant and by reference
 
-            2) y :		    Vector of prediction
+            2) ratio :		Smallest penalty of the path over the largest
 
-                            Type Expected : cmll::data::Storage
+                            Type Expected : double
 
                             Method of passing :  constant and by reference
 
-            * Return :		None
-
+            3) rows :		Number of observations (residual updates)
 
-            * Example
+                            Type Expected : std::size_t
 
-                #include<vector>
-                #include<linear/Linear.h>
+                            Method of passing :  constant and by reference
 
-                int main()
-                {
-                    // vector creation and element adding here
+            4) features :	Number of features (residual updates)
 
-                    cmll::linear::RidgeRegression l1;
+                            Type Expected : std::size_t
 
-                    l1.model(X,y);
+                            Method of passing :  constant and by reference
 
-                    return 0;
+            5) column :		Access to the columns of X (residual updates)
 
-                }
+                            Type Expected : Column
 
+                            Method of passing :  constant and by reference
 
-            */
-            void model(const data::Storage& X, const data::Storage& y) noexcept;
+            6) y :			Vector of prediction (residual updates)
 
-        };
+                            Type Expected : cmll::data::Storage
 
-        /**
-        * Class Name : RidgeClassifier
+                            Method of passing :  constant and by reference
 
-        * Class Description : Class containing functions required for building a Ridge classifier model
+            * Return :		None
 
-        * Attributes :
+            * Example
+                This function is internal and protected ;
 
-        1) Classes : Number of distinct classes
+            */
+            void _fit(const std::size_t& count, const double& ratio);
+            void _fit(const std::size_t& count, const double& ratio, const std::size_t& rows, const std::size_t& features, const Column& column, const data::Storage& y);
 
-        2) Lambda :  The value of Lambda penalty @inherited
+            /**
+            * Function Name :  lambdas (internal)
 
-        3) Method : Either binary classification for Multi class
+            * Function Description :  Function to calculate the penalties : count values evenly spaced on a log scale from the smallest
+                                      penalty that keeps every coefficient at zero down to ratio times it, or Lambda alone if count is 0
 
-        4) Y : The vector of prediction
+            * Parameters :
 
-        * Functions :
+            1) largest :	max_j |x_j^T y| / N over the outputs
 
-        1) _assignSign @protected
+                            Type Expected : double
 
-        2) _binarizer   @protected
-        
-        3) _decoder @protected
+                            Method of passing :  constant and by reference
 
-        4) _encoder @protected
+            2) count :		Penalties of the path
 
-        5) _keepMaximum @protected
+                            Type Expected : std::size_t
 
-        6) _sign @protected
+                            Method of passing :  constant and by reference
 
-        7) model - @overriden and called
+            3) ratio :		Smallest penalty of the path over the largest
 
-        8) predict - @overriden and called
-		
-        9) rss - @privateScoped
+                            Type Expected : double
 
-		10) tss - @privateScoped
+                            Method of passing :  constant and by reference
 
-        11) score - @overrriden
+            * Return :		double - > the smallest penalty that keeps every coefficient at zero
 
-        
+            * Example
+                This function is internal and protected ;
 
-        */
-        class RidgeClassifier : public RidgeRegression
-        {
-        protected:
-            
-			/*
-                In a classification setting, rss and tss are not required
             */
-            using RidgeRegression::rss;
-			using RidgeRegression::tss;
+            double _lambdas(const double& largest, const std::size_t& count, const double& ratio);
 
             /**
-            * Function Name : Assign sign
+            * Function Name :  path (internal)
 
-            * Function Description :  Function that assigns 0 to values less than and equal to zero and one to others
+            * Function Description :  Function to solve one output for every penalty of Lambdas, each from the solution of the previous one.
+                                      The features visited are those with a non zero coefficient or |x_j^T r / N| >= L1Ratio (2 lambda - previous lambda)
+                                      (sequential strong rule). Once converged, any other feature with |x_j^T r / N| > L1Ratio lambda is added
+                                      and the descent goes on
 
             * Parameters :
 
-            1) X:			vector whose value are to be assigned
+            1) squares :	x_j^T x_j / N for every feature
 
-                            Type Expected : multidimensional vetor
+                            Type Expected : std::vector<double>
 
-                            Method of passing :  By reference
+                            Method of passing :  constant and by reference
 
-            * Return :		None
+            2) largest :	The smallest penalty that keeps every coefficient at zero
 
+                            Type Expected : double
 
-            * Example
+                            Method of passing :  constant and by reference
 
-               This function is internal and protected ;
+            3) correlations : See Correlations
 
+                            Type Expected : Correlations
 
-            */
-            void _assingSign(data::Storage& X) noexcept;
+                            Method of passing :  constant and by reference
 
-            /**
-            * Function Name : Binarizer
+            4) correlation : See Correlation
 
-            * Function Description :  Function to encode create a multi output regression scenario with labels either -1 or 1
+                            Type Expected : Correlation
 
-            * Parameters :
+                            Method of passing :  constant and by reference
 
-            1) yNew :			The new Y, encoded
+            5) update :		See Update
 
-                                Type Expected : multidimensional vector
+                            Type Expected : Update
 
-                                Method of passing :  reference
+                            Method of passing :  constant and by reference
 
-            * Return :		None
+            6) output :		The column of Coefficients (and of Path) written
 
+                            Type Expected : std::size_t
 
-            * Example
+                            Method of passing :  constant and by reference
 
-               This function is internal and protected ;
+            7) b :			The starting coefficients
+
+                            Type Expected : std::vector<double>
+
+                            Method of passing :  by reference
+
+            * Return :		None
 
+            * Example
+                This function is internal and protected ;
 
             */
-            void _binarizer(data::Storage& yNew) noexcept;
+            void _path(const std::vector<double>& squares, const double& largest, const Correlations& correlations, const Correlation& correlation, const Update& update, const std::size_t& output, std::vector<double>& b);
 
-            /**
-            * Function Name : Decoder
+        public:
 
-            * Function Description :  Function to set the values earlier set to -1 to value
+            double L1Ratio;
+            double Lambda;
+            std::vector<double> Lambdas;
+            std::vector<data::Storage> Path;
+            SelectionType Selection;
 
-            * Parameters :
+           /**
+           * Constructor Name : ElasticNet[Parameterized]
 
-            1) value :			The value to place instead of -1
+           * Constructor Description :  Constructor to load the penalties
 
-                                Type Expected : double
+           * Parameters :
 
-                                Method of passing :  constant
+           1) lambda		The penalty
 
-            * Return :		None
+                            Type Expected : double
 
+                            Method of passing :  constant
 
-            * Example
+           2) l1Ratio		Share of the L1 penalty (0 to 1)
 
-               This function is internal and protected ;
+                            Type Expected : double
 
+                            Method of passing :  constant
 
-            */
-            void _decoder(const double value) noexcept;
+           3) threads		Threads used for adding up X^T X and X^T y and for the correlations (0 for all hardware threads)
+
+                            Type Expected : std::size_t
+
+                            Method of passing :  constant and by reference
+
+           * Example
 
+               #include<vector>
+               #include<linear/Linear.h>
+
+               int main()
+               {
+                   cmll::linear::ElasticNet e1(0.1, 0.9);
+
+                   return 0;
+               }
+
+           */
+            ElasticNet(const double lambda = defaultsd::ELASTIC_NET_LAMBDA, const double l1Ratio = defaultsd::L1_RATIO, const std::size_t& threads = 0);
+
+           /**
+            * Function Name :  finalize
+
+            * Function Description :  Function to calculate the coefficients from the observations added since begin() (covariance updates).
+                                      Lambda and L1Ratio are read here, so the same sums can be solved for several penalties
+
+            * Return :		None
+
+            * Throws    :  std::runtime_error : If no observation has been added (caught, the coefficients are not changed)
+            */
+            void finalize();
 
             /**
-            * Function Name : Encoder
+            * Function Name :  fit path
+
+            * Function Description :  Function to solve for count penalties, from the smallest that keeps every coefficient at zero down
+                                      to ratio times it, each starting from the solution of the previous one. The penalties are kept in
+                                      Lambdas, the coefficients in Path and Coefficients holds those of the smallest penalty
+
+            * Parameters :
+
+            1) X :			The feature matrix (dense or sparse)
+
+                            Type Expected : cmll::data::Storage or cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Vector of prediction
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            3) count :		Penalties of the path (0 for Lambda alone, as model())
 
-            * Function Description :  Function to encode specific labels to -1 and rest to 1
+                            Type Expected : std::size_t
 
-            * Parameters :
+                            Method of passing :  constant and by reference
 
-            1) value :			The value to encode to -1
+            4) ratio :		Smallest penalty of the path over the largest
 
-                                Type Expected : double
+                            Type Expected : double
 
-                                Method of passing :  constant 
+                            Method of passing :  constant and by reference
 
             * Return :		None
 
 
             * Example
 
-               This function is internal and protected ;
+                #include<vector>
+                #include<linear/Linear.h>
+
+                int main()
+                {
+                    // vector creation and element adding here
+
+                    cmll::linear::Lasso l1;
 
+                    l1.fitPath(X,y,200);
 
+                    // Coefficients for the 50th penalty
+                    l1.Path[49];
+
+                    return 0;
+
+                }
             */
-            void _encoder(const double value) noexcept;
+            void fitPath(const data::Storage& X, const data::Storage& y, const std::size_t& count = static_cast<std::size_t>(defaults::PATH_LENGTH), const double& ratio = defaultsd::PATH_RATIO) noexcept;
+            void fitPath(const data::Sparse& X, const data::Storage& y, const std::size_t& count = static_cast<std::size_t>(defaults::PATH_LENGTH), const double& ratio = defaultsd::PATH_RATIO) noexcept;
 
             /**
-           * Function Name : Keep maximum
+            * Function Name :  model
 
-           * Function Description :  Function receives same vector multiple times and keeps the maximum value for each index
-                                     The changes per index per iteration are saved in Changes.
+            * Function Description :  Function to built an elastic net model using Feature Matrix X and vector of prediction y
+                                      (dense or sparse), for the penalty Lambda
 
-           * Parameters :
+            * Parameters :
 
-           1) newVals  :    Vector to check for changes in
+            1) X :			The feature matrix
 
-                            Type Expected : multidimensional vector
+                            Type Expected : cmll::data::Storage or cmll::data::Sparse
 
-                            Method of passing : Const and by reference
+                            Method of passing :  constant and by reference
 
-           2) Change  :     The changes vector stores what index last update was done for every index
+            2) y :		    Vector of prediction
 
-                            Type Expected : multidimensional vector
+                            Type Expected : cmll::data::Storage
 
-                            Method of passing : By reference
+                            Method of passing :  constant and by reference
 
-           * Return :		None
+            * Return :		None
 
 
-           * Example
+            * Example
 
-              This function is internal and protected ;
+                #include<vector>
+                #include<linear/Linear.h>
 
+                int main()
+                {
+                    // vector creation and element adding here
 
-           */
-            void _keepMaximum(const data::Storage& newVals, data::Storage& Change) noexcept;
-            
-            
-            /**
-            * Function Name : sign
+                    cmll::linear::ElasticNet e1(0.1);
 
-            * Function Description :  Function that returns 0 if the value is less than  or equal to 0 and 1 id value is grater than 0;
+                    e1.model(X,y);
 
-            * Parameters :
+                    return 0;
 
-            1) value :			value to check
+                }
 
-                                Type Expected : double
 
-                                Method of passing :  constant
+            */
+            void model(const data::Storage& X, const data::Storage& y) noexcept;
+            void model(const data::Sparse& X, const data::Storage& y) noexcept;
 
-            * Return :		    bool - >  0 or 1
+        };
 
+        /**
+        * Class Name : Lasso
 
-            * Example
+        * Class Description : Class containing functions required for building a lasso regression model : an elastic net with L1Ratio 1,
 
-               This function is internal and protected ;
+                                    1/(2N) ||y - Xb||^2 + Lambda ||b||_1
 
+        * Attributes :
 
-            */
-            bool _sign(const double value) const;
+        1) Lambda :  The value of Lambda penalty @inherited
 
+        * Functions :
 
-        public:
+        1) finalize - @inherited
 
-			// Number of classes
-			data::Storage::size_type Classes;
+        2) fitPath - @inherited
 
-            // Hold the classification type
-            ClassificationType Method;
+        3) model - @inherited
 
-            // The vector of prediction is required
-            data::Storage Y;
+        4) predict - @inherited
 
-            
+        */
+        class Lasso : public ElasticNet
+        {
+        public:
 
            /**
-           * Constructor Name : RidgeClassifier[Parameterized]
+           * Constructor Name : Lasso[Parameterized]
 
-           * Constructor Description :  Constructor to load value of lambda and type of classification (binary, multi-class)
+           * Constructor Description :  Constructor to load value of lambda
 
            * Parameters :
 
@@ -655,229 +2175,239 @@ namespace cmll
                             Type Expected : double
 
                             Method of passing :  constant
-           
-           2) method        The classification type ( cmll::linear::ClassificationType::BINARY or cmll::linear::ClassificationType::MULTI_CLASS    
 
-							Type Expected : cmll::linear::ClassificationType
+           2) threads		Threads used for adding up X^T X and X^T y and for the correlations (0 for all hardware threads)
 
-							Method of passing :  value
+                            Type Expected : std::size_t
+
+                            Method of passing :  constant and by reference
 
            * Example
 
-               #include<vector>
-               #include<linear/Linear.h>
-               #include<iostream>
+               cmll::linear::Lasso l1(0.05);
 
-               int main()
-               {
+           */
+            Lasso(const double lambda = defaultsd::ELASTIC_NET_LAMBDA, const std::size_t& threads = 0);
 
-                   cmll::linear::RidgeClasifier r1(10,cmll::linear::classificationType::MULTI_CLASS);
+        };
 
-                   return 0;
+        /**
+        * Class Name : LogisticRegression
 
-               }
+        * Class Description : Class containing functions required for building a Logistic regression model
 
+        * Attributes :
 
-           */
-            RidgeClassifier(const double lambda = static_cast<double>(defaults::LAMBDA), ClassificationType method = ClassificationType::BINARY);
+        1) BatchSize : Observations per step of the SGD solver
 
-            /**
-            * Function Name :  model
+        2) Classes : Number of classes of the model (labels are 0 to Classes - 1)
 
-            * Function Description :  Function to built a ridge classifier model using Feature Matrix X and vector of prediction y.
+        3) Coefficients : The Coefficient vector ( features X 1 ), ( features X Classes ) for a multinomial model
 
-            * Parameters :
+        4) Epochs : Maximum passes over the observations of the SGD solver
 
-            1) X :			The feature matrix
+        5) History : Pairs of steps and gradient changes kept by the L-BFGS solver
 
-                            Type Expected : cmll::data::Storage
+        6) Iterations : Iterations (epochs for SGD) of the last fit
 
-                            Method of passing :  constant and by reference
+        7) LearningRate : Initial step size of the SGD solver
 
-            2) y :		    Vector of prediction
+        8) MaximumItertions : The maximum iterations to run the convergence loop for
 
-                            Type Expected : cmll::data::Storage
+        9) Method :  Classification type binary or multi class
 
-                            Method of passing :  constant and by reference
+        10) Schedule : How the step size of the SGD solver decreases
 
-            * Return :		None
+        11) Seed : Seed for the order of the observations in the SGD solver
 
+        12) Solver : DIRECT (Newton-Raphson), SGD or LBFGS
 
-            * Example
+        13) Threads : Threads of the SGD and L-BFGS solvers (0 for all hardware threads)
 
-                #include<vector>
-                #include<linear/Linear.h>
+        14) Tolerance : The tolerance
 
-                int main()
-                {
-                    // vector creation and element adding here
+        * Functions :
 
-                    cmll::linear::RidgeClassifier l1;
+        1) _loss -  @protected
 
-                    l1.model(X,y);
+        2) _minimize -  @protected
 
-                    return 0;
+        3) _model -  @protected
 
-                }
+        4) _scores -  @protected
 
+        5) model
 
-            */
-            void model(const data::Storage& X, const data::Storage& y) noexcept;
+        6) predict
+
+        7) predictProbabilities
 
+        8) score 
+        */
+        class LogisticRegression
+        {
+
+        protected:
             /**
-            * Function Name :  predict
+            * Function Name :  model (internal)
 
-            * Function Description :  Function to predict using RidgeClassifier model built by model()
+            * Function Description :  The model (public) function calls this internal function to build the model with Newton-Raphson
+                                      (iteratively reweighted least squares). X^T W X and X^T W z are added up straight from X over blocks
+                                      of rows in parallel and solved by Cholesky, so memory is O(features^2 + observations) and X is
+                                      neither copied nor transposed
 
             * Parameters :
 
-            1) XTest :		The test set feature matrix
+            1) X :			The feature matrix
 
                             Type Expected : cmll::data::Storage
 
                             Method of passing :  constant and by reference
 
-            2) result :		The predicted values
+            2) y :		    Vector of prediction
 
                             Type Expected : cmll::data::Storage
 
-                            Method of passing :  by reference
+                            Method of passing :  constant and by reference
 
             * Return :		None
 
-            * Throws    :  std::runtime_error : If the coefficient vector is empty
 
             * Example
+                This function is internal and protected ;
 
-                #include<vector>
-                #include<linear/Linear.h>
-
-                int main()
-                {
-                    // vector creation and element adding here
+            */
+            void _model(const data::Storage& X, const data::Storage& y) noexcept;
 
-                    cmll::linear::RidgeClassifier l1;
+            // Access to a row of X : returns the number of values, the values and their features (nullptr for a dense row holding every feature)
+            typedef std::function<std::size_t(const std::size_t&, const std::size_t*&, const double*&)> Row;
 
-                    l1.model(X,y);
+            /**
+            * Function Name :  loss (internal)
 
-                    l1.predict(XTest,result);
+            * Function Description :  Function to calculate the average loss (negative log likelihood) of the observations and its gradient.
+                                      With one column of coefficients the model is binary (sigmoid), otherwise multinomial (softmax).
+                                      Threads take blocks of rows (their number only depends on the size of the problem) and add the
+                                      scores of a row as x_j times row j of the coefficients, so the inner loops run over the classes.
+                                      The sums of the blocks are added in block order
 
-                    return 0;
+            * Parameters :
 
-                }
+            1) rows :		Number of observations
 
+                            Type Expected : std::size_t
 
-            */
-            void predict(const data::Storage& XTest, data::Storage& result); // throws std::runtime_error
+                            Method of passing :  constant and by reference
 
-            /**
-            * Function Name :  score
+            2) row :		Access to the rows of X
 
-            * Function Description :  Function to calculate accuracy of the RidgeClassifier model built
+                            Type Expected : Row
 
-            * Parameters :
+                            Method of passing :  constant and by reference
 
-            1) yPred:		The predicted values by the model
+            3) y :			The labels
 
                             Type Expected : cmll::data::Storage
 
                             Method of passing :  constant and by reference
 
-            2) y:	        The actual values
+            4) columns :	Columns of coefficients (1 or Classes)
 
-                            Type Expected : cmll::data::Storage
+                            Type Expected : std::size_t
 
                             Method of passing :  constant and by reference
 
+            5) weights :	The coefficients ( features X columns, row major )
 
-            * Return :		Score calculated
+                            Type Expected : std::vector<double>
 
+                            Method of passing :  constant and by reference
 
-            * Example
+            6) gradient :	The gradient of the loss
 
-                #include<vector>
-                #include<linear/Linear.h>
-                #include<iostream>
+                            Type Expected : std::vector<double>
 
-                int main()
-                {
-                    // vector creation and element adding here
+                            Method of passing :  by reference
 
-                    cmll::linear::RidgeClassifier l1;
+            * Return :		double - > the average loss
 
-                    l1.model(X,y);
+            * Example
+                This function is internal and protected ;
 
-                    l1.predict(XTest,y_pred);
+            */
+            double _loss(const std::size_t& rows, const Row& row, const data::Storage& y, const std::size_t& columns, const std::vector<double>& weights, std::vector<double>& gradient) const;
 
-                    std::cout<<l1.score(yPred,y);
+            /**
+            * Function Name :  minimize (internal)
 
-                    return 0;
+            * Function Description :  Function to fit the coefficients with L-BFGS (see cmll::linear::Lbfgs and _loss())
 
-                }
+            * Parameters :
 
+            1) rows :		Number of observations
 
-            */
-            double score(const data::Storage& y_pred, const data::Storage& y) noexcept;
-        };
+                            Type Expected : std::size_t
 
-        /**
-        * Class Name : LogisticRegression
+                            Method of passing :  constant and by reference
 
-        * Class Description : Class containing functions required for building a Logistic regression model
+            2) features :	Number of features
 
-        * Attributes :
+                            Type Expected : std::size_t
 
-        1) Coefficients : The Coefficient vector
+                            Method of passing :  constant and by reference
 
-        2) MaximumItertions : The maximum iterations to run the convergence loop for
+            3) row :		Access to the rows of X
 
-        3) Method :  Classification type binary or multi class
+                            Type Expected : Row
 
-        4) Tolerance : The tolerance
+                            Method of passing :  constant and by reference
 
-        * Functions :
+            4) y :			The labels
 
-        1) _model -  @protected
+                            Type Expected : cmll::data::Storage
 
-        2) model
+                            Method of passing :  constant and by reference
 
-        3) predict
+            * Return :		None
 
-        4) predictProbabilities
+            * Example
+                This function is internal and protected ;
 
-        5) score 
-        */
-        class LogisticRegression
-        {
+            */
+            void _minimize(const std::size_t& rows, const std::size_t& features, const Row& row, const data::Storage& y);
 
-        protected:
             /**
-            * Function Name :  model (internal)
+            * Function Name :  scores (internal)
 
-            * Function Description :  The model (public) function calls this internal function to build the model
+            * Function Description :  Function to calculate the probabilities of the observations (of label 1, or of every class)
 
             * Parameters :
 
-            1) X :			The feature matrix
+            1) rows :		Number of observations
 
-                            Type Expected : cmll::data::Storage
+                            Type Expected : std::size_t
 
                             Method of passing :  constant and by reference
 
-            2) y :		    Vector of prediction
+            2) row :		Access to the rows of X
 
-                            Type Expected : cmll::data::Storage
+                            Type Expected : Row
 
                             Method of passing :  constant and by reference
 
-            * Return :		None
+            3) result :		The probabilities ( rows X 1 or rows X Classes )
 
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  by reference
+
+            * Return :		None
 
             * Example
                 This function is internal and protected ;
 
             */
-            void _model(const data::Storage& X, const data::Storage& y) noexcept;
+            void _scores(const std::size_t& rows, const Row& row, data::Storage& result) const;
             
         public:
 
@@ -886,6 +2416,20 @@ namespace cmll
             ClassificationType Method;
             double Tolerance;
 
+            // How the coefficients are found, and the options of the SGD and L-BFGS solvers
+            SolverType Solver;
+            std::size_t BatchSize;
+            std::size_t Epochs;
+            std::size_t History;
+            double LearningRate;
+            ScheduleType Schedule;
+            unsigned int Seed;
+            std::size_t Threads;
+
+            // Classes of the model and iterations of the last fit
+            std::size_t Classes;
+            std::size_t Iterations;
+
            /**
            * Constructor Name : LogisticRegression[Parameterized]
 
@@ -935,6 +2479,10 @@ namespace cmll
             * Function Name :  model
 
             * Function Description :  Function to built a Logistic Regression model using Feature Matrix X and vector of prediction y.
+                                      With Solver set to SGD, X is read in shuffled batches by Threads threads (see cmll::linear::Sgd)
+                                      and no other matrix than the coefficients is allocated.
+                                      MULTI_CLASS fits a multinomial (softmax) model of labels 0 to Classes - 1 with L-BFGS, whatever
+                                      the solver. L-BFGS can also be chosen for BINARY
 
             * Parameters :
 
@@ -974,6 +2522,40 @@ namespace cmll
             */
             void model(const data::Storage& X, const data::Storage& y) noexcept;
 
+            /**
+            * Function Name :  model
+
+            * Function Description :  Function to built a Logistic Regression model from a sparse feature matrix with the SGD solver
+                                      (the L-BFGS solver with Solver set to LBFGS or for MULTI_CLASS), which only visit the non zero values
+
+            * Parameters :
+
+            1) X :			The feature matrix
+
+                            Type Expected : cmll::data::Sparse
+
+                            Method of passing :  constant and by reference
+
+            2) y :		    Labels (0 or 1), one row per row of X
+
+                            Type Expected : cmll::data::Storage
+
+                            Method of passing :  constant and by reference
+
+            * Return :		None
+
+            * Example
+
+                cmll::linear::LogisticRegression l1;
+
+                l1.Solver = cmll::linear::SolverType::SGD;
+                l1.Epochs = 3;
+
+                l1.model(clicks,labels);
+
+            */
+            void model(const data::Sparse& X, const data::Storage& y) noexcept;
+
             /**
             * Function Name :  predict
 
@@ -1020,10 +2602,20 @@ namespace cmll
             */
             void predict(const data::Storage& XTest, data::Storage& result); //throws std::runtime_error
 
+            /**
+            * Function Name :  predict
+
+            * Function Description :  Function to predict for a sparse test set. result is resized to hold one row per observation
+
+            * Throws    :  std::runtime_error : If the coefficient vector is empty
+            */
+            void predict(const data::Sparse& XTest, data::Storage& result); //throws std::runtime_error
+
             /**
             * Function Name :  predict probabilities
 
-            * Function Description :  Function returns the predicted probabilities for each observation in the test set
+            * Function Description :  Function returns the predicted probabilities for each observation in the test set.
+                                      For a multinomial model result is resized to hold the probability of every class
 
             * Parameters :
 
@@ -1062,6 +2654,16 @@ namespace cmll
             */
             void predictProbabilities(const data::Storage& XTest, data::Storage& result) noexcept;
 
+            /**
+            * Function Name :  predict probabilities
+
+            * Function Description :  Function to get the predicted probabilities for a sparse test set. result is resized to hold
+                                      one row per observation
+
+            * Return :		None
+            */
+            void predictProbabilities(const data::Sparse& XTest, data::Storage& result) noexcept;
+
             /**
             * Function Name :  score
 
@@ -0,0 +1,274 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "../utils/Defines.h"
+#include "../utils/Parallel.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		linear name space : Name space for linear models of regression and classification
+	*/
+	namespace linear
+	{
+	/**
+		* Class Name : Sgd
+
+		* Class Description : Mini-batch stochastic gradient descent for the linear models (SolverType::SGD).
+							  Minimizes the sum over the observations of the loss plus Penalty / 2 ||b||^2, the objective of ridge
+							  regression for the SQUARED loss.
+							  Every epoch visits the observations in a new random order (a shuffled array of row indexes, X is never
+							  copied) cut into one range per thread. Every thread takes BatchSize observations at a time, averages
+							  their gradient and subtracts it from the shared coefficients without any lock (Hogwild) : an update may
+							  overwrite a concurrent one, which costs little when the observations are sparse.
+							  Only the coefficients of the features present in a batch are updated. The penalty of feature j is spread
+							  over the observations it is present in (Penalty / count_j per observation), so its sum over an epoch is
+							  Penalty for sparse and dense X alike.
+							  Stops after Epochs epochs, or once the average loss of an epoch improves by less than Tolerance (relative).
+							  With a single thread the result only depends on Seed.
+
+		* Attributes :
+
+		1) BatchSize : Observations per gradient step
+
+		2) Epochs : Maximum passes over the observations
+
+		3) LearningRate : Initial step size (see cmll::linear::ScheduleType)
+
+		4) Loss : The loss minimized (see cmll::linear::LossType)
+
+		5) Penalty : The L2 penalty (ridge lambda)
+
+		6) Schedule : How the step size decreases
+
+		7) Seed : Seed for the order of the observations
+
+		8) Threads : Threads updating the coefficients (0 for all hardware threads)
+
+		9) Tolerance : Relative improvement of the loss of an epoch below which the descent stops
+
+		* Functions :
+
+		1) _fit @protected
+
+		2) fit
+
+		*
+		*/
+		class Sgd
+		{
+		protected:
+
+			// Access to a row of X : returns the number of values, the values and their features (nullptr for a dense row holding every feature)
+			typedef std::function<std::size_t(const std::size_t&, const std::size_t*&, const double*&)> Row;
+
+		/**
+		   * Function Name :  fit (internal)
+
+		   * Function Description :  Function to run the descent for every output (column of y) through row accessors, so dense and
+									  sparse X share it
+
+		   * Parameters :
+
+		   1) rows :		Number of observations
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   2) counts :		For every feature, the observations it is present in
+
+							Type Expected : std::vector<std::size_t>
+
+							Method of passing :  constant and by reference
+
+		   3) row :			Access to the rows of X
+
+							Type Expected : Row
+
+							Method of passing :  constant and by reference
+
+		   4) y :			Vector of prediction
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   5) coefficients : The starting point and the solution ( features X outputs )
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  by reference
+
+		   * Return :		std::size_t - > epochs run (the most over the outputs)
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			std::size_t _fit(const std::size_t& rows, const std::vector<std::size_t>& counts, const Row& row, const data::Storage& y, data::Storage& coefficients) const;
+
+		public:
+
+			std::size_t BatchSize;
+			std::size_t Epochs;
+			double LearningRate;
+			LossType Loss;
+			double Penalty;
+			ScheduleType Schedule;
+			unsigned int Seed;
+			std::size_t Threads;
+			double Tolerance;
+
+		/**
+		   * Constructor Name : Sgd[Parameterized]
+
+		   * Constructor Description :  Constructor to load the loss and the options of the descent
+
+		   * Parameters :
+
+		   1) loss				The loss minimized
+
+								Type Expected : cmll::linear::LossType
+
+								Method of passing :  constant and by reference
+
+		   2) penalty			The L2 penalty
+
+								Type Expected : double
+
+								Method of passing :  constant and by reference
+
+		   3) batchSize			Observations per gradient step
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   4) epochs			Maximum passes over the observations
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   5) learningRate		Initial step size
+
+								Type Expected : double
+
+								Method of passing :  constant and by reference
+
+		   6) schedule			How the step size decreases
+
+								Type Expected : cmll::linear::ScheduleType
+
+								Method of passing :  constant and by reference
+
+		   7) seed				Seed for the order of the observations
+
+								Type Expected : unsigned int
+
+								Method of passing :  constant and by reference
+
+		   8) threads			Threads updating the coefficients (0 for all hardware threads)
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   9) tolerance			Relative improvement of the loss of an epoch below which the descent stops
+
+								Type Expected : double
+
+								Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<Linear/Sgd.h>
+
+			   int main()
+			   {
+				   cmll::linear::Sgd descent(cmll::linear::LossType::LOGISTIC, 0, 64, 5);
+
+				   cmll::data::Storage coefficients(X.Cols, std::vector<double>(1));
+
+				   descent.fit(X,y,coefficients);
+
+				   return 0;
+			   }
+
+		   */
+			Sgd(const LossType& loss = LossType::SQUARED, const double& penalty = 0, const std::size_t& batchSize = static_cast<std::size_t>(defaults::BATCH_SIZE), const std::size_t& epochs = static_cast<std::size_t>(defaults::EPOCHS), const double& learningRate = defaultsd::LEARNING_RATE, const ScheduleType& schedule = ScheduleType::INVERSE_SCALING, const unsigned int& seed = 0, const std::size_t& threads = 0, const double& tolerance = defaultsd::TOLERANCE);
+
+		/**
+		   * Function Name :  fit
+
+		   * Function Description :  Function to descend from coefficients (resized to features X outputs and filled with zeros if it does
+									  not have that shape) for every output
+
+		   * Parameters :
+
+		   1) X :			The feature matrix (dense or sparse)
+
+							Type Expected : cmll::data::Storage or cmll::data::Sparse
+
+							Method of passing :  constant and by reference
+
+		   2) y :			Vector of prediction (labels 0 or 1 for the LOGISTIC loss)
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   3) coefficients : The starting point and the solution
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  by reference
+
+		   * Return :		std::size_t - > epochs run
+		*/
+			std::size_t fit(const data::Storage& X, const data::Storage& y, data::Storage& coefficients) const;
+			std::size_t fit(const data::Sparse& X, const data::Storage& y, data::Storage& coefficients) const;
+		};
+	}
+}
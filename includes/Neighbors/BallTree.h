@@ -0,0 +1,297 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+#include "../utils/Defines.h"
+#include "../utils/Parallel.h"
+#include "Index.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+	/**
+		* Class Name : BallTree
+
+		* Class Description : Ball tree. Every node is a ball (centroid and radius) around its observations.
+							  The tree is a complete binary tree stored in flat arrays (children of node i are 2i+1 and 2i+2)
+							  and every node holds half of the observations of its parent, so the layout is fixed by the number of
+							  observations and can be written to and read from a stream as it is (see save() and load()).
+							  A node is split using only distances (the two observations farthest apart act as pivots), and searches
+							  skip a ball when distance(x, centroid) - radius is farther than the current k-th neighbor (triangle inequality).
+							  So any distanceMetric can be used, and unlike KD trees it does not degrade with many features.
+							  MINKOWSKI with P below 1 breaks the triangle inequality : no ball is skipped and searches scan every leaf.
+							  All the nodes of a level are built in parallel.
+
+		* Attributes :
+
+		1) LeafSize : Maximum observations in a leaf
+
+		2) Threads : Threads used for building (0 for all hardware threads)
+
+		* Functions :
+
+		1) _buildNode @protected
+
+		2) _distance @protected
+
+		3) build @overriden
+
+		4) holdsObservations @overriden
+
+		5) load @overriden
+
+		6) observation @overriden
+
+		7) query @overriden
+
+		8) radius @overriden
+
+		9) save @overriden
+
+		10) size @overriden
+
+		*
+		*/
+		class BallTree : public Index
+		{
+		protected:
+
+			/*
+				Observations of a node are [Begin, End) of the node ordered observations
+			*/
+			struct Node
+			{
+				std::uint64_t Begin, End;
+				double Radius;
+				std::uint64_t Leaf;
+			};
+
+			std::vector<Node> _nodes;
+
+			// Centroid of every node ( nodes X features )
+			std::vector<double> _centroids;
+
+			// Observations in node order ( observations X features ) and their index in the training set
+			Values<double> _points;
+			std::vector<std::uint64_t> _ids;
+
+			// Place of every observation in _points (inverse of _ids)
+			std::vector<std::size_t> _positions;
+
+		/**
+		   * Function Name :  Build Node
+
+		   * Function Description :  Function to calculate the centroid and radius of a node and, if it is not a leaf,
+									  to split its observations between its two children
+
+		   * Parameters :
+
+		   1) node :		The node
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   2) X :			The feature matrix
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   3) order :		Indexes of the observations, rearranged so that every node holds a contiguous range
+
+							Type Expected : std::vector<std::size_t>
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _buildNode(const std::size_t& node, const data::Storage& X, std::vector<std::size_t>& order);
+
+		/**
+		   * Function Name :  distance (internal)
+
+		   * Function Description :  Function to calculate the actual distance between two contiguous observations
+
+		   * Return :		double - > the distance
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			double _distance(const double* x, const double* y) const noexcept;
+
+		public:
+
+			std::size_t LeafSize;
+			std::size_t Threads;
+
+		/**
+		   * Constructor Name : BallTree[Parameterized]
+
+		   * Constructor Description :  Constructor to load the leaf size and the threads used for building
+
+		   * Parameters :
+
+		   1) leafSize		Maximum observations in a leaf
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   2) threads		Threads used for building (0 for all hardware threads)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/BallTree.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::BallTree tree(40);
+
+				   tree.build(X,cmll::neighbors::distanceMetric::MANHATTAN,1);
+
+				   tree.query(x,5,neighbors);
+
+				   return 0;
+			   }
+
+		   */
+			BallTree(const std::size_t& leafSize = static_cast<std::size_t>(defaults::LEAF_SIZE), const std::size_t& threads = 0);
+
+			void build(const data::Storage& X, const distanceMetric& metric, const double& p) override;
+
+			bool holdsObservations() const noexcept override;
+
+		/**
+		   * Function Name :  load
+
+		   * Function Description :  Function to read a tree written by save()
+
+		   * Parameters :
+
+		   1) in :			The binary stream to read from
+
+							Type Expected : std::istream
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the stream does not hold a ball tree
+
+		   * Example
+
+			   #include<fstream>
+			   #include<Neighbors/BallTree.h>
+
+			   int main()
+			   {
+				   std::ifstream in("tree.bin", std::ios::binary);
+
+				   cmll::neighbors::BallTree tree;
+
+				   tree.load(in);
+
+				   return 0;
+			   }
+
+		   */
+			void load(std::istream& in) override; // throws std::runtime_error
+
+			const double* observation(const std::size_t& id) const noexcept override;
+
+			void query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort = 0) const override;
+
+			void radius(const std::vector<double>& x, const double& r, std::vector<Neighbor>& result, const std::size_t& effort = 0) const override;
+
+		/**
+		   * Function Name :  save
+
+		   * Function Description :  Function to write the tree (nodes, centroids, observations and indexes) to a binary stream
+
+		   * Parameters :
+
+		   1) out :			The binary stream to write to
+
+							Type Expected : std::ostream
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Example
+
+			   #include<fstream>
+			   #include<Neighbors/BallTree.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::BallTree tree;
+
+				   tree.build(X,cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+				   std::ofstream out("tree.bin", std::ios::binary);
+
+				   tree.save(out);
+
+				   return 0;
+			   }
+
+		   */
+			void save(std::ostream& out) const override;
+
+			std::size_t size() const noexcept override;
+		};
+	}
+}
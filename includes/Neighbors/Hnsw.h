@@ -0,0 +1,348 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <random>
+#include <stdexcept>
+
+#include "../utils/Defines.h"
+#include "../utils/Parallel.h"
+#include "Index.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+	/**
+		* Class Name : Hnsw
+
+		* Class Description : Hierarchical navigable small world graph (approximate nearest neighbors).
+							  Every observation is a node of layer 0 and, with a probability falling exponentially, of the layers above.
+							  Every node is linked to at most M close nodes per layer (2M on layer 0), chosen so that the links
+							  point in different directions. A query walks greedily from the single node of the top layer down to layer 1,
+							  then searches layer 0 keeping the best efSearch candidates. Larger efSearch gives better recall, slower queries.
+							  The observations are inserted on multiple threads, every node guarding its links with its own lock.
+							  The layers of the nodes are drawn from Seed, so the graph only depends on the order threads insert in.
+
+		* Attributes :
+
+		1) M : Links per node on the upper layers (2M on layer 0)
+
+		2) EfConstruction : Candidates kept while inserting
+
+		3) EfSearch : Candidates kept while querying (used when query() gets no effort)
+
+		4) Threads : Threads used for inserting (0 for all hardware threads)
+
+		5) Seed : Seed for drawing the layers of the nodes
+
+		* Functions :
+
+		1) _distance @protected
+
+		2) _insert @protected
+
+		3) _links @protected
+
+		4) _searchLayer @protected
+
+		5) _selectNeighbors @protected
+
+		6) build @overriden
+
+		7) holdsObservations @overriden
+
+		8) load @overriden
+
+		9) observation @overriden
+
+		10) query @overriden
+
+		11) radius @inherited
+
+		12) save @overriden
+
+		13) size @overriden
+
+		*
+		*/
+		class Hnsw : public Index
+		{
+		protected:
+
+			// Observations in training set order ( observations X features )
+			Values<double> _points;
+
+			// Highest layer of every node
+			std::vector<std::uint32_t> _levels;
+
+			// Links of layer 0 : for every node the count followed by 2M slots
+			std::vector<std::uint32_t> _links0;
+
+			// Links of the upper layers : for every node and each of its layers above 0 the count followed by M slots
+			std::vector<std::vector<std::uint32_t>> _linksUpper;
+
+			// One lock per node, only taken while building
+			std::unique_ptr<std::mutex[]> _locks;
+			std::mutex _entryLock;
+
+			std::uint32_t _entry;
+			std::uint32_t _maxLevel;
+			std::size_t _rows;
+
+		/**
+		   * Function Name :  distance (internal)
+
+		   * Function Description :  Function to calculate the reduced distance of x from a node
+
+		   * Return :		double - > the reduced distance
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			double _distance(const double* x, const std::uint32_t& node) const noexcept;
+
+		/**
+		   * Function Name :  insert (internal)
+
+		   * Function Description :  Function to link a node into the graph
+
+		   * Parameters :
+
+		   1) node :		The node
+
+							Type Expected : std::uint32_t
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _insert(const std::uint32_t& node);
+
+		/**
+		   * Function Name :  links (internal)
+
+		   * Function Description :  Function to get the links of a node on a layer. The first value is the count, the links follow
+
+		   * Return :		std::uint32_t* - > the links
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			std::uint32_t* _links(const std::uint32_t& node, const std::uint32_t& level) noexcept;
+
+			const std::uint32_t* _links(const std::uint32_t& node, const std::uint32_t& level) const noexcept;
+
+		/**
+		   * Function Name :  Search Layer
+
+		   * Function Description :  Function to find the ef nodes of a layer closest to x, starting from the entries given
+
+		   * Parameters :
+
+		   1) x :			Pointer to the observation
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+		   2) entries :		The nodes to start from, with their reduced distances
+
+							Type Expected : std::vector<cmll::neighbors::Neighbor>
+
+							Method of passing :  constant and by reference
+
+		   3) ef :			Number of nodes to keep
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   4) level :		The layer
+
+							Type Expected : std::uint32_t
+
+							Method of passing :  constant and by reference
+
+		   5) result :		The nodes found in increasing order of distance
+
+							Type Expected : std::vector<cmll::neighbors::Neighbor>
+
+							Method of passing :  by reference
+
+		   6) building :	true while inserting, the links are then read under the lock of their node
+
+							Type Expected : bool
+
+							Method of passing :  value
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _searchLayer(const double* x, const std::vector<Neighbor>& entries, const std::size_t& ef, const std::uint32_t& level, std::vector<Neighbor>& result, bool building) const;
+
+		/**
+		   * Function Name :  Select Neighbors
+
+		   * Function Description :  Function to choose at most maximum links out of candidates sorted by distance.
+									  A candidate is skipped if it is closer to an already chosen one than to the node being linked,
+									  which keeps links to far away regions of the graph
+
+		   * Parameters :
+
+		   1) candidates :	The candidates in increasing order of distance, replaced by the chosen ones
+
+							Type Expected : std::vector<cmll::neighbors::Neighbor>
+
+							Method of passing :  by reference
+
+		   2) maximum :		Maximum links
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _selectNeighbors(std::vector<Neighbor>& candidates, const std::size_t& maximum) const;
+
+		public:
+
+			std::size_t M;
+			std::size_t EfConstruction;
+			std::size_t EfSearch;
+			std::size_t Threads;
+			unsigned int Seed;
+
+		/**
+		   * Constructor Name : Hnsw[Parameterized]
+
+		   * Constructor Description :  Constructor to load the parameters of the graph
+
+		   * Parameters :
+
+		   1) m				Links per node on the upper layers (2m on layer 0)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   2) efConstruction	Candidates kept while inserting
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   3) efSearch		Candidates kept while querying
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   4) threads		Threads used for inserting (0 for all hardware threads)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   5) seed			Seed for drawing the layers of the nodes
+
+							Type Expected : unsigned int
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Hnsw.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::Hnsw graph(16, 200, 64);
+
+				   graph.build(X,cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+				   graph.query(x,5,neighbors);
+
+				   // Higher recall for this query only
+				   graph.query(x,5,neighbors,256);
+
+				   return 0;
+			   }
+
+		   */
+			Hnsw(const std::size_t& m = static_cast<std::size_t>(defaults::M), const std::size_t& efConstruction = static_cast<std::size_t>(defaults::EF_CONSTRUCTION), const std::size_t& efSearch = static_cast<std::size_t>(defaults::EF_SEARCH), const std::size_t& threads = 0, const unsigned int& seed = 0);
+
+			void build(const data::Storage& X, const distanceMetric& metric, const double& p) override;
+
+			bool holdsObservations() const noexcept override;
+
+			void load(std::istream& in) override; // throws std::runtime_error
+
+			const double* observation(const std::size_t& id) const noexcept override;
+
+			void query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort = 0) const override;
+
+			void save(std::ostream& out) const override;
+
+			std::size_t size() const noexcept override;
+		};
+	}
+}
@@ -0,0 +1,837 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "../utils/Defines.h"
+#include "../utils/MappedFile.h"
+#include "../Numeric/Function.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			A neighbor found by a search. Index is the row of the observation in the training set.
+			Neighbors are ordered by distance and then by index so that ties are always broken the same way
+		*/
+		struct Neighbor
+		{
+			double Distance;
+			std::size_t Index;
+
+			bool operator<(const Neighbor& other) const noexcept
+			{
+				return (Distance < other.Distance) || (Distance == other.Distance && Index < other.Index);
+			}
+		};
+
+	/**
+		* Class Name : NeighborHeap
+
+		* Class Description : Bounded max heap (priority queue) holding the best k neighbors seen so far.
+							  The worst of them is on top so that a candidate is accepted or rejected in O(1)
+							  and inserted in O(log k).
+
+		* Functions :
+
+		1) full
+
+		2) push
+
+		3) reset
+
+		4) sorted
+
+		5) worst
+
+		*
+		*/
+		class NeighborHeap
+		{
+		protected:
+
+			std::vector<Neighbor> _heap;
+			std::size_t _capacity;
+
+		public:
+
+		/**
+		   * Constructor Name : NeighborHeap[Parameterized]
+
+		   * Constructor Description :  Constructor to load the number of neighbors to keep
+
+		   * Parameters :
+
+		   1) capacity		Number of neighbors to keep
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   cmll::neighbors::NeighborHeap heap(5);
+
+		   */
+			NeighborHeap(const std::size_t& capacity = 0);
+
+		/**
+		   * Function Name :  full
+
+		   * Function Description :  Function to check if capacity neighbors are held
+
+		   * Return :		bool - > true if the heap is full
+		*/
+			bool full() const noexcept;
+
+		/**
+		   * Function Name :  push
+
+		   * Function Description :  Function to offer a candidate. It is kept if the heap is not full or if it is closer than the worst neighbor held
+
+		   * Parameters :
+
+		   1) distance :		The distance of the candidate
+
+								Type Expected : double
+
+								Method of passing :  constant and by reference
+
+		   2) index :			The index of the candidate
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			void push(const double& distance, const std::size_t& index) noexcept;
+
+		/**
+		   * Function Name :  reset
+
+		   * Function Description :  Function to empty the heap and set a new capacity. The memory held is reused
+
+		   * Parameters :
+
+		   1) capacity :		Number of neighbors to keep
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			void reset(const std::size_t& capacity) noexcept;
+
+		/**
+		   * Function Name :  sorted
+
+		   * Function Description :  Function to move the neighbors held into result in increasing order of distance. The heap is emptied
+
+		   * Parameters :
+
+		   1) result :		The neighbors
+
+							Type Expected : std::vector<cmll::neighbors::Neighbor>
+
+							Method of passing :  by reference
+
+		   * Return :		None
+		*/
+			void sorted(std::vector<Neighbor>& result) noexcept;
+
+		/**
+		   * Function Name :  worst
+
+		   * Function Description :  Function to get the distance a candidate has to beat. Infinity while the heap is not full
+
+		   * Return :		double - > the distance of the worst neighbor held
+		*/
+			double worst() const noexcept;
+		};
+
+	/**
+		* Class Name : Values
+
+		* Class Description : Contiguous array of trivially copyable values held by an index. Filled by build() it owns its values.
+							  Read by load() from a stream over memory (utils::MemoryBuffer, as KnnRegressor::load() does with the
+							  mapped file) it only points to them, so the index does not copy what is already mapped. That memory
+							  has to outlive the index. A copy points to the same memory, or copies the values it owns
+
+		* Functions :
+
+		1) data
+
+		2) size
+
+		3) view
+
+		*
+		*/
+		template<typename T>
+		class Values
+		{
+		protected:
+
+			std::vector<T> _owned;
+
+			// Values not owned, nullptr when they are in _owned
+			const T* _view;
+			std::size_t _viewSize;
+
+		public:
+
+		/**
+		   * Constructor Name : Values[Parameterized]
+
+		   * Constructor Description :  Constructor to take the values to own
+
+		   * Parameters :
+
+		   1) values		The values
+
+							Type Expected : std::vector<T>
+
+							Method of passing :  by value (moved from)
+
+		   * Example
+
+			   cmll::neighbors::Values<double> points(std::vector<double>(rows * cols));
+
+		   */
+			Values(std::vector<T> values = std::vector<T>());
+
+		/**
+		   * Function Name :  data
+
+		   * Function Description :  Function to get the first value
+
+		   * Return :		const T* - > the values
+		*/
+			const T* data() const noexcept;
+
+		/**
+		   * Function Name :  size
+
+		   * Function Description :  Function to get the number of values
+
+		   * Return :		std::size_t - > number of values
+		*/
+			std::size_t size() const noexcept;
+
+		/**
+		   * Function Name :  view
+
+		   * Function Description :  Function to point to values held elsewhere instead of the owned ones, which are released
+
+		   * Parameters :
+
+		   1) values :		The first value
+
+							Type Expected : const T*
+
+							Method of passing :  value
+
+		   2) size :		Number of values
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			void view(const T* values, const std::size_t& size) noexcept;
+		};
+
+	/**
+		* Class Name : Index
+
+		* Class Description : Base class for the search structures used by the neighbor models (see cmll::neighbors::searchAlgorithm).
+							  An index is built once from the training set and then answers nearest neighbor queries.
+							  query() does not modify the index, so one index can be queried from many threads.
+							  radius() finds every observation within a distance instead of a fixed number of them. Exact indexes
+							  prune with the radius directly, the others inherit a search that asks query() for twice as many neighbors
+							  until one of them is out of the radius.
+							  Every index can be written to a binary stream and read back without being built again (save() and load()).
+
+		* Functions :
+
+		1) _read @protected
+
+		2) _readHeader @protected
+
+		3) _remaining @protected
+
+		4) _write @protected
+
+		5) _writeHeader @protected
+
+		6) build
+
+		7) features
+
+		8) holdsObservations
+
+		9) load
+
+		10) observation
+
+		11) query
+
+		12) radius
+
+		13) save
+
+		14) size
+
+		*
+		*/
+		class Index
+		{
+		protected:
+
+			distanceMetric _metric;
+			double _p;
+			std::size_t _cols;
+
+		/**
+		   * Function Name :  read (internal)
+
+		   * Function Description :  Function to read a vector written by _write() (count, then the values as they are in memory).
+									  The count is checked against the bytes left in the stream before anything is allocated.
+									  Into Values, the values of a stream over memory are used where they are when they are aligned
+									  for T (see Values) and copied otherwise
+
+		   * Parameters :
+
+		   1) in :			The binary stream
+
+							Type Expected : std::istream
+
+							Method of passing :  by reference
+
+		   2) values :		The vector to fill
+
+							Type Expected : std::vector<T> or cmll::neighbors::Values<T>
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws :		std::runtime_error : If the count is larger than what is left in the stream
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			template<typename T>
+			static void _read(std::istream& in, std::vector<T>& values); // throws std::runtime_error
+
+			template<typename T>
+			static void _read(std::istream& in, Values<T>& values); // throws std::runtime_error
+
+		/**
+		   * Function Name :  read (internal)
+
+		   * Function Description :  Function to read count values written without their count (see _read() above)
+
+		   * Parameters :
+
+		   1) in :			The binary stream
+
+							Type Expected : std::istream
+
+							Method of passing :  by reference
+
+		   2) count :		Number of values, as read from the stream
+
+							Type Expected : std::uint64_t
+
+							Method of passing :  constant and by reference
+
+		   3) values :		The vector to fill
+
+							Type Expected : std::vector<T> or cmll::neighbors::Values<T>
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws :		std::runtime_error : If count is larger than what is left in the stream
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			template<typename T>
+			static void _read(std::istream& in, const std::uint64_t& count, std::vector<T>& values); // throws std::runtime_error
+
+			template<typename T>
+			static void _read(std::istream& in, const std::uint64_t& count, Values<T>& values); // throws std::runtime_error
+
+		/**
+		   * Function Name :  read header (internal)
+
+		   * Function Description :  Function to read the magic, metric, number of features and p written by _writeHeader()
+
+		   * Parameters :
+
+		   1) in :			The binary stream
+
+							Type Expected : std::istream
+
+							Method of passing :  by reference
+
+		   2) magic :		The 8 characters the index is expected to start with
+
+							Type Expected : const char*
+
+							Method of passing :  value
+
+		   * Return :		bool - > false if the stream does not start with magic
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			bool _readHeader(std::istream& in, const char* magic);
+
+		/**
+		   * Function Name :  remaining (internal)
+
+		   * Function Description :  Function to get the number of bytes left in a stream that can seek (files, utils::MemoryBuffer).
+									  The position is not moved
+
+		   * Parameters :
+
+		   1) in :			The binary stream
+
+							Type Expected : std::istream
+
+							Method of passing :  by reference
+
+		   * Return :		std::uint64_t - > the bytes left, the largest std::uint64_t if the stream can not tell
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			static std::uint64_t _remaining(std::istream& in);
+
+		/**
+		   * Function Name :  write (internal)
+
+		   * Function Description :  Function to write the count and the values of a vector of trivially copyable values
+
+		   * Parameters :
+
+		   1) out :			The binary stream
+
+							Type Expected : std::ostream
+
+							Method of passing :  by reference
+
+		   2) values :		The vector to write
+
+							Type Expected : std::vector<T> or cmll::neighbors::Values<T>
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			template<typename T>
+			static void _write(std::ostream& out, const std::vector<T>& values);
+
+			template<typename T>
+			static void _write(std::ostream& out, const Values<T>& values);
+
+		/**
+		   * Function Name :  write header (internal)
+
+		   * Function Description :  Function to write magic, the metric, the number of features and p
+
+		   * Parameters :
+
+		   1) out :			The binary stream
+
+							Type Expected : std::ostream
+
+							Method of passing :  by reference
+
+		   2) magic :		8 characters identifying the index
+
+							Type Expected : const char*
+
+							Method of passing :  value
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _writeHeader(std::ostream& out, const char* magic) const;
+
+		public:
+
+			virtual ~Index() = default;
+
+		/**
+		   * Function Name :  build
+
+		   * Function Description :  Function to build the index over the observations of X
+
+		   * Parameters :
+
+		   1) X :			The feature matrix
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   2) metric :		The distance metric
+
+							Type Expected : cmll::neighbors::distanceMetric
+
+							Method of passing :  constant and by reference
+
+		   3) p :			The value p for order
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			virtual void build(const data::Storage& X, const distanceMetric& metric, const double& p) = 0;
+
+		/**
+		   * Function Name :  features
+
+		   * Function Description :  Function to get the number of features of the indexed observations
+
+		   * Return :		std::size_t - > number of features
+		*/
+			std::size_t features() const noexcept;
+
+		/**
+		   * Function Name :  Holds Observations
+
+		   * Function Description :  Function to know if the index keeps a full precision copy of the observations (see observation()).
+									  This version returns false
+
+		   * Return :		bool - > true if observation() can be used
+		*/
+			virtual bool holdsObservations() const noexcept;
+
+		/**
+		   * Function Name :  load
+
+		   * Function Description :  Function to read an index written by save(). It replaces whatever the index held
+
+		   * Parameters :
+
+		   1) in :			The binary stream to read from
+
+							Type Expected : std::istream
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the stream does not hold this kind of index or ends too early
+		*/
+			virtual void load(std::istream& in) = 0; // throws std::runtime_error
+
+		/**
+		   * Function Name :  observation
+
+		   * Function Description :  Function to get the full precision copy of an indexed observation, so that a model does not
+									  have to keep one of its own. This version returns nullptr (see holdsObservations())
+
+		   * Parameters :
+
+		   1) id :			The observation, numbered in the order build() was given them
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Return :		const double* - > the features of the observation (valid as long as the index is)
+		*/
+			virtual const double* observation(const std::size_t& id) const noexcept;
+
+		/**
+		   * Function Name :  query
+
+		   * Function Description :  Function to find the k nearest observations of x. The result holds the actual distances in increasing order.
+									  Approximate indexes trade accuracy for speed through effort, exact indexes ignore it
+
+		   * Parameters :
+
+		   1) x :			The observation
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  constant and by reference
+
+		   2) k :			Number of neighbors
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   3) result :		The neighbors found
+
+							Type Expected : std::vector<cmll::neighbors::Neighbor>
+
+							Method of passing :  by reference
+
+		   4) effort :		Search effort of an approximate index (for example efSearch of HNSW). 0 uses the default of the index
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			virtual void query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort = 0) const = 0;
+
+		/**
+		   * Function Name :  radius
+
+		   * Function Description :  Function to find every observation within distance r of x (distance <= r). The result holds the actual
+									  distances in increasing order. This version repeats query() with 16, 32, 64 ... neighbors until the farthest
+									  of them is out of the radius, so it is exact for exact indexes and as good as query() for approximate ones.
+									  Indexes that can prune with r directly override it
+
+		   * Parameters :
+
+		   1) x :			The observation
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  constant and by reference
+
+		   2) r :			The radius
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+		   3) result :		The neighbors found
+
+							Type Expected : std::vector<cmll::neighbors::Neighbor>
+
+							Method of passing :  by reference
+
+		   4) effort :		Search effort of an approximate index, passed to query(). 0 uses the default of the index
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			virtual void radius(const std::vector<double>& x, const double& r, std::vector<Neighbor>& result, const std::size_t& effort = 0) const;
+
+		/**
+		   * Function Name :  save
+
+		   * Function Description :  Function to write the index to a binary stream (native byte order) so that load() can read it without building it
+
+		   * Parameters :
+
+		   1) out :			The binary stream to write to
+
+							Type Expected : std::ostream
+
+							Method of passing :  by reference
+
+		   * Return :		None
+		*/
+			virtual void save(std::ostream& out) const = 0;
+
+		/**
+		   * Function Name :  size
+
+		   * Function Description :  Function to get the number of indexed observations
+
+		   * Return :		std::size_t - > number of observations
+		*/
+			virtual std::size_t size() const noexcept = 0;
+		};
+
+		/*
+			Values template members
+		*/
+
+		template<typename T>
+		Values<T>::Values(std::vector<T> values) : _owned(std::move(values)), _view(nullptr), _viewSize(0)
+		{
+		}
+
+		template<typename T>
+		const T* Values<T>::data() const noexcept
+		{
+			return (_view != nullptr) ? _view : _owned.data();
+		}
+
+		template<typename T>
+		std::size_t Values<T>::size() const noexcept
+		{
+			return (_view != nullptr) ? _viewSize : _owned.size();
+		}
+
+		template<typename T>
+		void Values<T>::view(const T* values, const std::size_t& size) noexcept
+		{
+			std::vector<T>().swap(_owned);
+			_view = values;
+			_viewSize = size;
+		}
+
+		/*
+			Index template members
+		*/
+
+		template<typename T>
+		void Index::_read(std::istream& in, std::vector<T>& values) // throws std::runtime_error
+		{
+			std::uint64_t count = 0;
+
+			in.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+			if (!in) return;
+
+			_read(in, count, values);
+		}
+
+		template<typename T>
+		void Index::_read(std::istream& in, Values<T>& values) // throws std::runtime_error
+		{
+			std::uint64_t count = 0;
+
+			in.read(reinterpret_cast<char*>(&count), sizeof(count));
+
+			if (!in) return;
+
+			_read(in, count, values);
+		}
+
+		template<typename T>
+		void Index::_read(std::istream& in, const std::uint64_t& count, std::vector<T>& values) // throws std::runtime_error
+		{
+			/*
+				A stream that can not tell its size is read in blocks of at most 1 MB, so a wrong count ends the stream
+				before it is allocated in full
+			*/
+			const std::size_t block = std::max(static_cast<std::size_t>(1048576) / sizeof(T), static_cast<std::size_t>(1));
+
+			values.clear();
+
+			if (!in) return;
+
+			if (count > _remaining(in) / sizeof(T)) throw std::runtime_error("<In function cmll::neighbors::Index::_read()>Error : The stream holds fewer values than it counts");
+
+			for (std::size_t done = 0; done < count && in; done += block)
+			{
+				std::size_t read = std::min(block, static_cast<std::size_t>(count) - done);
+
+				values.resize(done + read);
+				in.read(reinterpret_cast<char*>(values.data() + done), static_cast<std::streamsize>(read * sizeof(T)));
+			}
+		}
+
+		template<typename T>
+		void Index::_read(std::istream& in, const std::uint64_t& count, Values<T>& values) // throws std::runtime_error
+		{
+			utils::MemoryBuffer* memory = dynamic_cast<utils::MemoryBuffer*>(in.rdbuf());
+
+			if (!in) return;
+
+			if (count > _remaining(in) / sizeof(T)) throw std::runtime_error("<In function cmll::neighbors::Index::_read()>Error : The stream holds fewer values than it counts");
+
+			if (memory != nullptr && reinterpret_cast<std::uintptr_t>(memory->position()) % alignof(T) == 0)
+			{
+				values.view(reinterpret_cast<const T*>(memory->position()), static_cast<std::size_t>(count));
+				in.seekg(static_cast<std::streamoff>(count * sizeof(T)), std::ios_base::cur);
+				return;
+			}
+
+			std::vector<T> read;
+
+			_read(in, count, read);
+			values = Values<T>(std::move(read));
+		}
+
+		template<typename T>
+		void Index::_write(std::ostream& out, const std::vector<T>& values)
+		{
+			std::uint64_t count = values.size();
+
+			out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+			out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+		}
+
+		template<typename T>
+		void Index::_write(std::ostream& out, const Values<T>& values)
+		{
+			std::uint64_t count = values.size();
+
+			out.write(reinterpret_cast<const char*>(&count), sizeof(count));
+			out.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+		}
+	}
+}
@@ -0,0 +1,375 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <stdexcept>
+
+#include "../utils/Defines.h"
+#include "../utils/Parallel.h"
+#include "Index.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+	/**
+		* Class Name : IvfPq
+
+		* Class Description : Inverted file index with product quantization (approximate nearest neighbors).
+							  A coarse k-means with Lists centroids splits the observations into lists. The difference between an
+							  observation and the centroid of its list (the residual) is cut into SubQuantizers parts and every part is
+							  replaced by the index of the closest of 256 centroids learned for that part, so an observation is stored in
+							  SubQuantizers bytes plus a 4 byte index, whatever the number of features.
+							  A query only scans the Probes lists with the closest centroids. For every list a table of the distances
+							  of the query residual from all the centroids of every part is calculated once, and the distance of an
+							  observation is the sum of SubQuantizers table entries (asymmetric distance computation).
+							  Works with every distanceMetric since all of them add up over the features.
+							  The quantizers can be trained on a sample (train()) and the observations added in batches (add()),
+							  so the full training set never has to be held in memory.
+
+		* Attributes :
+
+		1) Lists : Number of coarse centroids (lists)
+
+		2) Probes : Lists scanned per query (used when query() gets no effort)
+
+		3) SubQuantizers : Parts the residuals are cut into (bytes per observation)
+
+		4) TrainingSize : Maximum observations the quantizers are trained on
+
+		5) Threads : Threads used for training and adding (0 for all hardware threads)
+
+		6) Seed : Seed for sampling and for the k-means
+
+		* Functions :
+
+		1) _assign @protected
+
+		2) _encode @protected
+
+		3) _kMeans @protected
+
+		4) add
+
+		5) build @overriden
+
+		6) load @overriden
+
+		7) memoryUsage
+
+		8) query @overriden
+
+		9) radius @inherited
+
+		10) remove
+
+		11) save @overriden
+
+		12) size @overriden
+
+		13) train
+
+		*
+		*/
+		class IvfPq : public Index
+		{
+		protected:
+
+			// Coarse centroids ( lists X features )
+			std::vector<double> _coarse;
+
+			// Centroids of the parts. Part s holds _centroids centroids of the features [_offsets[s], _offsets[s + 1]) starting at _centroids * _offsets[s]
+			std::vector<double> _codebooks;
+			std::vector<std::size_t> _offsets;
+
+			// For every list the codes ( observations X parts ) and the index of every observation
+			std::vector<std::vector<std::uint8_t>> _codes;
+			std::vector<std::vector<std::uint32_t>> _ids;
+
+			std::size_t _lists;
+			std::size_t _parts;
+			std::size_t _centroids;
+			std::size_t _rows;
+
+		/**
+		   * Function Name :  assign (internal)
+
+		   * Function Description :  Function to find the list of an observation (closest coarse centroid)
+
+		   * Return :		std::size_t - > the list
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			std::size_t _assign(const double* x) const noexcept;
+
+		/**
+		   * Function Name :  encode (internal)
+
+		   * Function Description :  Function to replace every part of a residual with the index of its closest centroid
+
+		   * Parameters :
+
+		   1) residual :	Pointer to the residual
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+		   2) codes :		Pointer to the _parts codes to write
+
+							Type Expected : std::uint8_t*
+
+							Method of passing :  value
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _encode(const double* residual, std::uint8_t* codes) const noexcept;
+
+		/**
+		   * Function Name :  K Means
+
+		   * Function Description :  Function to cluster contiguous observations with Lloyd's algorithm (squared euclidean distance).
+									  The centroids start at k random observations and empty clusters restart at a random observation
+
+		   * Parameters :
+
+		   1) data :		The observations ( rows X dimensions )
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  constant and by reference
+
+		   2) dimensions :	Features per observation
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   3) k :			Number of clusters (at most the number of observations)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   4) centroids :	The centroids found ( k X dimensions )
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  by reference
+
+		   5) generator :	The random number generator
+
+							Type Expected : std::mt19937
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _kMeans(const std::vector<double>& data, const std::size_t& dimensions, const std::size_t& k, std::vector<double>& centroids, std::mt19937& generator) const;
+
+		public:
+
+			std::size_t Lists;
+			std::size_t Probes;
+			std::size_t SubQuantizers;
+			std::size_t TrainingSize;
+			std::size_t Threads;
+			unsigned int Seed;
+
+		/**
+		   * Constructor Name : IvfPq[Parameterized]
+
+		   * Constructor Description :  Constructor to load the parameters of the index
+
+		   * Parameters :
+
+		   1) lists			Number of coarse centroids (nlist)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   2) probes		Lists scanned per query (nprobe)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   3) subQuantizers	Parts the residuals are cut into
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   4) threads		Threads used for training and adding (0 for all hardware threads)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   5) seed			Seed for sampling and for the k-means
+
+							Type Expected : unsigned int
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/IvfPq.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::IvfPq index(4096, 16, 16);
+
+				   index.train(sample,cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+				   // Add the training set in batches that fit in memory
+				   index.add(batch1);
+				   index.add(batch2);
+
+				   index.query(x,10,neighbors);
+
+				   return 0;
+			   }
+
+		   */
+			IvfPq(const std::size_t& lists = static_cast<std::size_t>(defaults::LISTS), const std::size_t& probes = static_cast<std::size_t>(defaults::PROBES), const std::size_t& subQuantizers = static_cast<std::size_t>(defaults::SUB_QUANTIZERS), const std::size_t& threads = 0, const unsigned int& seed = 0);
+
+		/**
+		   * Function Name :  add
+
+		   * Function Description :  Function to encode observations and append them to their lists. They are numbered after the ones added before
+
+		   * Parameters :
+
+		   1) X :			The observations
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the index is not trained
+		*/
+			void add(const data::Storage& X); // throws std::runtime_error
+
+			void build(const data::Storage& X, const distanceMetric& metric, const double& p) override;
+
+			void load(std::istream& in) override; // throws std::runtime_error
+
+		/**
+		   * Function Name :  Memory Usage
+
+		   * Function Description :  Function to get the bytes used by the centroids, codes and indexes
+
+		   * Return :		std::size_t - > bytes used
+		*/
+			std::size_t memoryUsage() const noexcept;
+
+			void query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort = 0) const override;
+
+		/**
+		   * Function Name :  remove
+
+		   * Function Description :  Function to remove observations from their lists. The remaining ones are numbered again in order (0, 1, ...)
+
+		   * Parameters :
+
+		   1) removed :		1 for every observation to remove (observations past its end are kept)
+
+							Type Expected : std::vector<std::uint8_t>
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			void remove(const std::vector<std::uint8_t>& removed) noexcept;
+
+			void save(std::ostream& out) const override;
+
+			std::size_t size() const noexcept override;
+
+		/**
+		   * Function Name :  train
+
+		   * Function Description :  Function to learn the coarse centroids and the centroids of the parts from at most TrainingSize
+									  observations of X picked at random. Every observation added before is removed
+
+		   * Parameters :
+
+		   1) X :			The observations to train on
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   2) metric :		The distance metric
+
+							Type Expected : cmll::neighbors::distanceMetric
+
+							Method of passing :  constant and by reference
+
+		   3) p :			The value p for order
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+		*/
+			void train(const data::Storage& X, const distanceMetric& metric, const double& p);
+		};
+	}
+}
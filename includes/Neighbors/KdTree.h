@@ -0,0 +1,224 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <stdexcept>
+
+#include "../utils/Defines.h"
+#include "Index.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+	/**
+		* Class Name : KdTree
+
+		* Class Description : K dimensional tree. Every node splits its observations at the median of the feature with the largest spread
+							  until at most LeafSize observations are left. The nodes are packed in one array in pre order
+							  (the left child of a node is the next node) with their bounding boxes in two more arrays, and the observations
+							  are copied in leaf order so that every leaf is one contiguous block.
+							  Queries descend the closer child first and skip every node whose bounding box is farther than the
+							  current k-th neighbor. Works with every distanceMetric.
+
+		* Attributes :
+
+		1) LeafSize : Maximum observations in a leaf
+
+		* Functions :
+
+		1) _boxDistance @protected
+
+		2) _build @protected
+
+		3) build @overriden
+
+		4) holdsObservations @overriden
+
+		5) load @overriden
+
+		6) observation @overriden
+
+		7) query @overriden
+
+		8) radius @overriden
+
+		9) save @overriden
+
+		10) size @overriden
+
+		*
+		*/
+		class KdTree : public Index
+		{
+		protected:
+
+			/*
+				Observations of a node are [Begin, End) of the leaf ordered observations. Right is 0 for leaves
+			*/
+			struct Node
+			{
+				std::size_t Begin, End, Right;
+			};
+
+			std::vector<Node> _nodes;
+
+			// Bounding box of every node ( nodes X features )
+			std::vector<double> _lower, _upper;
+
+			// Observations in leaf order ( observations X features ) and their index in the training set
+			Values<double> _points;
+			std::vector<std::size_t> _ids;
+
+			// Place of every observation in _points (inverse of _ids)
+			std::vector<std::size_t> _positions;
+
+		/**
+		   * Function Name :  Box Distance
+
+		   * Function Description :  Function to calculate the reduced distance of x from the bounding box of a node (0 if inside)
+
+		   * Parameters :
+
+		   1) x :			Pointer to the observation
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+		   2) node :		The node
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Return :		double - > the reduced distance
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			double _boxDistance(const double* x, const std::size_t& node) const noexcept;
+
+		/**
+		   * Function Name :  build (internal)
+
+		   * Function Description :  Function to create the node for the observations order[begin, end) and, recursively, its children
+
+		   * Parameters :
+
+		   1) X :			The feature matrix
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   2) order :		Indexes of the observations, rearranged so that every node holds a contiguous range
+
+							Type Expected : std::vector<std::size_t>
+
+							Method of passing :  by reference
+
+		   3) begin, end :	The range of the node
+
+							Type Expected : std::size_t
+
+							Method of passing :  value
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _build(const data::Storage& X, std::vector<std::size_t>& order, std::size_t begin, std::size_t end);
+
+		public:
+
+			std::size_t LeafSize;
+
+		/**
+		   * Constructor Name : KdTree[Parameterized]
+
+		   * Constructor Description :  Constructor to load the leaf size
+
+		   * Parameters :
+
+		   1) leafSize		Maximum observations in a leaf
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/KdTree.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KdTree tree(16);
+
+				   tree.build(X,cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+				   tree.query(x,5,neighbors);
+
+				   return 0;
+			   }
+
+		   */
+			KdTree(const std::size_t& leafSize = static_cast<std::size_t>(defaults::LEAF_SIZE));
+
+			void build(const data::Storage& X, const distanceMetric& metric, const double& p) override;
+
+			bool holdsObservations() const noexcept override;
+
+			void load(std::istream& in) override; // throws std::runtime_error
+
+			const double* observation(const std::size_t& id) const noexcept override;
+
+			void query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort = 0) const override;
+
+			void radius(const std::vector<double>& x, const double& r, std::vector<Neighbor>& result, const std::size_t& effort = 0) const override;
+
+			void save(std::ostream& out) const override;
+
+			std::size_t size() const noexcept override;
+		};
+	}
+}
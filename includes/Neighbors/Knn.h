@@ -15,7 +15,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : March 27, 2020
-	* Last modified : April 19, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (0.1.0)
 
@@ -26,13 +26,33 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <functional>
+#include <future>
 #include <iostream>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <random>
+#include <string>
 
+#include "../Data/BatchReader.h"
 #include "../utils/Defines.h"
+#include "../utils/MappedFile.h"
+#include "../utils/Parallel.h"
 #include "../Numeric/Function.h"
 #include "../Numeric/Matrix.h"
 #include "../Numeric/Array.h"
+#include "BallTree.h"
+#include "Hnsw.h"
+#include "IvfPq.h"
+#include "KdTree.h"
+#include "Lsh.h"
+#include "Quantizer.h"
 
 /*
 	Parent name space : All name spaces lie under this parent name space
@@ -63,454 +83,490 @@ namespace cmll
 
 		5) y : Vector of prediction
 
-		* Functions :
+		6) Quantization : Precision the training set is stored in (cmll::neighbors::quantization)
 
-		1) _calculateDistances
+		7) Rerank : Number of candidates re-ranked in full precision when quantized or using IVF_PQ (0 to disable and release X)
 
-		2) _distancesFromX
+		8) Algorithm : Search structure built by model() (cmll::neighbors::searchAlgorithm)
 
-		3) _neighborKSort
+		9) LeafSize : Maximum observations in a leaf of a tree index
 
-		4) model
+		10) Threads : Threads used for building the search structure and for predicting (0 for all hardware threads)
 
-		5) predict
+		11) M : Links per node of a HNSW graph
 
-		6) rss
+		12) EfConstruction : Candidates kept while building a HNSW graph
 
-		7) score
+		13) EfSearch : Candidates kept while querying a HNSW graph (larger is slower with better recall)
 
-		8) tss
+		14) Lists : Number of lists of an IVF_PQ index
 
-		*
-		*/
-		class KnnRegressor
-		{
-		protected:
+		15) Probes : Lists scanned per query by an IVF_PQ index, extra buckets read per table by a LSH index (larger is slower with better recall)
 
-			distanceMetric Metric;
+		16) SubQuantizers : Bytes per observation of an IVF_PQ index
 
-			/**
-			   * Function Name :  Calculate Distance
+		17) Tables : Number of hash tables of a LSH index
 
-			   * Function Description :  Function to Calculate distances of each observation of Xtest to each observation in X
+		18) HashFunctions : Projections per hash table of a LSH index
 
-			   * Parameters :
+		19) Width : Bucket width of a LSH index (0 to estimate it)
 
-			   1) XTest :		The test set feature matrix
+		20) CompactionRatio : Inserted plus erased observations, as a fraction of the indexed ones, that start rebuilding the index in the background
 
-							   Type Expected : cmll::data::Storage
+		* Functions :
 
-							   Method of passing :  constant and by reference
+		1) _bruteNeighbors
 
-			   2) result :		The predicted values
+		2) _createIndex
 
-							   Type Expected : cmll::data::Storage
+		3) _fullPrecision
 
-							   Method of passing :  by reference
+		4) _kNeighbors
 
-			   * Return :	   None
+		5) _label
 
+		6) _observation
 
-			   * Example
+		7) _observations
 
-				This function is internal and protected
+		8) _queryBlock
 
+		9) _radiusNeighbors
 
-			*/
-			void _calculateDistances(const data::Storage& Xtest, data::Storage& result) noexcept;
-			
-		/**
-		   * Function Name :  Neighbor K Sort
+		10) _rebuildIndex
 
-		   * Function Description :  Function to Sort the calculated distances and Keep only first K distances
+		11) _swapIndex
 
-		   * Parameters :
+		12) compact
 
-		   1) distances	:		The calculated distances
+		13) erase
 
-								Type Expected : cmll::data::Storage
+		14) insert
 
-								Method of passing : const and by reference
+		15) kNeighbors
 
-		   2) sortedKDistances :	   The distance of the point from  each observation X
+		16) load
 
-									   Type Expected : cmll::data::Storage
+		17) model
 
-									   Method of passing : By reference
+		18) partialFit
 
-		   * Return :	   None
+		19) predict
 
+		20) radiusNeighbors
 
-		   * Example
+		21) recall
 
-			This function is internal and protected
+		22) rss
 
+		23) save
 
-		*/
-			void _neighborKSort(const data::Storage& distances, data::Storage& sortedKDistances) noexcept;
+		24) score
 
-		/**
-		   * Function Name :  Distances From X
+		25) tss
 
-		   * Function Description :  Function to distances of a new set of points from the Feature matrix
+		*
+		*/
+		class KnnRegressor
+		{
+		protected:
 
-		   * Parameters :
+			distanceMetric Metric;
 
-		   1) x :		   The new set of points
+			// Reduced precision copy of X when Quantization is not quantization::NONE
+			ScalarQuantizer _quantizer;
 
-						   Type Expected : std::vector<double>
+			// Search structure when Algorithm is not searchAlgorithm::BRUTE
+			std::shared_ptr<Index> _index;
 
-						   Method of passing : const and by reference
-		
-		   2) result :	   The distance of the point from  each observation X 
+			// Row of every observation of the index in the order it numbers them, ascending (null when it numbers them 0, 1, 2 ...).
+			// Shared so that a rebuild in the background can read it while the model keeps using it
+			std::shared_ptr<const std::vector<std::size_t>> _indexRows;
 
-						   Type Expected : std::vector<double>
+			// Rows from _indexEnd onwards were inserted after the index was built. They are kept here and compared by brute force
+			data::Storage _delta;
+			std::size_t _indexEnd;
 
-						   Method of passing : By reference
+			// Tombstones : 1 for erased rows. _staleRows are the erased rows the index still holds
+			std::vector<std::uint8_t> _erased;
+			std::size_t _erasedCount;
+			std::vector<std::size_t> _staleRows;
 
-		   * Return :	   None
+			/*
+				Result of a rebuild : the new index and the row of every observation it holds (see _indexRows)
+			*/
+			struct Rebuilt
+			{
+				std::shared_ptr<Index> Search;
+				std::shared_ptr<const std::vector<std::size_t>> Rows;
+			};
+
+			// Index being rebuilt in the background, the first row it does not cover and the erased rows it holds
+			std::shared_future<Rebuilt> _compaction;
+			std::size_t _compactionEnd;
+			std::vector<std::size_t> _compactionStaleRows;
+
+			// File mapped by load(). X and y are then empty : the observations (row major) and labels are read from the mapping,
+			// and the index loaded with them points into it
+			std::shared_ptr<utils::MappedFile> _store;
+			const double* _storeX;
+			const double* _storeY;
+			std::size_t _storeRows, _storeCols, _storeClasses;
 
+		/**
+		   * Function Name :  Brute Neighbors
 
-		   * Example
+		   * Function Description :  Function to find the k nearest observations of X (or of its codes when quantized) for the observations
+									  first .. last of XTest by comparing with all of them. XTest is processed in blocks of queries and X in tiles that are
+									  copied to one contiguous buffer, so a tile stays in cache while every query of the block is compared with it.
+									  Every query keeps its best candidates in a bounded heap, so no distance matrix is held.
+									  When quantized with Rerank set, the best max(k, Rerank) candidates are re-ranked in full precision.
 
-			This function is internal and protected
+		   * Parameters :
 
+		   1) XTest :			   The test set feature matrix
 
-		*/
-			void _distancesFromX(const std::vector<double>& x, std::vector<double>& result) noexcept;
+								   Type Expected : cmll::data::Storage
 
-		public:
+								   Method of passing : const and by reference
 
-			data::Storage X, y;
-			std::size_t K;
-			double P;
-			
+		   2) first :			   The first observation of XTest
 
+								   Type Expected : std::size_t
 
-			std::function<double(const std::vector<double>&, const std::vector < double>&,const double&)> DistanceCal;
+								   Method of passing : const and by reference
 
-		/**
-		   * Constructor Name : KnnRegressor[Parameterized]
+		   3) last :			   One past the last observation of XTest
 
-		   * Constructor Description :  Constructor to load values
+								   Type Expected : std::size_t
 
-		   * Parameters :
+								   Method of passing : const and by reference
 
-		   1) K				Number of nearest neighbors to consider
+		   4) k :				   Number of neighbors
 
-							Type Expected : double
+								   Type Expected : std::size_t
 
-							Method of passing :  constant and by reference
+								   Method of passing : const and by reference
 
-		   2) metric		Distance metric
+		   5) neighbors :		   The neighbors found ( last - first observations X k, row wise ) with reduced distances
 
-							Type expected distanceMetrix
+								   Type Expected : std::vector<cmll::neighbors::Neighbor>
 
-							Method of passing : const and by reference
+								   Method of passing : By reference
 
-		   3) p			    The value p for order
+		   * Return :	   None
 
-							Type Expected : double
 
-							Method of passing :  constant and by reference
 		   * Example
 
-			   #include<vector>
-			   #include<Neighbors/Knn.h>
-			   #include<iostream>
+			This function is internal and protected
 
-			   int main()
-			   {
 
-				   cmll::neighbors::KnnRegressor r1(4,cmll::neighbors::distanceMetric::EUCLEDIAN);
+		*/
+			void _bruteNeighbors(const data::Storage& XTest, const std::size_t& first, const std::size_t& last, const std::size_t& k, std::vector<Neighbor>& neighbors) const noexcept;
 
-				   return 0;
+		/**
+		   * Function Name :  Create Index (internal)
 
-			   }
+		   * Function Description :  Function to create an (empty) search structure with the current parameters
 
+		   * Parameters :
 
-		   */
-			KnnRegressor(const std::size_t& k = static_cast<std::size_t>(defaults::K), const distanceMetric& metric = distanceMetric::EUCLEDIAN, const double &p = static_cast<double>(defaults::P));
+		   1) algorithm :		   The search structure
 
-			/**
-			* Function Name :  model
+								   Type Expected : cmll::neighbors::searchAlgorithm
 
-			* Function Description :  Function to built a Knn regression model using Feature Matrix X and vector of prediction y.
+								   Method of passing : const and by reference
 
-			* Parameters :
+		   * Return :	   std::shared_ptr<cmll::neighbors::Index> - > the index, empty for searchAlgorithm::BRUTE
 
-			1) X :			The feature matrix
 
-							Type Expected : cmll::data::Storage
+		   * Example
 
-							Method of passing :  constant and by reference
+			This function is internal and protected
 
-			2) y :		    Vector of prediction
 
-							Type Expected : cmll::data::Storage
+		*/
+			std::shared_ptr<Index> _createIndex(const searchAlgorithm& algorithm) const;
 
-							Method of passing :  constant and by reference
+		/**
+		   * Function Name :  Full Precision (internal)
 
-			* Return :		None
+		   * Function Description :  Function to check if the full precision observations are available (in X, in a loaded file or in the index)
 
+		   * Parameters :	None
 
-			* Example
+		   * Return :	   bool - > true if _observation() can be used
 
-				#include<vector>
-				#include<Neighbors/Knn.h>
 
-				int main()
-				{
-					// vector creation and element adding here
+		   * Example
 
-					cmll::neighbors::KnnRegressor l1;
+			This function is internal and protected
 
-					l1.model(X,y);
 
-					return 0;
+		*/
+			bool _fullPrecision() const noexcept;
 
-				}
+		/**
+		   * Function Name :  K Neighbors (internal)
 
+		   * Function Description :  Function to find the indexes and distances of the nearest observations of X for the observations first .. last of XTest.
+									  If an index was built by model() it is queried, otherwise _bruteNeighbors() is used.
+									  The candidates of an IVF_PQ index are re-ranked in full precision when Rerank is set.
+									  Every observation gets min(K, observations in X) neighbors. Only local buffers are written, so
+									  threads can call it on different blocks of XTest at the same time
 
-			*/
-			void model(const data::Storage& X, const data::Storage& y) noexcept;
+		   * Parameters :
 
-		/**
-		   * Function Name :  predict
+		   1) XTest :			   The test set feature matrix
 
-		   * Function Description :  Function to predict using Knn regression model built by model()
+								   Type Expected : cmll::data::Storage
 
-		   * Parameters :
+								   Method of passing : const and by reference
 
-		   1) XTest :		The test set feature matrix
+		   2) first :			   The first observation of XTest
 
-						   Type Expected : cmll::data::Storage
+								   Type Expected : std::size_t
 
-						   Method of passing :  constant and by reference
+								   Method of passing : const and by reference
 
-		   2) result :		The predicted values
+		   3) last :			   One past the last observation of XTest
 
-						   Type Expected : cmll::data::Storage
+								   Type Expected : std::size_t
 
-						   Method of passing :  by reference
+								   Method of passing : const and by reference
 
-		   * Return :		None
+		   4) indexes :			   The indexes of the nearest observations ( last - first observations X neighbors, row wise )
 
-		   * Throws    :  std::runtime_error : If the coefficient vector is empty
+								   Type Expected : std::vector<std::size_t>
 
-		   * Example
+								   Method of passing : By reference
 
-			   #include<vector>
-			   #include<Neighbors/Knn.h>
+		   5) distances :		   Their distances, in the same layout
 
-			   int main()
-			   {
-				   // vector creation and element adding here
+								   Type Expected : std::vector<double>
 
-				   cmll::neighbors::KnnRegressor r1;
+								   Method of passing : By reference
 
-				   l1.model(X,y);
+		   * Return :	   std::size_t - > neighbors found for every observation
 
-				   l1.predict(XTest,result);
 
-				   return 0;
+		   * Example
 
-			   }
+			This function is internal and protected
 
 
-		   */
-			void predict(const data::Storage& XTest, data::Storage& result); // throws std::runtime_error
+		*/
+			std::size_t _kNeighbors(const data::Storage& XTest, const std::size_t& first, const std::size_t& last, std::vector<std::size_t>& indexes, std::vector<double>& distances) const noexcept;
 
 		/**
-		   * Function Name :  RSS
+		   * Function Name :  Label (internal)
 
-		   * Function Description :  Function to calculate Residual Sum of Squares of the model
+		   * Function Description :  Function to get the label of an observation, from y or from the loaded file
 
 		   * Parameters :
 
-		   1) yPred:		The predicted values by the model
+		   1) row :				   The row of the observation
 
-						   Type Expected : cmll::data::Storage
+								   Type Expected : std::size_t
 
-						   Method of passing :  constant and by reference
+								   Method of passing : const and by reference
 
-		   2) y:	        The actual values
+		   * Return :	   double - > the label
 
-						   Type Expected : cmll::data::Storage
 
-						   Method of passing :  constant and by reference
+		   * Example
 
+			This function is internal and protected
 
-		   * Return :		Residual sum of squares calculated
 
+		*/
+			double _label(const std::size_t& row) const noexcept;
 
-		   * Example
+		/**
+		   * Function Name :  Observation (internal)
 
-			   #include<vector>
-			   #include<Neighbors/Knn.h>
-			   #include<iostream>
+		   * Function Description :  Function to get the full precision features of an observation, from X, from the loaded file, from the
+									  brute force buffer or from the index. The row must not be erased
 
-			   int main()
-			   {
-				   // vector creation and element adding here
+		   * Parameters :
 
-				   cmll::neighbors::KnnRegressor r1;
-				   
-				   l1.model(X,y);
+		   1) row :				   The row of the observation
 
-				   l1.predict(XTest,y_pred);
+								   Type Expected : std::size_t
 
-				   std::cout<<l1.rss(yPred,y);
+								   Method of passing : const and by reference
 
-				   return 0;
+		   * Return :	   const double* - > the features
 
-			   }
 
+		   * Example
 
-		   */
-			double rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+			This function is internal and protected
 
-		/**
-		   * Function Name :  score
 
-		   * Function Description :  Function to calculate R^2 score of the Knn Regression model built
+		*/
+			const double* _observation(const std::size_t& row) const noexcept;
 
-		   * Parameters :
+		/**
+		   * Function Name :  Observations (internal)
 
-		   1) yPred:		The predicted values by the model
+		   * Function Description :  Function to get the number of rows of the training set, erased ones included (0 if not built)
 
-						   Type Expected : cmll::data::Storage
+		   * Parameters :	None
 
-						   Method of passing :  constant and by reference
+		   * Return :	   std::size_t - > the number of rows
 
-		   2) y:	        The actual values
 
-						   Type Expected : cmll::data::Storage
+		   * Example
 
-						   Method of passing :  constant and by reference
+			This function is internal and protected
 
 
-		   * Return :		R^2 score calculated
+		*/
+			std::size_t _observations() const noexcept;
 
+		/**
+		   * Function Name :  Query Block (internal)
 
-		   * Example
+		   * Function Description :  Function to get the number of test observations a thread takes at once when the test set is
+									  handed out to Threads threads (see utils::parallel::forEach()). Threads that finish early take the next block
 
-			   #include<vector>
-			   #include<Neighbors/Knn.h>
-			   #include<iostream>
+		   * Parameters :
 
-			   int main()
-			   {
-				   // vector creation and element adding here
+		   1) rows :			   Observations in the test set
 
-				   cmll::neighbors::KnnRegressor r1;
+								   Type Expected : std::size_t
 
-				   l1.model(X,y);
+								   Method of passing : const and by reference
 
-				   auto yPred = l1.predict(XTest);
+		   * Return :	   std::size_t - > observations per block (1 to 64)
 
-				   std::cout<<l1.score(yPred,y);
 
-				   return 0;
+		   * Example
 
-			   }
+			This function is internal and protected
 
 
-		   */
-			double score(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+		*/
+			std::size_t _queryBlock(const std::size_t& rows) const noexcept;
 
 		/**
-		  * Function Name :  TSS
+		   * Function Name :  Radius Neighbors (internal)
 
-		  * Function Description :  Function to calculate Total Sum of Squares of the model
+		   * Function Description :  Function to find every observation of X within distance radius of x, nearest first.
+									  If an index was built by model() its radius() is used and the observations inserted since are
+									  compared by brute force, otherwise every observation is compared. Distances are abandoned as soon
+									  as they are beyond the radius (see functions::distance::reducedWithin()). Erased observations are skipped.
+									  Quantized codes and IVF_PQ distances are approximate, so their candidates are checked again in full precision
+									  when it is kept
 
-		  * Parameters :
+		   * Parameters :
 
-		  1) y:	        The actual values
+		   1) x :				   The observation
 
-						  Type Expected : cmll::data::Storage
+								   Type Expected : std::vector<double>
 
-						  Method of passing :  constant and by reference
+								   Method of passing : const and by reference
 
+		   2) radius :			   The radius
 
-		  * Return :		Total sum of squares calculated
+								   Type Expected : double
 
+								   Method of passing : const and by reference
 
-		  * Example
+		   3) neighbors :		   The neighbors found (rows of X and actual distances)
 
-			  #include<vector>
-			  #include<Neighbors/Knn.h>
-			  #include<iostream>
+								   Type Expected : std::vector<cmll::neighbors::Neighbor>
 
-			  int main()
-			  {
-				  // vector creation and element adding here
+								   Method of passing : By reference
 
-				  cmll::neighbors::KnnRegressor r1;
+		   * Return :	   None
 
-				  std::cout<<l1.tss(y);
 
-				  return 0;
+		   * Example
 
-			  }
+			This function is internal and protected
 
 
-		  */
-			double tss(const data::Storage& y) noexcept;
+		*/
+			void _radiusNeighbors(const std::vector<double>& x, const double& radius, std::vector<Neighbor>& neighbors) const noexcept;
 
-		};
 		/**
-		* Class Name : KnnClassifier
+		   * Function Name :  Rebuild Index (internal)
 
-		* Class Description : Class containing functions required for building a Knn Classifier model
+		   * Function Description :  Function to start building, in a background thread, an index holding every observation not erased.
+									  Only the erased rows the index holds and the inserted observations are copied on the calling thread.
+									  The background thread reads the live observations out of the old index (which it keeps alive) and
+									  builds a new one from them, or for IVF_PQ removes the erased codes from a copy of the index and adds
+									  the inserted observations to it.
+									  Does nothing while a rebuild is running or when no index can be rebuilt
 
-		* Attributes :
+		   * Parameters :	None
 
-		1) K : - Neighbors to consider @inherited
+		   * Return :	   None
 
-		2) Metric : The distance metric @inherited
 
-		3) P : Order @inherited
+		   * Example
 
-		4) X : Feature Matrix @inherited
+			This function is internal and protected
 
-		5) y : Vector of prediction @inherited
 
-		* Functions :
+		*/
+			void _rebuildIndex();
 
-		1) _calculateDistances @inherited
+		/**
+		   * Function Name :  Swap Index (internal)
 
-		2) _distancesFromX @inherited
+		   * Function Description :  Function to replace the index with the one rebuilt in the background, once it is finished.
+									  The inserted observations it covers leave the brute force buffer
 
-		3) _neighborKSort @inherited
+		   * Parameters :
 
-		4) model @inherited
+		   1) wait :			   selection::YES to wait for a running rebuild, selection::NO to only swap a finished one
 
-		5) predict @overriden
+								   Type Expected : cmll::neighbors::selection
 
-		6) rss @protectedScoped
+								   Method of passing : const and by reference
 
-		7) score @overriden
+		   * Return :	   None
 
-		8) tss @protectedScoped
 
-		*
-		*/
-		class KnnClassifier : public KnnRegressor
-		{
-		protected:
-			
-			/*
-				In a classification setting, rss and tss are not required
-			*/
+		   * Example
 
-			using KnnRegressor::rss;
-			using KnnRegressor::tss;
+			This function is internal and protected
+
+
+		*/
+			void _swapIndex(const selection& wait);
 
 		public:
 
+			data::Storage X, y;
+			std::size_t K;
+			double P;
+			quantization Quantization;
+			std::size_t Rerank;
+			searchAlgorithm Algorithm;
+			std::size_t LeafSize;
+			std::size_t Threads;
+			std::size_t M;
+			std::size_t EfConstruction;
+			std::size_t EfSearch;
+			std::size_t Lists;
+			std::size_t Probes;
+			std::size_t SubQuantizers;
+			std::size_t Tables;
+			std::size_t HashFunctions;
+			double Width;
+			double CompactionRatio;
+
+
+
+			std::function<double(const std::vector<double>&, const std::vector < double>&,const double&)> DistanceCal;
+
 		/**
-		   * Constructor Name : KnnClassifierr[Parameterized]
+		   * Constructor Name : KnnRegressor[Parameterized]
 
 		   * Constructor Description :  Constructor to load values
 
@@ -521,45 +577,178 @@ namespace cmll
 							Type Expected : double
 
 							Method of passing :  constant and by reference
-			
-			2) metric		Distance metric
+
+		   2) metric		Distance metric
 
 							Type expected distanceMetrix
 
 							Method of passing : const and by reference
 
-			3) p			The value p for order
-							
+		   3) p			    The value p for order
+
 							Type Expected : double
 
 							Method of passing :  constant and by reference
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+			   #include<iostream>
+
+			   int main()
+			   {
+
+				   cmll::neighbors::KnnRegressor r1(4,cmll::neighbors::distanceMetric::EUCLEDIAN);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			KnnRegressor(const std::size_t& k = static_cast<std::size_t>(defaults::K), const distanceMetric& metric = distanceMetric::EUCLEDIAN, const double &p = static_cast<double>(defaults::P));
+
+		/**
+		   * Function Name :  compact
+
+		   * Function Description :  Function to rebuild the index without the erased observations and with the inserted ones.
+									  insert() and erase() start this in the background on their own once the inserted plus erased
+									  observations exceed CompactionRatio of the indexed ones. Queries keep using the old index (plus
+									  the brute force buffer and the tombstones) until the new one is swapped in by a later call to
+									  insert(), erase() or compact(). With selection::YES the rebuilds are repeated until no inserted
+									  or erased observation is left out of the index. Does nothing for searchAlgorithm::BRUTE
+
+		   * Parameters :
+
+		   1) wait :		selection::YES to block until the new index is in use
+
+						   Type Expected : cmll::neighbors::selection
 
+						   Method of passing :  constant and by reference
 
+		   * Return :		None
 
 		   * Example
 
 			   #include<vector>
 			   #include<Neighbors/Knn.h>
-			   #include<iostream>
 
 			   int main()
 			   {
+				   cmll::neighbors::KnnRegressor r1(5);
 
-				   cmll::neighbors::KnnClassifier r1(4,cmll::neighbors::distanceMetric::EUCLEDIAN);
+				   r1.Algorithm = cmll::neighbors::searchAlgorithm::HNSW;
+
+				   r1.model(X,y);
+
+				   r1.insert(XNew,yNew);
+
+				   r1.compact(cmll::neighbors::selection::YES);
+
+				   return 0;
+			   }
+
+
+		   */
+			void compact(const selection& wait = selection::NO);
+
+		/**
+		   * Function Name :  erase
+
+		   * Function Description :  Function to remove observations from the training set. They are marked with a tombstone and never
+									  returned again, their full precision copy in X is released at once and they leave the index at the
+									  next compaction. Rows are not renumbered, so indexes returned by kNeighbors() stay valid.
+									  Rows already erased are ignored
+
+		   * Parameters :
+
+		   1) rows :		The rows of X to erase
+
+						   Type Expected : std::vector<std::size_t>
+
+						   Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the model is not built or a row does not exist
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KnnRegressor r1(5);
+
+				   r1.model(X,y);
+
+				   r1.erase({ 0, 42 });
 
 				   return 0;
+			   }
+
+
+		   */
+			void erase(const std::vector<std::size_t>& rows); // throws std::runtime_error
+
+		/**
+		   * Function Name :  insert
+
+		   * Function Description :  Function to add observations to a built model without copying the stored ones, in amortized
+									  constant time per observation. They get the rows after the existing ones. With an index they are
+									  kept in a buffer compared by brute force until the next compaction adds them to the index
+
+		   * Parameters :
+
+		   1) X :			The feature matrix of the new observations
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) y :			Their vector of prediction
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the model is not built or X and y have different number of observations
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KnnRegressor r1(5);
+
+				   r1.Algorithm = cmll::neighbors::searchAlgorithm::KD_TREE;
+
+				   r1.model(X,y);
+
+				   // Hourly refresh
+				   r1.insert(XNew,yNew);
+				   r1.erase(expired);
 
+				   r1.predict(XTest,result);
+
+				   return 0;
 			   }
 
 
 		   */
-			KnnClassifier(const std::size_t& k = static_cast<std::size_t>(defaults::K), const distanceMetric& metric = distanceMetric::EUCLEDIAN, const double& p = static_cast<double>(defaults::P));
+			void insert(const data::Storage& X, const data::Storage& y); // throws std::runtime_error
 
-			
 		/**
-		   * Function Name :  predict
+		   * Function Name :  K Neighbors
 
-		   * Function Description :  Function to predict using Knn classifier model built by model()
+		   * Function Description :  Function to find the K nearest observations of X for each observation of XTest, using the
+									  search structure chosen by Algorithm. Memory used grows with XTest observations X K only.
+									  If X holds less than K observations, all of them are returned
 
 		   * Parameters :
 
@@ -569,160 +758,1453 @@ namespace cmll
 
 						   Method of passing :  constant and by reference
 
-		   2) result :		The predicted values
+		   2) indexes :		Rows of X of the neighbors, nearest first ( XTest observations X K, row wise )
 
-						   Type Expected : cmll::data::Storage
+						   Type Expected : std::vector<std::size_t>
+
+						   Method of passing :  by reference
+
+		   3) distances :	Distances of the neighbors, in the same layout
+
+						   Type Expected : std::vector<double>
 
 						   Method of passing :  by reference
 
-		   * Return :		None
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the model is not built
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KnnRegressor r1(5);
+
+				   r1.model(X,y);
+
+				   std::vector<std::size_t> indexes;
+				   std::vector<double> distances;
+
+				   r1.kNeighbors(XTest,indexes,distances);
+
+				   // indexes[row * 5 + 0] is the nearest observation of XTest[row]
+
+				   return 0;
+			   }
+
+
+		   */
+			void kNeighbors(const data::Storage& XTest, std::vector<std::size_t>& indexes, std::vector<double>& distances) const; // throws std::runtime_error
+
+		/**
+		   * Function Name :  load
+
+		   * Function Description :  Function to open a model written by save() without reading it. The file is mapped read only : the
+									  training set and labels are used where they lie in the mapping (nothing is parsed or copied, pages
+									  are read from disk when first touched) and processes loading the same file share one copy in the
+									  page cache. A saved index is read with one block copy per array instead of being built again.
+									  Metric, P and Algorithm are set to the saved ones. The loaded model is read only (insert() and erase() throw)
+
+		   * Parameters :
+
+		   1) filename :	The file written by save()
+
+						   Type Expected : std::string
+
+						   Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the file can not be mapped or was not written by save()
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KnnClassifier c1(5);
+
+				   c1.load("reference.knn");
+
+				   c1.predict(XTest,result);
+
+				   return 0;
+			   }
+
+
+		   */
+			void load(const std::string& filename); // throws std::runtime_error
+
+			/**
+			* Function Name :  model
+
+			* Function Description :  Function to built a Knn regression model using Feature Matrix X and vector of prediction y.
+									  If Quantization is set or Algorithm is IVF_PQ the training set is encoded and, unless Rerank is non zero, the
+									  full precision copy of X is not kept. The KD tree, ball tree, HNSW and LSH indexes hold the observations
+									  themselves, so X is not kept with them either (they are read back from the index when needed).
+									  If Algorithm is not BRUTE the search structure is built here.
+									  Any observation inserted or erased before is forgotten.
+
+			* Parameters :
+
+			1) X :			The feature matrix
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+			2) y :		    Vector of prediction
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+			* Return :		None
+
+
+			* Example
+
+				#include<vector>
+				#include<Neighbors/Knn.h>
+
+				int main()
+				{
+					// vector creation and element adding here
+
+					cmll::neighbors::KnnRegressor l1;
+
+					l1.model(X,y);
+
+					return 0;
+
+				}
+
+
+			*/
+			void model(const data::Storage& X, const data::Storage& y) noexcept;
+
+		/**
+		   * Function Name :  Partial Fit
+
+		   * Function Description :  Function to build the model from X and y the first time it is called (see model()) and to
+									  insert them afterwards (see insert()), so a training set can be fed in batches
+
+		   * Parameters :
+
+		   1) X :			The feature matrix of the batch
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) y :			Vector of prediction of the batch
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If X and y have different number of observations
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KnnRegressor r1(5);
+
+				   for (std::size_t batch = 0; batch < batches; ++batch)
+				   {
+					   r1.partialFit(X[batch],y[batch]);
+				   }
+
+				   return 0;
+			   }
+
+
+		   */
+			void partialFit(const data::Storage& X, const data::Storage& y); // throws std::runtime_error
+
+		/**
+		   * Function Name :  predict
+
+		   * Function Description :  Function to predict using Knn regression model built by model()
+
+		   * Parameters :
+
+		   1) XTest :		The test set feature matrix
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) result :		The predicted values
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the coefficient vector is empty
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   // vector creation and element adding here
+
+				   cmll::neighbors::KnnRegressor r1;
+
+				   l1.model(X,y);
+
+				   l1.predict(XTest,result);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void predict(const data::Storage& XTest, data::Storage& result); // throws std::runtime_error
+
+		/**
+		   * Function Name :  Radius Neighbors
+
+		   * Function Description :  Function to find, for each observation of XTest, every observation of X within distance radius of it
+									  (distance <= radius) instead of a fixed number K of them. The lists have different lengths, so they are
+									  returned one after the other in compressed sparse row form : the neighbors of XTest[row] are
+									  indexes[offsets[row] .. offsets[row + 1]) and distances[offsets[row] .. offsets[row + 1]), nearest first.
+									  Works with every search structure chosen by Algorithm. Exact with BRUTE, KD_TREE and BALL_TREE,
+									  as good as kNeighbors() with the approximate ones
+
+		   * Parameters :
+
+		   1) XTest :		The test set feature matrix
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) radius :		The radius
+
+						   Type Expected : double
+
+						   Method of passing :  constant and by reference
+
+		   3) offsets :		Where the neighbors of every observation of XTest start ( XTest observations + 1 )
+
+						   Type Expected : std::vector<std::size_t>
+
+						   Method of passing :  by reference
+
+		   4) indexes :		Rows of X of the neighbors, nearest first
+
+						   Type Expected : std::vector<std::size_t>
+
+						   Method of passing :  by reference
+
+		   5) distances :	Distances of the neighbors, in the same layout
+
+						   Type Expected : std::vector<double>
+
+						   Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the model is not built or radius is negative
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KnnRegressor r1;
+
+				   r1.Algorithm = cmll::neighbors::searchAlgorithm::BALL_TREE;
+				   r1.model(X,y);
+
+				   std::vector<std::size_t> offsets, indexes;
+				   std::vector<double> distances;
+
+				   r1.radiusNeighbors(XTest,0.5,offsets,indexes,distances);
+
+				   // Observations of X within 0.5 of XTest[row]
+				   for (std::size_t neighbor = offsets[row]; neighbor < offsets[row + 1]; ++neighbor)
+				   {
+					   auto observation = indexes[neighbor];
+				   }
+
+				   return 0;
+			   }
+
+
+		   */
+			void radiusNeighbors(const data::Storage& XTest, const double& radius, std::vector<std::size_t>& offsets, std::vector<std::size_t>& indexes, std::vector<double>& distances) const; // throws std::runtime_error
+
+		/**
+		   * Function Name :  recall
+
+		   * Function Description :  Function to measure how many of the true K nearest neighbors the search structure finds.
+									  The neighbors used by predict() are compared with the ones found by comparing XTest with every
+									  observation of X in full precision. Useful for tuning EfSearch of an approximate index
+
+		   * Parameters :
+
+		   1) XTest :		The test set feature matrix
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   * Return :		double - > fraction (0 to 1) of the true neighbors found
+
+		   * Throws    :  std::runtime_error : If the full precision training set is not kept (IVF_PQ or Quantization without Rerank)
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+			   #include<iostream>
+
+			   int main()
+			   {
+				   cmll::neighbors::KnnRegressor r1(5);
+
+				   r1.Algorithm = cmll::neighbors::searchAlgorithm::HNSW;
+
+				   r1.model(X,y);
+
+				   for (std::size_t ef : {16, 64, 256})
+				   {
+					   r1.EfSearch = ef;
+
+					   std::cout<<ef<<" : "<<r1.recall(XTest)<<'\n';
+				   }
+
+				   return 0;
+			   }
+
+
+		   */
+			double recall(const data::Storage& XTest); // throws std::runtime_error
+
+		/**
+		   * Function Name :  RSS
+
+		   * Function Description :  Function to calculate Residual Sum of Squares of the model
+
+		   * Parameters :
+
+		   1) yPred:		The predicted values by the model
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) y:	        The actual values
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+
+		   * Return :		Residual sum of squares calculated
+
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+			   #include<iostream>
+
+			   int main()
+			   {
+				   // vector creation and element adding here
+
+				   cmll::neighbors::KnnRegressor r1;
+				   
+				   l1.model(X,y);
+
+				   l1.predict(XTest,y_pred);
+
+				   std::cout<<l1.rss(yPred,y);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			double rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+
+		/**
+		   * Function Name :  save
+
+		   * Function Description :  Function to write the model to a binary file that load() maps. Every section (training set, labels,
+									  tombstones, index rows and index) starts on a 4096 byte boundary so it lies on its own pages.
+									  A running compaction is finished first and inserted observations are added to the index.
+									  The training set is written in full precision when it is kept
+
+		   * Parameters :
+
+		   1) filename :	The file to write
+
+						   Type Expected : std::string
+
+						   Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the model is not built, neither X nor an index is kept, or the file can not be written
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   // vector creation and element adding here
+
+				   cmll::neighbors::KnnClassifier c1(5);
+
+				   c1.Algorithm = cmll::neighbors::searchAlgorithm::HNSW;
+
+				   c1.model(X,y);
+
+				   c1.save("reference.knn");
+
+				   return 0;
+			   }
+
+
+		   */
+			void save(const std::string& filename); // throws std::runtime_error
+
+		/**
+		   * Function Name :  score
+
+		   * Function Description :  Function to calculate R^2 score of the Knn Regression model built
+
+		   * Parameters :
+
+		   1) yPred:		The predicted values by the model
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) y:	        The actual values
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+
+		   * Return :		R^2 score calculated
+
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+			   #include<iostream>
+
+			   int main()
+			   {
+				   // vector creation and element adding here
+
+				   cmll::neighbors::KnnRegressor r1;
+
+				   l1.model(X,y);
+
+				   auto yPred = l1.predict(XTest);
+
+				   std::cout<<l1.score(yPred,y);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			double score(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+
+		/**
+		  * Function Name :  TSS
+
+		  * Function Description :  Function to calculate Total Sum of Squares of the model
+
+		  * Parameters :
+
+		  1) y:	        The actual values
+
+						  Type Expected : cmll::data::Storage
+
+						  Method of passing :  constant and by reference
+
+
+		  * Return :		Total sum of squares calculated
+
+
+		  * Example
+
+			  #include<vector>
+			  #include<Neighbors/Knn.h>
+			  #include<iostream>
+
+			  int main()
+			  {
+				  // vector creation and element adding here
+
+				  cmll::neighbors::KnnRegressor r1;
+
+				  std::cout<<l1.tss(y);
+
+				  return 0;
+
+			  }
+
+
+		  */
+			double tss(const data::Storage& y) noexcept;
+
+		};
+		/**
+		* Class Name : KnnClassifier
+
+		* Class Description : Class containing functions required for building a Knn Classifier model
+
+		* Attributes :
+
+		1) K : - Neighbors to consider @inherited
+
+		2) Metric : The distance metric @inherited
+
+		3) P : Order @inherited
+
+		4) X : Feature Matrix @inherited
+
+		5) y : Vector of prediction @inherited
+
+		* Functions :
+
+		1) _bruteNeighbors @inherited
+
+		2) _createIndex @inherited
+
+		3) _fullPrecision @inherited
+
+		4) _kNeighbors @inherited
+
+		5) _label @inherited
+
+		6) _observation @inherited
+
+		7) _observations @inherited
+
+		8) _queryBlock @inherited
+
+		9) _radiusNeighbors @inherited
+
+		10) _rebuildIndex @inherited
+
+		11) _swapIndex @inherited
+
+		12) compact @inherited
+
+		13) erase @inherited
+
+		14) insert @inherited
+
+		15) kNeighbors @inherited
+
+		16) load @inherited
+
+		17) model @inherited
+
+		18) partialFit @inherited
+
+		19) predict @overriden
+
+		20) radiusNeighbors @inherited
+
+		21) recall @inherited
+
+		22) rss @protectedScoped
+
+		23) save @inherited
+
+		24) score @overriden
+
+		25) tss @protectedScoped
+
+		*
+		*/
+		class KnnClassifier : public KnnRegressor
+		{
+		protected:
+			
+			/*
+				In a classification setting, rss and tss are not required
+			*/
+
+			using KnnRegressor::rss;
+			using KnnRegressor::tss;
+
+		public:
+
+		/**
+		   * Constructor Name : KnnClassifierr[Parameterized]
+
+		   * Constructor Description :  Constructor to load values
+
+		   * Parameters :
+
+		   1) K				Number of nearest neighbors to consider
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+			
+			2) metric		Distance metric
+
+							Type expected distanceMetrix
+
+							Method of passing : const and by reference
+
+			3) p			The value p for order
+							
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+			   #include<iostream>
+
+			   int main()
+			   {
+
+				   cmll::neighbors::KnnClassifier r1(4,cmll::neighbors::distanceMetric::EUCLEDIAN);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			KnnClassifier(const std::size_t& k = static_cast<std::size_t>(defaults::K), const distanceMetric& metric = distanceMetric::EUCLEDIAN, const double& p = static_cast<double>(defaults::P));
+
+			
+		/**
+		   * Function Name :  predict
+
+		   * Function Description :  Function to predict using Knn classifier model built by model()
+
+		   * Parameters :
+
+		   1) XTest :		The test set feature matrix
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) result :		The predicted values
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the coefficient vector is empty
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   // vector creation and element adding here
+
+				   cmll::neighbors::KnnClassifier r1;
+
+				   l1.model(X,y);
+
+				   l1.predict(XTest,result);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void predict(const data::Storage& XTest, data::Storage& result); // throws std::runtime_error
+		
+		/**
+		   * Function Name :  score
+
+		   * Function Description :  Function to calculate Accuracy of  model built
+
+		   * Parameters :
+
+		   1) yPred:		The predicted values by the model
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   2) y:	        The actual values
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+
+		   * Return :		Accuracy calculated
+
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+			   #include<iostream>
+
+			   int main()
+			   {
+				   // vector creation and element adding here
+
+				   cmll::neighbors::KnnClassifier r1;
+
+				   l1.model(X,y);
+
+				   auto yPred = l1.predict(XTest);
+
+				   std::cout<<l1.score(yPred,y);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			double score(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
+		};
+
+	/**
+		* Class Name : K Means
+
+		* Class Description : Class containing functions required for implementing K Means Clustering.
+							  model() runs Lloyd's algorithm : every observation is assigned to its closest centroid, then every centroid
+							  moves to the mean of its observations, until the centroids stop moving (Tolerance) or MaximumIterations is reached.
+							  The assignment runs on Threads threads over fixed blocks of observations. Every block sums its observations
+							  per centroid on its own and the sums are added in block order, so the centroids found do not depend on the
+							  number of threads. With Restarts above 1, model() runs Lloyd's algorithm from several first centroids at the same
+							  time and keeps the run with the lowest Inertia.
+							  partialFit() learns from batches instead (mini-batch k-means), for training sets that do not fit in memory :
+							  every batch is assigned to the closest centroids and every centroid moves towards the mean of its observations
+							  of the batch by its own learning rate, the share of all its observations seen so far that the batch holds.
+
+		* Attributes :
+
+		1) K : - Number of clusters @inherited
+
+		2) Metric : The distance metric @inherited
+
+		3) P : Order @inherited
+
+		4) X : Feature Matrix @inherited
+
+		5) y : Vector of prediction @ProtectedScoped
+
+		6) Threads : Threads used for clustering and predicting (0 for all hardware threads) @inherited
+
+		7) MaximumIterations : Maximum number of centroid updates
+
+		8) Tolerance : Movement of the centroids, relative to the variance of X, below which they are considered converged
+
+		9) Iterations : Number of centroid updates done by the last model() (batches learned by partialFit())
+
+		10) Inertia : Sum of the reduced distances (squared distances for EUCLEDIAN) of the observations from their centroids
+					  (of the last batch before the update for partialFit())
+
+		11) Initialization : How the first centroids are chosen (cmll::neighbors::initialization)
+
+		12) Seed : Seed for choosing the first centroids
+
+		13) ClusteringAlgorithm : Lloyd's algorithm or one of its variants skipping distance calculations (cmll::neighbors::kMeansAlgorithm)
+
+		14) ReassignmentRatio : partialFit() moves the centroids that got fewer than this share of the observations of the largest cluster
+								to random observations of the batch (0 to never move them)
+
+		15) Restarts : Runs of Lloyd's algorithm from different first centroids by model(), the one with the lowest Inertia is kept (n_init)
+
+		16) Algorithm : Search structure predict() builds over the centroids (cmll::neighbors::searchAlgorithm) @inherited
+
+		* Functions :
+
+		1) _assign
+
+		2) _blocks
+
+		3) _boundedLloyd
+
+		4) _bruteNeighbors @inherited
+
+		5) _centroidSums
+
+		6) _centroidUpdate
+
+		7) _chooseCentroids
+
+		8) _closest
+
+		9) _cluster
+
+		10) _indexCentroids
+
+		11) _initializeCentroids
+
+		12) _kMeansParallel
+
+		13) _kMeansPlusPlus
+
+		14) _kNeighbors @inherited
+
+		15) _lloyd
+
+		16) _norms
+
+		17) _sortCentroids
+
+		18) erase @protectedScoped
+
+		19) insert @protectedScoped
+
+		20) kNeighbors @inherited
+
+		21) load @protectedScoped
+
+		22) memoryUsage
+
+		23) model @overriden
+
+		24) partialFit
+
+		25) predict @overriden
+
+		26) radiusNeighbors @inherited
+
+		27) rss @protectedScoped
+
+		28) save @protectedScoped
+
+		29) score @inherited
+
+		30) tss @protectedScoped
+
+		*
+		*/
+		class KMeans : public KnnClassifier
+		{
+		protected:
+			/*
+				Vector of prediction is not required in an unsupervised learning setting
+			*/
+			using KnnClassifier::y;
+
+			/*
+				Neither is updating the training set observation by observation
+			*/
+			using KnnClassifier::erase;
+			using KnnClassifier::insert;
+			using KnnClassifier::load;
+			using KnnClassifier::save;
+
+			// Observations every centroid was learned from, for the learning rates of partialFit()
+			std::vector<double> _weights;
+
+			// Observations learned by partialFit() since centroids were last reassigned
+			std::size_t _sinceReassignment;
+
+			// Generator for the first centroids and the reassignments
+			std::mt19937 _generator;
+
+			// What predict() searches : the centroids sorted by norm with their norms and numbers (BRUTE), or a search structure over them
+			std::vector<double> _sortedCentroids, _sortedNorms;
+			std::vector<std::size_t> _order;
+			std::shared_ptr<Index> _centroidIndex;
+
+		/**
+		   * Function Name :  assign
+
+		   * Function Description :  Function to find the closest centroid of every observation of X (Lloyd's assignment step).
+									  Threads take blocks of contiguous observations of X (see _blocks()) one after the other.
+									  With the norms of the observations, an observation is first compared with the centroid it had in labels,
+									  then only with the centroids whose norm is within the closest distance found of its own norm, since no
+									  other centroid can be closer. The labels and the inertia are the same as without norms
+
+		   * Parameters :
+
+		   1) X :				    The observations
+
+									Type Expected : cmll::data::Storage
+
+									Method of passing : const and by reference
+
+		   2) norms :			    The norm of every observation (see _norms(), empty to compare every centroid)
+
+									Type Expected : std::vector<double>
+
+									Method of passing : const and by reference
+
+		   3) centroids :		    The centroids ( K X features, row wise )
+
+									Type Expected : std::vector<double>
+
+									Method of passing : const and by reference
+
+		   4) labels :			    The closest centroid of every observation (on input, the previous ones if known)
+
+									Type Expected : std::vector<std::uint32_t>
+
+									Method of passing : By reference
+
+		   5) threads :		    Threads to use
+
+									Type Expected : std::size_t
+
+									Method of passing : const and by reference
+
+		   * Return :	   double - > the inertia (sum of the reduced distances of the observations from their centroids)
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			double _assign(const data::Storage& X, const std::vector<double>& norms, const std::vector<double>& centroids, std::vector<std::uint32_t>& labels, const std::size_t& threads) const;
+
+		/**
+		   * Function Name :  blocks
+
+		   * Function Description :  Function to get the number of blocks of contiguous observations the parallel loops over X work on.
+									  Blocks hold at least 1024 observations and there are at most 256 of them, few enough that
+									  values numbers per block take at most 2^24 numbers. The blocks depend on neither the data nor the
+									  number of threads, so the sums over them are always added in the same order
+
+		   * Parameters :
+
+		   1) rows :			    Number of observations
+
+									Type Expected : std::size_t
+
+									Method of passing : const and by reference
+
+		   2) values :			    Numbers every block keeps (0 if none)
+
+									Type Expected : std::size_t
+
+									Method of passing : const and by reference
+
+		   * Return :	   std::size_t - > the number of blocks (at least 1)
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			std::size_t _blocks(const std::size_t& rows, const std::size_t& values) const noexcept;
+
+		/**
+		   * Function Name :  Bounded Lloyd
+
+		   * Function Description :  Function to run Lloyd's algorithm with the triangle inequality (ELKAN or HAMERLY, see ClusteringAlgorithm).
+									  Every observation keeps an upper bound of its distance from its centroid and lower bounds of its distances
+									  from the other centroids (HAMERLY : one for the closest of them), loosened by how far the centroids move.
+									  An observation is only compared with the centroids its bounds can not rule out, so after the first
+									  iterations most distances are never calculated. The centroids found are the ones of Lloyd's algorithm.
+									  Not used for MINKOWSKI with P below 1 (see _lloyd())
+
+		   * Parameters :
+
+		   1) X :				    The observations
+
+									Type Expected : cmll::data::Storage
+
+									Method of passing : const and by reference
+
+		   2) threshold :		    Sum of the squared movements of the centroids at which they are converged
+
+									Type Expected : double
+
+									Method of passing : const and by reference
+
+		   3) centroids :		    The first centroids, replaced by the final ones ( K X features, row wise )
+
+									Type Expected : std::vector<double>
+
+									Method of passing : By reference
+
+		   4) labels :			    The closest centroid of every observation
+
+									Type Expected : std::vector<std::uint32_t>
+
+									Method of passing : By reference
+
+		   5) threads :		    Threads to use
+
+									Type Expected : std::size_t
+
+									Method of passing : const and by reference
+
+		   * Return :	   std::size_t - > the number of centroid updates
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			std::size_t _boundedLloyd(const data::Storage& X, const double& threshold, std::vector<double>& centroids, std::vector<std::uint32_t>& labels, const std::size_t& threads) const;
+
+		/**
+		   * Function Name :  Centroid Sums
+
+		   * Function Description :  Function to add up the observations assigned to every centroid. Every block of X (see _blocks())
+									  adds its observations to its own sums on one thread and the sums of the blocks are then added in block order,
+									  so the result does not depend on the number of threads
+
+		   * Parameters :
+
+		   1) X :				    The observations
+
+									Type Expected : cmll::data::Storage
+
+									Method of passing : const and by reference
+
+		   2) labels :			    The centroid of every observation
+
+									Type Expected : std::vector<std::uint32_t>
+
+									Method of passing : const and by reference
+
+		   3) sums :			    Sum of the observations of every centroid ( K X features, row wise )
+
+									Type Expected : std::vector<double>
+
+									Method of passing : By reference
+
+		   4) counts :			    Number of observations of every centroid
+
+									Type Expected : std::vector<std::size_t>
+
+									Method of passing : By reference
+
+		   5) threads :		    Threads to use
+
+									Type Expected : std::size_t
+
+									Method of passing : const and by reference
+
+		   * Return :	   None
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			void _centroidSums(const data::Storage& X, const std::vector<std::uint32_t>& labels, std::vector<double>& sums, std::vector<std::size_t>& counts, const std::size_t& threads) const;
+
+		/**
+		   * Function Name :  Centroid update
+
+		   * Function Description :  Function to move every centroid to the mean of the observations assigned to it (Lloyd's update step).
+									  A centroid no observation is assigned to stays where it is
+
+		   * Parameters :
+
+		   1) sums :			    Sum of the observations assigned to every centroid ( K X features, row wise )
+
+								    Type Expected : std::vector<double>
+
+									Method of passing : const and by reference
+
+		   2) counts :			    Number of observations assigned to every centroid
+
+									Type Expected : std::vector<std::size_t>
+
+									Method of passing : const and By reference
+
+		   3) centroids :		    The centroids to move ( K X features, row wise )
+
+									Type Expected : std::vector<double>
+
+									Method of passing : By reference
+
+		   * Return :	   double - > sum of the squared movements of the centroids
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			double _centroidUpdate(const std::vector<double>& sums, const std::vector<std::size_t>& counts, std::vector<double>& centroids) const noexcept;
+
+		/**
+		   * Function Name :  Choose Centroids
+
+		   * Function Description :  Function to choose K first centroids as set by Initialization
+
+		   * Parameters :
+
+		   1) X :				    The observations
+
+									Type Expected : cmll::data::Storage
+
+									Method of passing : const and by reference
+
+		   2) seed :			    Seed of the random choices
+
+									Type Expected : unsigned int
+
+									Method of passing : const and by reference
+
+		   3) threads :		    Threads to use
+
+									Type Expected : std::size_t
+
+									Method of passing : const and by reference
+
+		   * Return :	   cmll::data::Storage - > K centroids (fewer if X has fewer observations)
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			data::Storage _chooseCentroids(const data::Storage& X, const unsigned int& seed, const std::size_t& threads) const;
+
+		/**
+		   * Function Name :  closest
+
+		   * Function Description :  Function to find the closest centroid of an observation from the centroids sorted by norm (see _sortCentroids()).
+									  The observation is compared with the centroid at start first, then only with the centroids whose norm
+									  is within the closest distance found of its own norm, since no other centroid can be closer.
+									  Ties go to the smaller centroid, as when every centroid is compared
+
+		   * Parameters :
+
+		   1) x :				    Pointer to the observation
+
+									Type Expected : const double*
+
+									Method of passing : value
+
+		   2) norm :			    The norm of the observation (see _norms())
+
+									Type Expected : double
+
+									Method of passing : const and by reference
+
+		   3) start :			    Position (in the order of the norms) of the first centroid to compare with, the closer to the answer the better
+
+									Type Expected : std::size_t
+
+									Method of passing : const and by reference
+
+		   4) sortedCentroids :	    The centroids in the order of their norms ( K X features, row wise )
+
+									Type Expected : std::vector<double>
+
+									Method of passing : const and by reference
+
+		   5) sortedNorms :		    The norms of the centroids in increasing order
+
+									Type Expected : std::vector<double>
+
+									Method of passing : const and by reference
+
+		   6) order :			    The centroid at every position
+
+									Type Expected : std::vector<std::size_t>
+
+									Method of passing : const and by reference
+
+		   7) distance :		    The reduced distance of the observation from the closest centroid
+
+									Type Expected : double
+
+									Method of passing : By reference
+
+		   * Return :	   std::size_t - > the closest centroid
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			std::size_t _closest(const double* x, const double& norm, const std::size_t& start, const std::vector<double>& sortedCentroids, const std::vector<double>& sortedNorms, const std::vector<std::size_t>& order, double& distance) const noexcept;
+
+		/**
+		   * Function Name :  cluster
+
+		   * Function Description :  Function to assign a set ob observations to different clusters. Lloyd's algorithm is run on the
+									  observations starting from the current centroids (see model()), and from restarts - 1 other choices of
+									  centroids at the same time, keeping the run with the lowest inertia. The centroids found are indexed for predict()
+
+		   * Parameters :
+
+		   1) X :				    The new set of observations
+
+									Type Expected : cmll::data::Storage
+
+									Method of passing : const and by reference
+
+		   2) restarts :		    Number of runs of Lloyd's algorithm
+
+									Type Expected : std::size_t
+
+									Method of passing : const and By reference
+
+		   * Return :	   None
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			void _cluster(const data::Storage& X, const std::size_t& restarts = 1);
+
+		/**
+		   * Function Name :  index centroids
+
+		   * Function Description :  Function to prepare predict() for the current centroids : with BRUTE the centroids are sorted by norm
+									  (see _sortCentroids()), otherwise the search structure chosen by Algorithm is built over them.
+									  Called whenever the centroids change
+
+		   * Return :	   None
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			void _indexCentroids();
+
+		/**
+			   * Function Name :  initializeCentroids
+
+			   * Function Description :  Function to initialize initial centroids
+
+			   * Parameters :
+
+			   1) centroidValues :		The centroid values to set as initial
+
+										Type Expected : cmll::data::Storage
+
+										Method of passing : const and by reference
+
+			   * Return :	   None
+
+
+			   * Example
+
+				This function is internal and protected
+
+
+			*/
+			void _initializeCentroids(const data::Storage& centroidValues);
+
+		/**
+			   * Function Name :  K Means Parallel
+
+			   * Function Description :  Function to choose K first centroids with k-means|| (scalable k-means++).
+										  After a first observation picked at random, 5 rounds pick every observation independently with probability
+										  2K x distance / (sum of the distances), the distance being the reduced distance from the closest observation
+										  picked so far. Only 6 passes over X are needed instead of K. Every candidate is weighted by the observations
+										  closest to it, K of them are chosen with the weighted k-means++ and refined by weighted Lloyd's iterations.
+										  Every block of X draws from its own generator seeded from seed, the round and the block,
+										  so the result does not depend on the number of threads
+
+			   * Parameters :
+
+			   1) X :				    The observations
+
+										Type Expected : cmll::data::Storage
+
+										Method of passing : const and by reference
+
+			   2) seed :			    Seed of the generators of the blocks
 
-		   * Throws    :  std::runtime_error : If the coefficient vector is empty
+										Type Expected : unsigned int
 
-		   * Example
+										Method of passing : const and by reference
 
-			   #include<vector>
-			   #include<Neighbors/Knn.h>
+			   3) generator :		    The random number generator
 
-			   int main()
-			   {
-				   // vector creation and element adding here
+										Type Expected : std::mt19937
 
-				   cmll::neighbors::KnnClassifier r1;
+										Method of passing : By reference
 
-				   l1.model(X,y);
+			   4) threads :			    Threads to use
 
-				   l1.predict(XTest,result);
+										Type Expected : std::size_t
 
-				   return 0;
+										Method of passing : const and by reference
 
-			   }
+			   * Return :	   cmll::data::Storage - > K centroids
 
 
-		   */
-			void predict(const data::Storage& XTest, data::Storage& result); // throws std::runtime_error
-		
-		/**
-		   * Function Name :  score
+			   * Example
 
-		   * Function Description :  Function to calculate Accuracy of  model built
+				This function is internal and protected
 
-		   * Parameters :
 
-		   1) yPred:		The predicted values by the model
+			*/
+			data::Storage _kMeansParallel(const data::Storage& X, const unsigned int& seed, std::mt19937& generator, const std::size_t& threads) const;
 
-						   Type Expected : cmll::data::Storage
+		/**
+			   * Function Name :  K Means Plus Plus
 
-						   Method of passing :  constant and by reference
+			   * Function Description :  Function to choose K first centroids with k-means++. The first is an observation picked at random,
+										  every next one is picked with probability proportional to weight x (reduced) distance from the closest
+										  centroid picked so far (D² sampling for EUCLEDIAN). The closest distances are updated in parallel over
+										  blocks of X after every pick and an observation is found from the totals of the blocks, so a pick costs
+										  one pass over X
 
-		   2) y:	        The actual values
+			   * Parameters :
 
-						   Type Expected : cmll::data::Storage
+			   1) X :				    The observations
 
-						   Method of passing :  constant and by reference
+										Type Expected : cmll::data::Storage
 
+										Method of passing : const and by reference
 
-		   * Return :		Accuracy calculated
+			   2) weights :			    Weight of every observation (empty for 1 each)
 
+										Type Expected : std::vector<double>
 
-		   * Example
+										Method of passing : const and by reference
 
-			   #include<vector>
-			   #include<Neighbors/Knn.h>
-			   #include<iostream>
+			   3) generator :		    The random number generator
 
-			   int main()
-			   {
-				   // vector creation and element adding here
+										Type Expected : std::mt19937
 
-				   cmll::neighbors::KnnClassifier r1;
+										Method of passing : By reference
 
-				   l1.model(X,y);
+			   4) threads :			    Threads to use
 
-				   auto yPred = l1.predict(XTest);
+										Type Expected : std::size_t
 
-				   std::cout<<l1.score(yPred,y);
+										Method of passing : const and by reference
 
-				   return 0;
+			   * Return :	   cmll::data::Storage - > K centroids (fewer if X has fewer observations)
 
-			   }
 
+			   * Example
 
-		   */
-			double score(const data::Storage& y_pred, const data::Storage& y_true) noexcept;
-		};
+				This function is internal and protected
 
-	/**
-		* Class Name : K Means
 
-		* Class Description : Class containing functions required for implementing K Means Clustering
+			*/
+			data::Storage _kMeansPlusPlus(const data::Storage& X, const std::vector<double>& weights, std::mt19937& generator, const std::size_t& threads) const;
 
-		* Attributes :
+		/**
+		   * Function Name :  Lloyd
 
-		1) K : - Neighbors to consider @inherited
+		   * Function Description :  Function to run Lloyd's algorithm (or the variant set by ClusteringAlgorithm) from the given centroids.
+									  Only reads the members, so several runs can go on at the same time on the same X and norms
 
-		2) Metric : The distance metric @inherited
+		   * Parameters :
 
-		3) P : Order @inherited
+		   1) X :				    The observations
 
-		4) X : Feature Matrix @inherited
+									Type Expected : cmll::data::Storage
 
-		5) y : Vector of prediction @ProtectedScoped
+									Method of passing : const and by reference
 
-		* Functions :
+		   2) norms :			    The norm of every observation (see _norms())
 
-		1) _calculateDistances @inherited
+									Type Expected : std::vector<double>
 
-		2) _centroidUpdate
+									Method of passing : const and by reference
 
-		3) _cluster
+		   3) threshold :		    Sum of the squared movements of the centroids at which they are converged
 
-		4) _distancesFromX @inherited
+									Type Expected : double
 
-		5) _initializeCentroids
+									Method of passing : const and by reference
 
-		6) _neighborKSort @inherited
+		   4) centroids :		    The first centroids, replaced by the final ones ( K X features, row wise )
 
-		7) model @overriden
+									Type Expected : std::vector<double>
 
-		8) predict @overriden
+									Method of passing : By reference
 
-		9) rss @protectedScoped
+		   5) labels :			    The closest centroid of every observation
 
-		10) score @inherited
+									Type Expected : std::vector<std::uint32_t>
 
-		11) tss @protectedScoped
+									Method of passing : By reference
 
-		*
-		*/
-		class KMeans : public KnnClassifier
-		{
-		protected:
-			/*
-				Vector of prediction is not required in an unsupervised learning setting
-			*/
-			using KnnClassifier::y;
-			
-		/**
-		   * Function Name :  Centroid update
+		   6) iterations :		    Number of centroid updates done
 
-		   * Function Description :  Function to update the centroids after new assignment of cluster
+									Type Expected : std::size_t
 
-		   * Parameters :
+									Method of passing : By reference
 
-		   1) x :				    The new set of points
+		   7) threads :			    Threads to use
 
-								    Type Expected : std::vector<double>
+									Type Expected : std::size_t
 
 									Method of passing : const and by reference
 
-		   2) centroidIndex :	    The index of the Centroid to update
+		   8) giveUp :			    Called with the iteration and the inertia before every update of LLOYD, the run stops if it returns true
+									(empty to never stop)
 
-									Type Expected : std::ptrdiff_t
+									Type Expected : std::function<bool(std::size_t, double)>
 
-									Method of passing : const and By reference
+									Method of passing : const and by reference
 
-		   * Return :	   None
+		   * Return :	   double - > the inertia of the final centroids (infinity if the run gave up)
 
 
 		   * Example
@@ -731,28 +2213,29 @@ namespace cmll
 
 
 		*/
-			void _centroidUpdate(const std::vector<double>& x, const std::ptrdiff_t& centroidIndex);
+			double _lloyd(const data::Storage& X, const std::vector<double>& norms, const double& threshold, std::vector<double>& centroids, std::vector<std::uint32_t>& labels, std::size_t& iterations, const std::size_t& threads, const std::function<bool(std::size_t, double)>& giveUp) const;
 
 		/**
-		   * Function Name :  cluster
+		   * Function Name :  norms
 
-		   * Function Description :  Function to assign a set ob observations to different clusters
+		   * Function Description :  Function to find the norm of every observation (its distance from the origin in the metric), so that
+									  |norm(x) - norm(c)| is a lower bound of the distance between x and c (see _assign())
 
 		   * Parameters :
 
-		   1) X :				    The new set of observations
+		   1) X :				    The observations
 
 									Type Expected : cmll::data::Storage
 
 									Method of passing : const and by reference
 
-		   2) updateCentroids :	    if the new assignment of cluster should update the centroids (yes during model building process)
+		   2) threads :		    Threads to use
 
-									Type Expected : cmll::neighbors::selection
+									Type Expected : std::size_t
 
-									Method of passing : const and By reference
+									Method of passing : const and by reference
 
-		   * Return :	   None
+		   * Return :	   std::vector<double> - > the norms (empty for MINKOWSKI with P below 1, which is not a norm)
 
 
 		   * Example
@@ -761,31 +2244,49 @@ namespace cmll
 
 
 		*/
-			void _cluster(const data::Storage&,const selection& updateCentroids);
+			std::vector<double> _norms(const data::Storage& X, const std::size_t& threads) const;
 
 		/**
-			   * Function Name :  initializeCentroids
+		   * Function Name :  sort centroids
 
-			   * Function Description :  Function to initialize initial centroids
+		   * Function Description :  Function to copy the centroids in the order of their norms (see _closest())
 
-			   * Parameters :
+		   * Parameters :
 
-			   1) centroidValues :		The centroid values to set as initial
+		   1) centroids :		    The centroids ( K X features, row wise )
 
-										Type Expected : cmll::data::Storage
+									Type Expected : std::vector<double>
 
-										Method of passing : const and by reference
+									Method of passing : const and by reference
 
-			   * Return :	   None
+		   2) sortedCentroids :	    The centroids in the order of their norms
 
+									Type Expected : std::vector<double>
 
-			   * Example
+									Method of passing : By reference
 
-				This function is internal and protected
+		   3) sortedNorms :		    The norms of the centroids in increasing order
 
+									Type Expected : std::vector<double>
 
-			*/
-			void _initializeCentroids(const data::Storage& centroidValues);
+									Method of passing : By reference
+
+		   4) order :			    The centroid at every position
+
+									Type Expected : std::vector<std::size_t>
+
+									Method of passing : By reference
+
+		   * Return :	   None
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			void _sortCentroids(const std::vector<double>& centroids, std::vector<double>& sortedCentroids, std::vector<double>& sortedNorms, std::vector<std::size_t>& order) const;
 			
 			
 		public:
@@ -796,8 +2297,17 @@ namespace cmll
 			// Clusters the observations are assigned to
 			data::Storage CentroidsAssigned;
 
-			// Clusters the observations of XTest (in predict()) are assigned to
-			std::vector<double> Prediction;
+			std::size_t MaximumIterations;
+			double Tolerance;
+			initialization Initialization;
+			unsigned int Seed;
+			kMeansAlgorithm ClusteringAlgorithm;
+			double ReassignmentRatio;
+			std::size_t Restarts;
+
+			// Results of the last model()
+			std::size_t Iterations;
+			double Inertia;
 
 
 		/**
@@ -825,6 +2335,18 @@ namespace cmll
 
 							Method of passing :  constant and by reference
 
+			4) init			How the first centroids are chosen
+
+							Type Expected : cmll::neighbors::initialization
+
+							Method of passing :  constant and by reference
+
+			5) seed			Seed for choosing the first centroids
+
+							Type Expected : unsigned int
+
+							Method of passing :  constant and by reference
+
 
 
 		   * Example
@@ -838,18 +2360,74 @@ namespace cmll
 
 				   cmll::neighbors::KMeans r1(4,cmll::neighbors::distanceMetric::EUCLEDIAN);
 
+				   // k-means|| seeding for a large training set, reproducible through the seed
+				   cmll::neighbors::KMeans r2(100,cmll::neighbors::distanceMetric::EUCLEDIAN,2,cmll::neighbors::initialization::K_MEANS_PARALLEL,42);
+
 				   return 0;
 
 			   }
 
 
 		   */
-			KMeans(const std::size_t& k = static_cast<std::size_t>(defaults::K), const distanceMetric& metric = distanceMetric::EUCLEDIAN, const double& p = static_cast<double>(defaults::P));
+			KMeans(const std::size_t& k = static_cast<std::size_t>(defaults::K), const distanceMetric& metric = distanceMetric::EUCLEDIAN, const double& p = static_cast<double>(defaults::P), const initialization& init = initialization::K_MEANS_PLUS_PLUS, const unsigned int& seed = 0);
+
+		/**
+		   * Function Name :  Memory Usage
+
+		   * Function Description :  Function to estimate the bytes model() needs besides X for a training set of rows observations
+									  with cols features, with the current K and ClusteringAlgorithm. ELKAN grows with rows X K, check it
+									  before choosing ELKAN for large training sets
+
+		   * Parameters :
+
+		   1) rows :			Number of observations
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   2) cols :			Number of features
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+		   * Return :		std::size_t - > bytes needed
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KMeans r1(1000);
+
+				   r1.ClusteringAlgorithm = cmll::neighbors::kMeansAlgorithm::ELKAN;
+
+				   if (r1.memoryUsage(X.size(), X[0].size()) > budget) r1.ClusteringAlgorithm = cmll::neighbors::kMeansAlgorithm::HAMERLY;
+
+				   r1.model(X);
+
+				   return 0;
+			   }
+
+
+		   */
+			std::size_t memoryUsage(const std::size_t& rows, const std::size_t& cols) const noexcept;
 
 		/**
 			* Function Name :  model
 
-			* Function Description :  Function to built clusters and assign the data points to K clusters
+			* Function Description :  Function to built clusters and assign the data points to K clusters with Lloyd's algorithm.
+									  The centroids are moved until the sum of their squared movements in an iteration is at most Tolerance
+									  times the mean variance of the features of X, or MaximumIterations times. Iterations and Inertia
+									  hold how many iterations were run and how tight the clusters found are.
+									  The first centroids are chosen as set by Initialization. With Restarts above 1 (and random first centroids)
+									  that many runs go on at the same time, sharing X and the norms of its observations, and the one with
+									  the lowest Inertia is kept (the first run of equal ones). A LLOYD run gives up once a run with a lower index
+									  finished in as many iterations or fewer and is still better, which saves most of the work of the losing runs.
+									  Runs only compare with lower runs they have waited for, so the result does not depend on timing
 
 			* Parameters :
 
@@ -869,6 +2447,8 @@ namespace cmll
 
 			* Return :		None
 
+			* Throws    :  std::runtime_error : If X has less than K observations
+
 
 			* Example
 
@@ -891,10 +2471,145 @@ namespace cmll
 			*/
 			void model(const data::Storage& X,const selection& resetCentroids = selection::YES);
 
+		/**
+		   * Function Name :  Partial Fit
+
+		   * Function Description :  Function to learn from a batch of observations (mini-batch k-means).
+									  The first batch chooses the first centroids as set by Initialization and needs at least K observations.
+									  Every observation of the batch is assigned to its closest centroid and every centroid becomes
+									  (weight x centroid + sum of its observations) / (weight + number of its observations), the weight
+									  being the number of observations it was learned from, so each centroid has its own learning rate that
+									  decays as it sees more observations. Centroids that fall behind (see ReassignmentRatio) restart at
+									  random observations of the batch, at most once every 10 x K observations.
+									  Can continue from model() and memory does not grow with the number of batches
+
+		   * Parameters :
+
+		   1) batch :			The observations of the batch
+
+								Type Expected : cmll::data::Storage
+
+								Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KMeans r1(100);
+
+				   for (std::size_t batch = 0; batch < batches; ++batch)
+				   {
+					   r1.partialFit(X[batch]);
+				   }
+
+				   r1.predict(XTest,result);
+
+				   return 0;
+			   }
+
+
+		   */
+			void partialFit(const data::Storage& batch);
+
+		/**
+		   * Function Name :  Partial Fit
+
+		   * Function Description :  Function to learn from every remaining batch of a reader (see partialFit() of a batch).
+									  The next batch is read and parsed on its own thread while the current one is learned from,
+									  so only two batches are held in memory and clustering keeps up with reading
+
+		   * Parameters :
+
+		   1) reader :			The reader of the observations
+
+								Type Expected : cmll::data::BatchReader
+
+								Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the reader finds a row that is not numeric or of the wrong size
+
+		   * Example
+
+			   #include<Data/BatchReader.h>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::data::BatchReader reader("Clicks.csv", 100000);
+
+				   cmll::neighbors::KMeans r1(100);
+
+				   r1.partialFit(reader);
+
+				   return 0;
+			   }
+
+
+		   */
+			void partialFit(data::BatchReader& reader); // throws std::runtime_error
+
+		/**
+		   * Function Name :  predict
+
+		   * Function Description :  Function to assign every observation of XTest to its closest centroid, written to its row of result.
+									  Threads take blocks of observations and only read the model, so several threads may call it at the same time.
+									  With BRUTE an observation is only compared with the centroids whose norm is close to its own, otherwise
+									  the search structure chosen by Algorithm and built over the centroids is searched
+									  (KD_TREE or BALL_TREE for few features and large K, exact. HNSW, IVF_PQ and LSH are approximate).
+									  Centroids changed by hand are used once model() is run
+
+		   * Parameters :
+
+		   1) XTest :			The test set feature matrix
+
+								Type Expected : cmll::data::Storage
+
+								Method of passing :  constant and by reference
+
+		   2) result :			The centroid of every observation (resized to the observations of XTest)
+
+								Type Expected : cmll::data::Storage
+
+								Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Throws    :  std::runtime_error : If the Centroid vectors are empty
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Knn.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::KMeans r1(10000);
+
+				   r1.Algorithm = cmll::neighbors::searchAlgorithm::KD_TREE;
+
+				   r1.model(X);
+
+				   r1.predict(XTest,result);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void predict(const data::Storage& XTest, data::Storage& result) const;
+
 		/**
 		   * Function Name :  predict
 
-		   * Function Description :  Function to assign clusters to new observations
+		   * Function Description :  Function to assign clusters to new observations, running Lloyd's algorithm on them first if asked
 
 		   * Parameters :
 
@@ -941,7 +2656,7 @@ namespace cmll
 
 
 		   */
-			void predict(const data::Storage& XTest, data::Storage& result, const selection& updateCentroid = selection::NO);
+			void predict(const data::Storage& XTest, data::Storage& result, const selection& updateCentroid);
 		};
 	}
 }
\ No newline at end of file
@@ -0,0 +1,261 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <queue>
+#include <random>
+#include <stdexcept>
+
+#include "../utils/Defines.h"
+#include "../utils/Parallel.h"
+#include "Index.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+	/**
+		* Class Name : Lsh
+
+		* Class Description : Locality sensitive hashing with p-stable random projections (approximate nearest neighbors).
+							  Every table hashes an observation to floor((a . x + b) / Width) for HashFunctions random directions a,
+							  drawn from the gaussian distribution for EUCLEDIAN (and MINKOWSKI) and from the cauchy distribution for MANHATTAN,
+							  so close observations are likely to share a bucket. The buckets of a table are stored in two contiguous
+							  arrays (bucket offsets and observation indexes) filled by counting, without sorting.
+							  The index is built in a single pass over the training set.
+							  A query reads its own bucket in every table plus Probes neighboring buckets, the ones its projections are
+							  closest to (multi-probe), and compares the observations found. More probes give better recall, slower queries.
+
+		* Attributes :
+
+		1) Tables : Number of hash tables
+
+		2) HashFunctions : Projections combined into the bucket of a table
+
+		3) Width : Bucket width of a projection (0 to estimate it from the training set)
+
+		4) Probes : Extra buckets read per table (used when query() gets no effort)
+
+		5) Threads : Threads used for building (0 for all hardware threads)
+
+		6) Seed : Seed for the projections
+
+		* Functions :
+
+		1) _bucket @protected
+
+		2) _project @protected
+
+		3) build @overriden
+
+		4) holdsObservations @overriden
+
+		5) load @overriden
+
+		6) observation @overriden
+
+		7) query @overriden
+
+		8) radius @inherited
+
+		9) save @overriden
+
+		10) size @overriden
+
+		*
+		*/
+		class Lsh : public Index
+		{
+		protected:
+
+			// Observations in training set order ( observations X features )
+			Values<double> _points;
+
+			// Projections ( tables X hash functions X features ) and their offsets ( tables X hash functions )
+			std::vector<double> _directions, _shifts;
+
+			// For every table, observations of bucket b are _ids[table][_offsets[table][b] .. _offsets[table][b + 1])
+			std::vector<std::vector<std::uint32_t>> _offsets, _ids;
+
+			std::size_t _buckets;
+			std::size_t _rows;
+			double _width;
+
+		/**
+		   * Function Name :  bucket (internal)
+
+		   * Function Description :  Function to combine the hashes of one table into a bucket
+
+		   * Parameters :
+
+		   1) hashes :		Pointer to the HashFunctions hashes
+
+							Type Expected : const std::int64_t*
+
+							Method of passing :  value
+
+		   * Return :		std::size_t - > the bucket
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			std::size_t _bucket(const std::int64_t* hashes) const noexcept;
+
+		/**
+		   * Function Name :  project (internal)
+
+		   * Function Description :  Function to calculate (a . x + b) / Width for every hash function of a table
+
+		   * Parameters :
+
+		   1) x :			Pointer to the observation
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+		   2) table :		The table
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   3) projections :	Pointer to the HashFunctions values to write
+
+							Type Expected : double*
+
+							Method of passing :  value
+
+		   * Return :		None
+
+		   * Example
+
+			This function is internal and protected
+
+		*/
+			void _project(const double* x, const std::size_t& table, double* projections) const noexcept;
+
+		public:
+
+			std::size_t Tables;
+			std::size_t HashFunctions;
+			double Width;
+			std::size_t Probes;
+			std::size_t Threads;
+			unsigned int Seed;
+
+		/**
+		   * Constructor Name : Lsh[Parameterized]
+
+		   * Constructor Description :  Constructor to load the parameters of the index
+
+		   * Parameters :
+
+		   1) tables		Number of hash tables
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   2) hashFunctions	Projections combined into the bucket of a table
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   3) probes		Extra buckets read per table
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   4) width			Bucket width of a projection (0 to estimate it from the training set)
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+		   5) threads		Threads used for building (0 for all hardware threads)
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   6) seed			Seed for the projections
+
+							Type Expected : unsigned int
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Lsh.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::Lsh index(10, 6, 16);
+
+				   index.build(X,cmll::neighbors::distanceMetric::MANHATTAN,1);
+
+				   index.query(x,5,neighbors);
+
+				   return 0;
+			   }
+
+		   */
+			Lsh(const std::size_t& tables = static_cast<std::size_t>(defaults::TABLES), const std::size_t& hashFunctions = static_cast<std::size_t>(defaults::HASH_FUNCTIONS), const std::size_t& probes = static_cast<std::size_t>(defaults::PROBES), const double& width = 0, const std::size_t& threads = 0, const unsigned int& seed = 0);
+
+			void build(const data::Storage& X, const distanceMetric& metric, const double& p) override;
+
+			bool holdsObservations() const noexcept override;
+
+			void load(std::istream& in) override; // throws std::runtime_error
+
+			const double* observation(const std::size_t& id) const noexcept override;
+
+			void query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort = 0) const override;
+
+			void save(std::ostream& out) const override;
+
+			std::size_t size() const noexcept override;
+		};
+	}
+}
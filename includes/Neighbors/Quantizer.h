@@ -0,0 +1,508 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "../utils/Defines.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+	/**
+		* Class Name : ScalarQuantizer
+
+		* Class Description : Class containing functions required for storing a feature matrix in reduced precision
+							  Every value is stored either as a half precision float or as an 8 bit integer with a per feature scale and offset.
+							  The codes of all the observations are kept in one contiguous block (row major).
+
+		* Attributes :
+
+		1) Type : The precision the observations are stored in
+
+		* Functions :
+
+		1) _fromHalf @protected
+
+		2) _halves @protected
+
+		3) _toHalf @protected
+
+		4) append
+
+		5) clear
+
+		6) decode
+
+		7) distance
+
+		8) fit
+
+		9) memoryUsage
+
+		10) prepare
+
+		11) rows
+
+		*
+		*/
+		class ScalarQuantizer
+		{
+		protected:
+
+			// Codes for quantization::INT8
+			std::vector<std::int8_t> _codes8;
+
+			// Codes for quantization::FLOAT16 (IEEE 754 half precision bit patterns)
+			std::vector<std::uint16_t> _codes16;
+
+			// Per feature scale, scale squared and offset for quantization::INT8
+			std::vector<float> _scale, _scaleSquare;
+			std::vector<double> _offset;
+
+			std::size_t _rows, _cols;
+
+		/**
+		   * Function Name :  From Half
+
+		   * Function Description :  Function to convert a half precision bit pattern into a float
+
+		   * Parameters :
+
+		   1) half :		The half precision bit pattern
+
+						   Type Expected : std::uint16_t
+
+						   Method of passing :  value
+
+		   * Return :	   float - > the converted value
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			static float _fromHalf(std::uint16_t half) noexcept;
+
+		/**
+		   * Function Name :  Halves
+
+		   * Function Description :  Function to get the float value of every half precision bit pattern (65536 values, 256 KB),
+									  built with _fromHalf() on the first call. Decoding a code is then a single load
+
+		   * Return :	   const float* - > the table, indexed by the bit pattern
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			static const float* _halves() noexcept;
+
+		/**
+		   * Function Name :  To Half
+
+		   * Function Description :  Function to convert a float into a half precision bit pattern (round to nearest even)
+
+		   * Parameters :
+
+		   1) value :		The value to convert
+
+						   Type Expected : float
+
+						   Method of passing :  value
+
+		   * Return :	   std::uint16_t - > the half precision bit pattern
+
+
+		   * Example
+
+			This function is internal and protected
+
+
+		*/
+			static std::uint16_t _toHalf(float value) noexcept;
+
+		public:
+
+			quantization Type;
+
+		/**
+		   * Constructor Name : ScalarQuantizer[Parameterized]
+
+		   * Constructor Description :  Constructor to load the precision
+
+		   * Parameters :
+
+		   1) type			The precision to store the observations in
+
+							Type Expected : cmll::neighbors::quantization
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			ScalarQuantizer(const quantization& type = quantization::NONE);
+
+		/**
+		   * Function Name :  append
+
+		   * Function Description :  Function to encode more observations with the parameters found by fit() and store them after the others.
+									  The codes grow in amortized constant time per observation
+
+		   * Parameters :
+
+		   1) X :			The observations to add
+
+						   Type Expected : cmll::data::Storage
+
+						   Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   q.fit(X);
+
+				   q.append(XNew);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void append(const data::Storage& X) noexcept;
+
+		/**
+		   * Function Name :  clear
+
+		   * Function Description :  Function to release all the stored codes
+
+		   * Parameters :	None
+
+		   * Return :		None
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   q.fit(X);
+
+				   q.clear();
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void clear() noexcept;
+
+		/**
+		   * Function Name :  decode
+
+		   * Function Description :  Function to reconstruct an observation from its codes
+
+		   * Parameters :
+
+		   1) row :			The index of the observation
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   2) result :		The reconstructed observation. Should be of size equal to the number of features
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   q.fit(X);
+
+				   q.decode(0,x);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void decode(const std::size_t& row, std::vector<double>& result) const noexcept;
+
+		/**
+		   * Function Name :  distance
+
+		   * Function Description :  Function to calculate the reduced distance of a prepared query from a stored observation.
+									  The reduced distance is the squared distance for EUCLEDIAN, the distance itself for MANHATTAN
+									  and the sum of |x - y|^p for MINKOWSKI. It preserves the ordering of the actual distances.
+
+		   * Parameters :
+
+		   1) query :		The query prepared by prepare()
+
+							Type Expected : std::vector<float>
+
+							Method of passing :  constant and by reference
+
+		   2) row :			The index of the observation
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   3) metric :		The distance metric
+
+							Type Expected : cmll::neighbors::distanceMetric
+
+							Method of passing :  constant and by reference
+
+		   4) p :			The order for MINKOWSKI
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+		   * Return :		double - > the reduced distance
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   q.fit(X);
+
+				   q.prepare(x,query);
+
+				   std::cout<<q.distance(query,0,cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			double distance(const std::vector<float>& query, const std::size_t& row, const distanceMetric& metric, const double& p) const noexcept;
+
+		/**
+		   * Function Name :  fit
+
+		   * Function Description :  Function to calculate the per feature scale and offset (INT8) and encode every observation of X
+
+		   * Parameters :
+
+		   1) X :			The feature matrix
+
+							Type Expected : cmll::data::Storage
+
+							Method of passing :  constant and by reference
+
+		   * Return :		None
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::FLOAT16);
+
+				   q.fit(X);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void fit(const data::Storage& X) noexcept;
+
+		/**
+		   * Function Name :  Memory Usage
+
+		   * Function Description :  Function to get the number of bytes used by the codes and the per feature parameters
+
+		   * Parameters :	None
+
+		   * Return :		std::size_t - > bytes used
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   q.fit(X);
+
+				   std::cout<<q.memoryUsage();
+
+				   return 0;
+
+			   }
+
+
+		   */
+			std::size_t memoryUsage() const noexcept;
+
+		/**
+		   * Function Name :  prepare
+
+		   * Function Description :  Function to convert a query into the representation used by distance().
+									  For INT8 the query is moved into the code space of every feature so that the distance kernels
+									  work directly on the stored integers. Should be called once per query.
+
+		   * Parameters :
+
+		   1) x :			The query
+
+							Type Expected : std::vector<double>
+
+							Method of passing :  constant and by reference
+
+		   2) query :		The prepared query
+
+							Type Expected : std::vector<float>
+
+							Method of passing :  by reference
+
+		   * Return :		None
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   q.fit(X);
+
+				   q.prepare(x,query);
+
+				   return 0;
+
+			   }
+
+
+		   */
+			void prepare(const std::vector<double>& x, std::vector<float>& query) const noexcept;
+
+		/**
+		   * Function Name :  rows
+
+		   * Function Description :  Function to get the number of encoded observations
+
+		   * Parameters :	None
+
+		   * Return :		std::size_t - > number of observations
+
+		   * Example
+
+			   #include<vector>
+			   #include<Neighbors/Quantizer.h>
+
+			   int main()
+			   {
+				   cmll::neighbors::ScalarQuantizer q(cmll::neighbors::quantization::INT8);
+
+				   q.fit(X);
+
+				   std::cout<<q.rows();
+
+				   return 0;
+
+			   }
+
+
+		   */
+			std::size_t rows() const noexcept;
+		};
+	}
+}
@@ -14,7 +14,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 8, 2020
-	* Last modified : April 10, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (0.1.0)
 
@@ -27,6 +27,7 @@
 /*
 	All the includes are to be aligned in the alphabetical order
 */
+#include<algorithm>
 #include<cmath>
 #include<iostream>
 
@@ -309,6 +310,53 @@ namespace cmll
 			*/
 			double euclidean(const std::vector<double>& x, const std::vector<double>& y, const double& none=0);
 
+			/**
+			* Function Name :  From Reduced
+
+			* Function Description :  Function converts a reduced distance (see reduced()) into the actual distance
+
+
+			* Parameters :
+
+			1) value :		The reduced distance
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+			2) metric :		The distance metric
+
+							Type Expected : cmll::neighbors::distanceMetric
+
+							Method of passing :  constant and by reference
+
+			3) p :			The value of order p (used by MINKOWSKI)
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+			*
+
+			* Return :		result - > double
+
+
+			* Example
+
+				#include<vector>
+				#include<numeric/Functions.h>
+
+				int main()
+				{
+					auto result = cmll::functions::distance::fromReduced(25,cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+					return 0;
+
+				}
+
+
+			*/
+			double fromReduced(const double& value, const neighbors::distanceMetric& metric, const double& p) noexcept;
+
 			/**
 			* Function Name :  Manhattan
 
@@ -400,6 +448,191 @@ namespace cmll
 
 			*/
 			double minkowski(const std::vector<double>& x, const std::vector<double>& y, const double& p);
+
+			/**
+			* Function Name :  Reduced
+
+			* Function Description :  Function calculates the reduced distance between two contiguous observations.
+									  The reduced distance skips the final root of the metric (squared distance for EUCLEDIAN,
+									  sum of |x - y|^p for MINKOWSKI, the distance itself for MANHATTAN). It orders observations
+									  exactly like the actual distance and is cheaper to calculate, so the neighbor searches compare it instead.
+
+
+			* Parameters :
+
+			1) x :			Pointer to the first observation
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+			2) y :			Pointer to the second observation
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+			3) size :		Number of features
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+			4) metric :		The distance metric
+
+							Type Expected : cmll::neighbors::distanceMetric
+
+							Method of passing :  constant and by reference
+
+			5) p :			The value of order p (used by MINKOWSKI)
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+			*
+
+			* Return :		result - > double
+
+
+			* Example
+
+				#include<vector>
+				#include<numeric/Functions.h>
+
+				int main()
+				{
+					// vector creation and element adding here
+
+					auto result = cmll::functions::distance::reduced(x.data(),y.data(),x.size(),cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+					return 0;
+
+				}
+
+
+			*/
+			double reduced(const double* x, const double* y, const std::size_t& size, const neighbors::distanceMetric& metric, const double& p) noexcept;
+
+			/**
+			* Function Name :  Reduced Within
+
+			* Function Description :  Function calculates the reduced distance (see reduced()) between two contiguous observations
+									  but gives up as soon as the partial sum is larger than bound, since the sum only grows.
+									  The value returned is then some partial sum larger than bound, not the reduced distance.
+									  The partial sum is checked once every 8 features so the inner loops can still be vectorized.
+									  Used by the radius searches, where most candidates are far from the query.
+
+
+			* Parameters :
+
+			1) x :			Pointer to the first observation
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+			2) y :			Pointer to the second observation
+
+							Type Expected : const double*
+
+							Method of passing :  value
+
+			3) size :		Number of features
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+			4) metric :		The distance metric
+
+							Type Expected : cmll::neighbors::distanceMetric
+
+							Method of passing :  constant and by reference
+
+			5) p :			The value of order p (used by MINKOWSKI)
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+			6) bound :		The reduced distance beyond which the calculation stops (see toReduced())
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+			*
+
+			* Return :		result - > double
+
+
+			* Example
+
+				#include<vector>
+				#include<numeric/Functions.h>
+
+				int main()
+				{
+					// vector creation and element adding here
+
+					// Within a radius of 3
+					auto result = cmll::functions::distance::reducedWithin(x.data(),y.data(),x.size(),cmll::neighbors::distanceMetric::EUCLEDIAN,2,9);
+
+					bool inside = result <= 9;
+
+					return 0;
+
+				}
+
+
+			*/
+			double reducedWithin(const double* x, const double* y, const std::size_t& size, const neighbors::distanceMetric& metric, const double& p, const double& bound) noexcept;
+
+			/**
+			* Function Name :  To Reduced
+
+			* Function Description :  Function converts an actual distance into the reduced distance (inverse of fromReduced())
+
+
+			* Parameters :
+
+			1) value :		The actual distance
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+
+			2) metric :		The distance metric
+
+							Type Expected : cmll::neighbors::distanceMetric
+
+							Method of passing :  constant and by reference
+
+			3) p :			The value of order p (used by MINKOWSKI)
+
+							Type Expected : double
+
+							Method of passing :  constant and by reference
+			*
+
+			* Return :		result - > double
+
+
+			* Example
+
+				#include<vector>
+				#include<numeric/Functions.h>
+
+				int main()
+				{
+					auto result = cmll::functions::distance::toReduced(5,cmll::neighbors::distanceMetric::EUCLEDIAN,2);
+
+					return 0;
+
+				}
+
+
+			*/
+			double toReduced(const double& value, const neighbors::distanceMetric& metric, const double& p) noexcept;
 		}
 	}
 }
\ No newline at end of file
@@ -14,7 +14,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 8, 2020
-	* Last modified : April 10, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (0.1.0)
 
@@ -29,6 +29,8 @@
 /* 
 	All the includes are to be aligned in the alphabetical order 
 */
+#include<algorithm>
+#include<cmath>
 #include<iostream>
 #include"../utils/Defines.h"
 
@@ -95,6 +97,102 @@ namespace cmll
 		*/
 		void addition(const data::Storage& matrixLhs, const data::Storage& matrixRhs, data::Storage& result) noexcept;
 
+		/**
+		* Function Name :  Cholesky decomposition of a matrix
+
+		* Function Description :  Function accepts two multidimensional vectors matrix and l.
+
+								  A symmetric positive definite matrix is decomposed into a lower triangular matrix l
+								  ( half the work of the L U decomposition, and no pivoting is needed )
+
+								  matrix = l.l^T
+
+		* Parameters :
+
+		1) matrix :		Matrix of equation [ matrix = l.l^T ] ( only its lower triangle is read )
+
+						Type Expected : Multidimensional vector
+
+						Method of passing :  constant and by reference
+
+		2) l :			l of equation [ matrix = l.l^T ] ( resized to the order of matrix )
+
+						Type Expected : Multi dimensional vector
+
+						Method of passing : by reference
+		*
+
+		* Return :		bool - > false if the matrix is not positive definite ( l is then incomplete )
+
+
+		* Example
+
+			#include<vector>
+			#include<numeric/Matrix.h>
+
+			int main()
+			{
+				// vector creation and element adding here
+
+				cmll::matrix::cholesky(matrix,l)
+
+				return 0;
+
+			}
+		*/
+		bool cholesky(const data::Storage& matrix, data::Storage& l) noexcept;
+
+		/**
+		* Function Name :  Cholesky solve
+
+		* Function Description :  Function accepts three multidimensional vectors l, vector and result.
+
+								  The system matrix.result = vector is solved from the Cholesky decomposition l of matrix
+								  by a forward and a backward substitution
+
+								  result = (l.l^T)^-1.vector
+
+		* Parameters :
+
+		1) l :			l of equation [ result = (l.l^T)^-1.vector ] as found by cholesky()
+
+						Type Expected : Multidimensional vector
+
+						Method of passing :  constant and by reference
+
+		2) vector :		vector of equation [ result = (l.l^T)^-1.vector ] ( N X 1 )
+
+						Type Expected : Multidimensional vector
+
+						Method of passing :  constant and by reference
+
+		3) result :		result of equation [ result = (l.l^T)^-1.vector ] ( resized to N X 1 )
+
+						Type Expected : Multi dimensional vector
+
+						Method of passing : by reference
+		*
+
+		* Return :		None
+
+
+		* Example
+
+			#include<vector>
+			#include<numeric/Matrix.h>
+
+			int main()
+			{
+				// vector creation and element adding here
+
+				if (cmll::matrix::cholesky(matrix,l)) cmll::matrix::choleskySolve(l,vector,result)
+
+				return 0;
+
+			}
+		*/
+		void choleskySolve(const data::Storage& l, const data::Storage& vector, data::Storage& result) noexcept;
+
 		/**
 		* Function Name :  Matrix Diagonal Addition
 
@@ -249,6 +347,58 @@ namespace cmll
 		*/
 		void diagonalInverse(const data::Storage& vector, data::Storage& result) noexcept;
 
+		/**
+		* Function Name :  Eigen decomposition of a symmetric matrix
+
+		* Function Description :  Function accepts three multidimensional vectors matrix, values and vectors.
+
+								  A symmetric matrix is reduced to a tridiagonal matrix by Householder reflections and the
+								  tridiagonal matrix is diagonalized by the implicit QL method (O(N^3), against O(N^3) per sweep
+								  for the Jacobi method)
+
+								  matrix = vectors.diag(values).vectors^T
+
+		* Parameters :
+
+		1) matrix :		Matrix of equation [ matrix = vectors.diag(values).vectors^T ]
+
+						Type Expected : Multidimensional vector
+
+						Method of passing :  constant and by reference
+
+		2) values :		The eigen values in increasing order ( resized to N X 1 )
+
+						Type Expected : Multidimensional vector
+
+						Method of passing : by reference
+
+		3) vectors :	The eigen vectors, column i for values[i] ( resized to N X N )
+
+						Type Expected : Multidimensional vector
+
+						Method of passing : by reference
+		*
+
+		* Return :		None
+
+
+		* Example
+
+			#include<vector>
+			#include<numeric/Matrix.h>
+
+			int main()
+			{
+				// vector creation and element adding here
+
+				cmll::matrix::eigen(matrix,values,vectors);
+
+				return 0;
+
+			}
+		*/
+		void eigen(const data::Storage& matrix, data::Storage& values, data::Storage& vectors) noexcept;
+
 		/**
 		* Function Name :  Matrix inverse
 
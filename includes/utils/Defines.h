@@ -14,7 +14,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 8, 2020
-	* Last modified : April 19, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (0.1.0)
 
@@ -29,6 +29,7 @@
 /*
 	All th includes are to be aligned in the alphabetical order
 */
+#include<cstddef>
 #include<vector>
 
 
@@ -49,6 +50,27 @@ namespace cmll
 			For cleaner code the vector of vectors of double is used as storage
 		*/
 		typedef std::vector<std::vector<double>> Storage;
+
+		/*
+			Sparse matrix in compressed sparse row (CSR) form. The non zero values of row r are Values[Offsets[r] .. Offsets[r + 1])
+			and lie in the columns Indexes[Offsets[r] .. Offsets[r + 1]). Offsets holds Rows + 1 values
+		*/
+		struct Sparse
+		{
+			std::size_t Rows;
+			std::size_t Cols;
+			std::vector<std::size_t> Offsets;
+			std::vector<std::size_t> Indexes;
+			std::vector<double> Values;
+		};
+
+		/*
+			enum for defaults
+		*/
+		enum class defaults
+		{
+			BATCH_SIZE = 65536
+		};
 	}
 	/*
 		matrix name space :  name space that contains enums for matrix related operations such as multiply, transpose inverse etc.
@@ -96,7 +118,12 @@ namespace cmll
 		enum class defaults
 		{
 			LAMBDA = 2,
-			MAXIMUM_ITERATIONS = 100
+			MAXIMUM_ITERATIONS = 100,
+			MAXIMUM_SOLVER_ITERATIONS = 1000,
+			BATCH_SIZE = 16,
+			EPOCHS = 10,
+			HISTORY = 10,
+			PATH_LENGTH = 100
 		};
 
 		/*
@@ -105,6 +132,10 @@ namespace cmll
 		namespace defaultsd
 		{
 			constexpr double TOLERANCE = 0.0001;
+			constexpr double LEARNING_RATE = 0.01;
+			constexpr double ELASTIC_NET_LAMBDA = 1.0;
+			constexpr double L1_RATIO = 0.5;
+			constexpr double PATH_RATIO = 0.001;
 		}
 
 		/*
@@ -115,6 +146,73 @@ namespace cmll
 			BINARY,
 			MULTI_CLASS
 		};
+
+		/*
+			Enum type for the way the coefficients of linear and ridge regression are solved for
+
+			DIRECT :  X^T X is formed and inverted. O(features^2) memory and O(features^3) time, dense X only
+
+			CG :  Conjugate gradient on the normal equations, with products by X and X^T only (matrix free)
+
+			LSQR :  LSQR on X itself (Paige and Saunders). Matrix free as CG and more accurate when X is ill conditioned
+
+			SGD :  Mini-batch stochastic gradient descent over the observations in a new random order every epoch. Threads update
+				   the shared coefficients without locks (Hogwild), so it scales to any number of observations
+
+			LBFGS :  Limited memory BFGS (LogisticRegression). O(History x features) memory, supports multinomial (softmax) models
+
+			For LogisticRegression DIRECT is the Newton-Raphson method
+		*/
+		enum class SolverType
+		{
+			DIRECT,
+			CG,
+			LSQR,
+			SGD,
+			LBFGS
+		};
+
+		/*
+			Enum type for the loss stochastic gradient descent minimizes
+
+			SQUARED :  (x.b - y)^2 / 2 (linear and ridge regression)
+
+			LOGISTIC :  Negative log likelihood of the label (0 or 1) under sigmoid(x.b) (logistic regression)
+		*/
+		enum class LossType
+		{
+			SQUARED,
+			LOGISTIC
+		};
+
+		/*
+			Enum type for the learning rate schedule of stochastic gradient descent, with t = 1 + epochs done (fractional)
+
+			CONSTANT :  LearningRate
+
+			INVERSE :  LearningRate / t
+
+			INVERSE_SCALING :  LearningRate / sqrt(t)
+		*/
+		enum class ScheduleType
+		{
+			CONSTANT,
+			INVERSE,
+			INVERSE_SCALING
+		};
+
+		/*
+			Enum type for the order in which coordinate descent (Lasso and ElasticNet) visits the coefficients
+
+			CYCLIC :  In the order of the features
+
+			RANDOM :  In a new random order every pass (from Seed)
+		*/
+		enum class SelectionType
+		{
+			CYCLIC,
+			RANDOM
+		};
 	}
 
 	/*
@@ -156,14 +254,111 @@ namespace cmll
 			NO
 		};
 
+		/*
+			enum for the precision the training set of neighbor models is stored in
+
+			NONE :  Full precision (double)
+
+			FLOAT16 :  Half precision floats (2 bytes per value)
+
+			INT8 :  8 bit integers with a per feature scale and offset (1 byte per value)
+		*/
+		enum class quantization
+		{
+			NONE,
+			FLOAT16,
+			INT8
+		};
+
 		
+		/*
+			enum for the search structure used for finding the nearest neighbors
+
+			BRUTE :  Distances from every observation are calculated
+
+			KD_TREE :  K dimensional tree (suited for low dimensional data)
+
+			BALL_TREE :  Ball tree (suited for many features and for any metric)
+
+			HNSW :  Hierarchical navigable small world graph. Approximate, the neighbors found may not be the exact ones
+
+			IVF_PQ :  Inverted file with product quantization. Approximate, stores every observation in a few bytes
+
+			LSH :  Locality sensitive hashing. Approximate, built in a single pass
+		*/
+		enum class searchAlgorithm
+		{
+			BRUTE,
+			KD_TREE,
+			BALL_TREE,
+			HNSW,
+			IVF_PQ,
+			LSH
+		};
+
+		/*
+			enum for the algorithm KMeans runs
+
+			LLOYD :  Every observation is compared with every centroid on every iteration
+
+			ELKAN :  Lloyd's algorithm skipping the comparisons the triangle inequality rules out, with an upper bound and
+					 K lower bounds per observation and the distances between the centroids. Skips the most, uses O(N x K) memory
+
+			HAMERLY :  As ELKAN with a single lower bound per observation. O(N) memory, suited for few features and large K
+		*/
+		enum class kMeansAlgorithm
+		{
+			LLOYD,
+			ELKAN,
+			HAMERLY
+		};
+
+		/*
+			enum for the way KMeans chooses its first centroids
+
+			FIRST :  The first K observations of X
+
+			K_MEANS_PLUS_PLUS :  k-means++. Every centroid is an observation picked with probability proportional to its
+								 (reduced) distance from the closest centroid already picked
+
+			K_MEANS_PARALLEL :  k-means||. A few rounds pick many observations at once with the same probabilities,
+								then k-means++ chooses K of them. Suited for very large X
+		*/
+		enum class initialization
+		{
+			FIRST,
+			K_MEANS_PLUS_PLUS,
+			K_MEANS_PARALLEL
+		};
+
 		/*
 			enum for defaults
 		*/
 		enum class defaults
 		{
 			K = 2,
-			P = 2
+			P = 2,
+			LEAF_SIZE = 32,
+			M = 16,
+			EF_CONSTRUCTION = 200,
+			EF_SEARCH = 50,
+			LISTS = 256,
+			PROBES = 8,
+			SUB_QUANTIZERS = 8,
+			TRAINING_SIZE = 65536,
+			TABLES = 8,
+			HASH_FUNCTIONS = 8,
+			MAXIMUM_ITERATIONS = 300,
+			RESTARTS = 1
 		};
+
+		/*
+			Name space for default double values for neighbor model classes
+		*/
+		namespace defaultsd
+		{
+			constexpr double TOLERANCE = 0.0001;
+			constexpr double REASSIGNMENT_RATIO = 0.01;
+		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include<cstddef>
+#include<ios>
+#include<stdexcept>
+#include<streambuf>
+#include<string>
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+
+namespace cmll
+{
+	namespace utils
+	{
+	/**
+		* Class Name : MappedFile
+
+		* Class Description : A file mapped read only into memory (mmap, or CreateFileMapping and MapViewOfFile on Windows).
+							  Pages are read from disk when first touched and are shared through the page cache by every process
+							  mapping the same file, so opening a large file is immediate and nothing is copied.
+							  The mapping is released when the object is destroyed, so it can not be copied.
+
+		* Functions :
+
+		1) data
+
+		2) size
+
+		*
+		*/
+		class MappedFile
+		{
+		protected:
+
+			const char* _data;
+			std::size_t _size;
+
+			// Native handles : the file and the mapping (Windows) or the file descriptor (POSIX, closed once mapped)
+			void* _file;
+			void* _mapping;
+
+		public:
+
+		/**
+		   * Constructor Name : MappedFile[Parameterized]
+
+		   * Constructor Description :  Constructor to map a whole file read only
+
+		   * Parameters :
+
+		   1) filename		The file to map
+
+							Type Expected : std::string
+
+							Method of passing :  constant and by reference
+
+		   * Throws    :  std::runtime_error : If the file can not be opened or mapped, or is empty
+
+		   * Example
+
+			   #include<utils/MappedFile.h>
+
+			   int main()
+			   {
+				   cmll::utils::MappedFile file("model.knn");
+
+				   const char* bytes = file.data();
+
+				   return 0;
+			   }
+
+		   */
+			MappedFile(const std::string& filename); // throws std::runtime_error
+
+			MappedFile(const MappedFile&) = delete;
+			MappedFile& operator=(const MappedFile&) = delete;
+
+			~MappedFile();
+
+		/**
+		   * Function Name :  data
+
+		   * Function Description :  Function to get the first byte of the mapping
+
+		   * Return :		const char* - > the mapped bytes
+		*/
+			const char* data() const noexcept;
+
+		/**
+		   * Function Name :  size
+
+		   * Function Description :  Function to get the number of mapped bytes
+
+		   * Return :		std::size_t - > size of the file
+		*/
+			std::size_t size() const noexcept;
+		};
+
+	/**
+		* Class Name : MemoryBuffer
+
+		* Class Description : Read only stream buffer over bytes held in memory (for example a part of a MappedFile),
+							  so that a std::istream can read them without copying them first.
+							  Readers that know the stream is over memory can take the bytes where they are (position())
+							  and skip them with seekg()
+
+		* Functions :
+
+		1) seekoff @overriden
+
+		2) seekpos @overriden
+
+		3) position
+
+		*
+		*/
+		class MemoryBuffer : public std::streambuf
+		{
+		protected:
+
+		/**
+		   * Function Name :  seekoff
+
+		   * Function Description :  Function to move the read position relative to the start, the current position or the end.
+									  Used by std::istream::seekg() and std::istream::tellg()
+
+		   * Return :		pos_type - > the new position, or -1 if it would leave the bytes (the position is then not moved)
+		*/
+			pos_type seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which = std::ios_base::in) override;
+
+		/**
+		   * Function Name :  seekpos
+
+		   * Function Description :  Function to move the read position to an offset from the start (see seekoff())
+
+		   * Return :		pos_type - > the new position, or -1 if it would leave the bytes
+		*/
+			pos_type seekpos(pos_type position, std::ios_base::openmode which = std::ios_base::in) override;
+
+		public:
+
+		/**
+		   * Constructor Name : MemoryBuffer[Parameterized]
+
+		   * Constructor Description :  Constructor to load the bytes to read
+
+		   * Parameters :
+
+		   1) data			The first byte
+
+							Type Expected : const char*
+
+							Method of passing :  value
+
+		   2) size			Number of bytes
+
+							Type Expected : std::size_t
+
+							Method of passing :  constant and by reference
+
+		   * Example
+
+			   cmll::utils::MemoryBuffer buffer(file.data() + offset, bytes);
+			   std::istream in(&buffer);
+
+		   */
+			MemoryBuffer(const char* data, const std::size_t& size);
+
+		/**
+		   * Function Name :  position
+
+		   * Function Description :  Function to get the next byte to be read. It stays valid for as long as the bytes given to the constructor
+
+		   * Return :		const char* - > the next byte
+		*/
+			const char* position() const noexcept;
+		};
+	}
+}
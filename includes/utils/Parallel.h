@@ -0,0 +1,140 @@
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+#pragma once
+
+
+/*
+	All the includes are to be aligned in the alphabetical order
+*/
+#include<algorithm>
+#include<atomic>
+#include<functional>
+#include<thread>
+#include<vector>
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+
+namespace cmll
+{
+	namespace utils
+	{
+		/*
+			parallel name space : Name space for running loops on multiple threads using only the standard library
+		*/
+		namespace parallel
+		{
+			/**
+				* Function Name :  For Each
+
+				* Function Description :  Function to run body over the range [begin, end) on multiple threads.
+										  The range is cut into blocks of grain iterations. Every thread keeps taking the next block
+										  until none are left, so uneven blocks are balanced. body is called as body(blockBegin, blockEnd)
+										  and must not throw. Blocks of one call never overlap.
+
+				* Parameters :
+
+				1) begin :		The first iteration
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+				2) end :		One past the last iteration
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+				3) body :		The function to run on every block
+
+								Type Expected : std::function<void(std::size_t, std::size_t)>
+
+								Method of passing :  constant and by reference
+
+				4) threads :	Number of threads to use (0 for all hardware threads)
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+				5) grain :		Iterations per block
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+				* Return :	    None
+
+
+				* Example
+
+				#include<vector>
+				#include<utils/Parallel.h>
+
+				int main()
+				{
+					cmll::utils::parallel::forEach(0, X.size(), [&](std::size_t first, std::size_t last)
+					{
+						for (std::size_t row = first; row < last; ++row) work(X[row]);
+					});
+				}
+
+
+			*/
+			void forEach(const std::size_t& begin, const std::size_t& end, const std::function<void(std::size_t, std::size_t)>& body, const std::size_t& threads = 0, const std::size_t& grain = 1);
+
+			/**
+				* Function Name :  Threads
+
+				* Function Description :  Function to get the number of threads to use for a requested count (0 means all hardware threads)
+
+				* Parameters :
+
+				1) requested :	The requested number of threads
+
+								Type Expected : std::size_t
+
+								Method of passing :  constant and by reference
+
+				* Return :	    std::size_t - > number of threads (at least 1)
+
+
+				* Example
+
+				#include<utils/Parallel.h>
+
+				int main()
+				{
+					std::cout<<cmll::utils::parallel::threads(0);
+				}
+
+
+			*/
+			std::size_t threads(const std::size_t& requested = 0) noexcept;
+		}
+	}
+}
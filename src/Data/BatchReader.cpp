@@ -0,0 +1,161 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Data/BatchReader.h"
+
+
+/*
+	Parent name space
+*/
+namespace cmll
+{
+	/*
+		Name space for data related operations, functions and classes
+	*/
+	namespace data
+	{
+		/*
+			Batch reader class members
+		*/
+
+		BatchReader::BatchReader(const std::string& filename, const std::size_t& batchSize, const bool& header, const char& columnSeparator, const char& rowSeparator) // throws std::runtime_error
+		{
+			/*
+				The file is read through a 1 MB buffer, so large files are read in few system calls
+			*/
+			_buffer.resize(static_cast<std::size_t>(1) << 20);
+			_file.rdbuf()->pubsetbuf(_buffer.data(), static_cast<std::streamsize>(_buffer.size()));
+			_file.open(filename, std::ios::in | std::ios::binary);
+
+			if (!_file.is_open()) throw std::runtime_error("<In function cmll::data::BatchReader::BatchReader()>Error :  Could not open " + filename);
+
+			_in = &_file;
+			_columnSeparator = columnSeparator;
+			_rowSeparator = rowSeparator;
+			_cols = 0;
+			_rows = 0;
+			BatchSize = batchSize;
+
+			if (header) _readHeader();
+		}
+
+		BatchReader::BatchReader(std::istream& in, const std::size_t& batchSize, const bool& header, const char& columnSeparator, const char& rowSeparator)
+		{
+			_in = &in;
+			_columnSeparator = columnSeparator;
+			_rowSeparator = rowSeparator;
+			_cols = 0;
+			_rows = 0;
+			BatchSize = batchSize;
+
+			if (header) _readHeader();
+		}
+
+		void BatchReader::_parse(std::vector<double>& row) // throws std::runtime_error
+		{
+			/*
+				Values are read in place with strtod (no string is created per value). Blanks around a value are ignored,
+				anything else between two values than the column separator is an error
+			*/
+			row.clear();
+
+			const char* cursor = _line.c_str();
+
+			while (true)
+			{
+				char* end = nullptr;
+				double value = std::strtod(cursor, &end);
+
+				if (end == cursor) throw std::runtime_error("<In function cmll::data::BatchReader::next()>Error :  Observation " + std::to_string(_rows + 1) + " holds a value that is not a number");
+
+				row.emplace_back(value);
+
+				while ((*end == ' ' || *end == '\t' || *end == '\r') && *end != _columnSeparator) ++end;
+
+				if (*end == '\0') break;
+
+				if (*end != _columnSeparator) throw std::runtime_error("<In function cmll::data::BatchReader::next()>Error :  Observation " + std::to_string(_rows + 1) + " holds a value that is not a number");
+
+				cursor = end + 1;
+			}
+
+			if (_cols == 0) _cols = row.size();
+
+			else if (row.size() != _cols) throw std::runtime_error("<In function cmll::data::BatchReader::next()>Error :  Observation " + std::to_string(_rows + 1) + " has " + std::to_string(row.size()) + " values instead of " + std::to_string(_cols));
+		}
+
+		void BatchReader::_readHeader()
+		{
+			if (!std::getline(*_in, _line, _rowSeparator)) return;
+
+			if (!_line.empty() && _line.back() == '\r') _line.pop_back();
+
+			std::size_t first = 0;
+
+			while (true)
+			{
+				std::size_t last = _line.find(_columnSeparator, first);
+
+				ColumnNames.emplace_back(_line.substr(first, (last == std::string::npos) ? std::string::npos : last - first));
+
+				if (last == std::string::npos) break;
+
+				first = last + 1;
+			}
+
+			_cols = ColumnNames.size();
+		}
+
+		bool BatchReader::next(Storage& batch) // throws std::runtime_error
+		{
+			/*
+				The rows of batch are refilled in place, so after the first batch reading allocates nothing
+			*/
+			std::size_t count = 0;
+
+			while (count < std::max(BatchSize, static_cast<std::size_t>(1)) && std::getline(*_in, _line, _rowSeparator))
+			{
+				if (_line.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+				if (batch.size() <= count) batch.emplace_back();
+
+				_parse(batch[count]);
+
+				++count;
+				++_rows;
+			}
+
+			batch.resize(count);
+
+			return count > 0;
+		}
+
+		std::size_t BatchReader::rows() const noexcept
+		{
+			return _rows;
+		}
+	}
+}
@@ -0,0 +1,194 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Linear/Lbfgs.h"
+
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		linear name space : Name space for linear models of regression and classification
+	*/
+	namespace linear
+	{
+		/*
+			Lbfgs class members
+		*/
+
+		Lbfgs::Lbfgs(const std::size_t& history, const std::size_t& maximumIterations, const double& tolerance)
+		{
+			History = history;
+			MaximumIterations = maximumIterations;
+			Tolerance = tolerance;
+		}
+
+		std::size_t Lbfgs::minimize(const Objective& objective, std::vector<double>& x) const
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) direction = - H g by the two loop recursion over the kept pairs (s = step, y = gradient change), with the
+				   starting inverse Hessian s.y / y.y of the newest pair (1 / ||g|| on the first iteration, so the first step is unit length)
+				2) Halve the step until f(x + t d) <= f(x) + 1e-4 t g.d (at most 40 times)
+				3) Keep (s, y) if s.y > 0, dropping the oldest pair beyond History
+			*/
+			const double armijo = 1e-4;
+			const std::size_t maximumHalvings = 40;
+
+			std::size_t variables = x.size(), history = std::max(History, static_cast<std::size_t>(1));
+
+			std::vector<double> gradient(variables), direction(variables), next(variables), nextGradient(variables);
+			std::vector<std::vector<double>> steps, changes;
+			std::vector<double> rhos, alphas(history);
+
+			auto dot = [](const std::vector<double>& a, const std::vector<double>& b) { return std::inner_product(a.begin(), a.end(), b.begin(), 0.0); };
+			auto largest = [](const std::vector<double>& a)
+			{
+				double value = 0;
+
+				for (const double& element : a) value = std::max(value, std::abs(element));
+
+				return value;
+			};
+
+			double value = objective(x, gradient);
+
+			for (std::size_t iteration = 0; iteration < MaximumIterations; ++iteration)
+			{
+				if (largest(gradient) <= Tolerance) return iteration;
+
+				// Two loop recursion
+				direction = gradient;
+
+				for (std::size_t pair = steps.size(); pair-- > 0;)
+				{
+					alphas[pair] = rhos[pair] * dot(steps[pair], direction);
+
+					for (std::size_t variable = 0; variable < variables; ++variable)
+					{
+						direction[variable] -= alphas[pair] * changes[pair][variable];
+					}
+				}
+
+				double scale = steps.empty() ? 1 / std::sqrt(dot(gradient, gradient)) : dot(steps.back(), changes.back()) / dot(changes.back(), changes.back());
+
+				for (double& element : direction) element *= -scale;
+
+				for (std::size_t pair = 0; pair < steps.size(); ++pair)
+				{
+					double beta = rhos[pair] * dot(changes[pair], direction);
+
+					for (std::size_t variable = 0; variable < variables; ++variable)
+					{
+						direction[variable] -= (alphas[pair] + beta) * steps[pair][variable];
+					}
+				}
+
+				double slope = dot(gradient, direction);
+
+				// Not a descent direction (rounding) : restart from the gradient
+				if (slope >= 0)
+				{
+					steps.clear();
+					changes.clear();
+					rhos.clear();
+
+					scale = 1 / std::sqrt(dot(gradient, gradient));
+
+					for (std::size_t variable = 0; variable < variables; ++variable)
+					{
+						direction[variable] = -scale * gradient[variable];
+					}
+
+					slope = dot(gradient, direction);
+				}
+
+				// Backtracking line search
+				double length = 1, nextValue = value;
+				bool accepted = false;
+
+				for (std::size_t halving = 0; halving < maximumHalvings && !accepted; ++halving)
+				{
+					for (std::size_t variable = 0; variable < variables; ++variable)
+					{
+						next[variable] = x[variable] + length * direction[variable];
+					}
+
+					nextValue = objective(next, nextGradient);
+
+					if (nextValue <= value + armijo * length * slope) accepted = true;
+
+					else length /= 2;
+				}
+
+				// No decrease can be found : x is as close to the minimum as rounding allows
+				if (!accepted) return iteration;
+
+				std::vector<double> step(variables), change(variables);
+
+				for (std::size_t variable = 0; variable < variables; ++variable)
+				{
+					step[variable] = next[variable] - x[variable];
+					change[variable] = nextGradient[variable] - gradient[variable];
+				}
+
+				double curvature = dot(step, change);
+
+				if (curvature > 0)
+				{
+					if (steps.size() == history)
+					{
+						steps.erase(steps.begin());
+						changes.erase(changes.begin());
+						rhos.erase(rhos.begin());
+					}
+
+					steps.emplace_back(std::move(step));
+					changes.emplace_back(std::move(change));
+					rhos.emplace_back(1 / curvature);
+				}
+
+				bool stalled = (value - nextValue) <= 1e-15 * std::max(std::abs(value), 1.0);
+
+				x.swap(next);
+				gradient.swap(nextGradient);
+				value = nextValue;
+
+				if (stalled) return iteration + 1;
+			}
+
+			if (largest(gradient) > Tolerance)
+			{
+				std::cerr << "<In function cmll::linear::Lbfgs::minimize()> Warning : L-BFGS did not converge at 'Maximum iterations : " << MaximumIterations << "'\n";
+			}
+
+			return MaximumIterations;
+		}
+	}
+}
@@ -15,7 +15,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 8, 2020
-	* Last modified : April 16, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (.1.0)
 
@@ -41,436 +41,2159 @@ namespace cmll
             Members of LinearRegression class
         */
         
+        LinearRegression::LinearRegression(const std::size_t& threads)
+        {
+            BatchSize = static_cast<std::size_t>(defaults::BATCH_SIZE);
+            Epochs = static_cast<std::size_t>(defaults::EPOCHS);
+            Iterations = 0;
+            LearningRate = defaultsd::LEARNING_RATE;
+            MaximumIterations = static_cast<std::size_t>(defaults::MAXIMUM_SOLVER_ITERATIONS);
+            Schedule = ScheduleType::INVERSE_SCALING;
+            Seed = 0;
+            Preconditioning = true;
+            Solver = SolverType::DIRECT;
+            Threads = threads;
+            Tolerance = defaultsd::TOLERANCE;
+            WarmStart = false;
+
+            begin();
+        }
+
+        void LinearRegression::_accumulate(const data::Storage& X, const data::Storage& y, const std::size_t& features)
+        {
+            /*
+                The steps followed by the function are as follows
+
+                1) Check the chunk has as many features and outputs as the earlier ones
+                2) Cut the chunk into blocks of rows. Their number only depends on the number of rows (and is limited so the
+                   sums of the blocks take at most 2^22 values), so the result is the same on any number of threads
+                3) Cut the rows of X^T X into ranges of about equal work (row i of the upper triangle holds features - i values)
+                4) On every thread take the next (block, range) pair and add x_i * x_j (j >= i) and x_i * y of the rows of the block,
+                   four rows at a time so every value of the sums is read and written once per four observations
+                5) Add the sums of the blocks in block order
+            */
+            if (X.empty()) return;
+
+            std::size_t outputs = y.empty() ? X[0].size() - features : y[0].size();
+
+            try
+            {
+                if (_observations > 0 && (features != _features || outputs != _outputs)) throw std::runtime_error("<In function cmll::linear::LinearRegression::accumulate()>Error :  The chunk has " + std::to_string(features) + " features and " + std::to_string(outputs) + " outputs but the earlier ones had " + std::to_string(_features) + " and " + std::to_string(_outputs));
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            if (_observations == 0)
+            {
+                _features = features;
+                _outputs = outputs;
+                _gram.assign(features * features, 0);
+                _moment.assign(features * outputs, 0);
+            }
+
+            const std::size_t minimumRows = 1024, maximumBlocks = 256, maximumValues = static_cast<std::size_t>(1) << 22;
+
+            std::size_t rows = X.size(), values = features * (features + outputs);
+            std::size_t blocks = std::max(std::min({ (rows + minimumRows - 1) / minimumRows, maximumBlocks, maximumValues / std::max(values, static_cast<std::size_t>(1)) }), static_cast<std::size_t>(1));
+            std::size_t blockRows = (rows + blocks - 1) / blocks;
+
+            std::size_t threads = utils::parallel::threads(Threads);
+            std::size_t ranges = std::max(std::min(features, (4 * threads + blocks - 1) / blocks), static_cast<std::size_t>(1));
+
+            std::vector<std::size_t> bounds(1, 0);
+            double work = 0, total = static_cast<double>(features) * (features + 1) / 2 + static_cast<double>(features) * outputs;
+
+            for (std::size_t row = 0; row < features; ++row)
+            {
+                work += static_cast<double>(features - row + outputs);
+
+                if (work * ranges >= total * bounds.size() && bounds.size() < ranges) bounds.emplace_back(row + 1);
+            }
+
+            if (bounds.back() != features) bounds.emplace_back(features);
+
+            ranges = bounds.size() - 1;
+
+            // With a single block the sums are added to directly
+            std::vector<double> partial((blocks > 1) ? blocks * values : 0);
+
+            utils::parallel::forEach(0, blocks * ranges, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t task = first; task < last; ++task)
+                {
+                    std::size_t block = task / ranges, range = task % ranges;
+                    std::size_t firstRow = block * blockRows, lastRow = std::min(rows, firstRow + blockRows);
+                    std::size_t firstFeature = bounds[range], lastFeature = bounds[range + 1];
+
+                    double* gram = (blocks > 1) ? partial.data() + block * values : _gram.data();
+                    double* moment = (blocks > 1) ? gram + features * features : _moment.data();
+
+                    auto target = [&](const std::size_t& row) { return y.empty() ? X[row].data() + features : y[row].data(); };
+
+                    std::size_t row = firstRow;
+
+                    for (; row + 4 <= lastRow; row += 4)
+                    {
+                        const double* x0 = X[row].data(), * x1 = X[row + 1].data(), * x2 = X[row + 2].data(), * x3 = X[row + 3].data();
+                        const double* y0 = target(row), * y1 = target(row + 1), * y2 = target(row + 2), * y3 = target(row + 3);
+
+                        for (std::size_t i = firstFeature; i < lastFeature; ++i)
+                        {
+                            double a0 = x0[i], a1 = x1[i], a2 = x2[i], a3 = x3[i];
+                            double* g = gram + i * features;
+                            double* m = moment + i * outputs;
+
+                            for (std::size_t j = i; j < features; ++j)
+                            {
+                                g[j] += a0 * x0[j] + a1 * x1[j] + a2 * x2[j] + a3 * x3[j];
+                            }
+
+                            for (std::size_t output = 0; output < outputs; ++output)
+                            {
+                                m[output] += a0 * y0[output] + a1 * y1[output] + a2 * y2[output] + a3 * y3[output];
+                            }
+                        }
+                    }
+
+                    for (; row < lastRow; ++row)
+                    {
+                        const double* x0 = X[row].data(), * y0 = target(row);
+
+                        for (std::size_t i = firstFeature; i < lastFeature; ++i)
+                        {
+                            double a0 = x0[i];
+                            double* g = gram + i * features;
+                            double* m = moment + i * outputs;
+
+                            for (std::size_t j = i; j < features; ++j)
+                            {
+                                g[j] += a0 * x0[j];
+                            }
+
+                            for (std::size_t output = 0; output < outputs; ++output)
+                            {
+                                m[output] += a0 * y0[output];
+                            }
+                        }
+                    }
+                }
+            }, threads);
+
+            if (blocks > 1)
+            {
+                utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t block = 0; block < blocks; ++block)
+                    {
+                        const double* gram = partial.data() + block * values;
+                        const double* moment = gram + features * features;
+
+                        for (std::size_t i = first; i < last; ++i)
+                        {
+                            for (std::size_t j = i; j < features; ++j)
+                            {
+                                _gram[i * features + j] += gram[i * features + j];
+                            }
+
+                            for (std::size_t output = 0; output < outputs; ++output)
+                            {
+                                _moment[i * outputs + output] += moment[i * outputs + output];
+                            }
+                        }
+                    }
+                }, threads);
+            }
+
+            _observations += rows;
+        }
+
+        std::size_t LinearRegression::_conjugateGradient(const Operator& normal, const std::vector<double>& diagonal, const std::vector<double>& rhs, const double& penalty, std::vector<double>& b) const
+        {
+            /*
+                Preconditioned conjugate gradient (Golub and Van Loan, Algorithm 11.5.1) for ( A + penalty I ) b = rhs with the
+                preconditioner M = diagonal :
+
+                                r = rhs - ( A + penalty I ) b,  z = M^{-1} r,  p = z
+                    repeat      q = ( A + penalty I ) p,  alpha = r.z / p.q
+                                b = b + alpha p,  r = r - alpha q
+                                z = M^{-1} r,  p = z + ( r.z (new) / r.z (old) ) p
+
+                until ||r|| <= Tolerance ||rhs||
+            */
+            std::size_t features = rhs.size();
+
+            double rhsNorm = std::sqrt(std::inner_product(rhs.begin(), rhs.end(), rhs.begin(), 0.0));
+
+            if (rhsNorm == 0)
+            {
+                b.assign(features, 0);
+                return 0;
+            }
+
+            std::vector<double> r(features), z(features), direction(features), q(features);
+
+            normal(b, q);
+
+            for (std::size_t feature = 0; feature < features; ++feature)
+            {
+                r[feature] = rhs[feature] - q[feature] - penalty * b[feature];
+                z[feature] = r[feature] / diagonal[feature];
+            }
+
+            direction = z;
+
+            double rz = std::inner_product(r.begin(), r.end(), z.begin(), 0.0);
+
+            for (std::size_t iteration = 0; iteration < MaximumIterations; ++iteration)
+            {
+                if (std::sqrt(std::inner_product(r.begin(), r.end(), r.begin(), 0.0)) <= Tolerance * rhsNorm) return iteration;
+
+                normal(direction, q);
+
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    q[feature] += penalty * direction[feature];
+                }
+
+                double curvature = std::inner_product(direction.begin(), direction.end(), q.begin(), 0.0);
+
+                // Only happens for a singular X^T X without penalty, once b solves the system as far as it can be
+                if (curvature <= 0) return iteration;
+
+                double alpha = rz / curvature;
+
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    b[feature] += alpha * direction[feature];
+                    r[feature] -= alpha * q[feature];
+                    z[feature] = r[feature] / diagonal[feature];
+                }
+
+                double rzNew = std::inner_product(r.begin(), r.end(), z.begin(), 0.0);
+                double beta = rzNew / rz;
+
+                rz = rzNew;
+
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    direction[feature] = z[feature] + beta * direction[feature];
+                }
+            }
+
+            if (std::sqrt(std::inner_product(r.begin(), r.end(), r.begin(), 0.0)) > Tolerance * rhsNorm)
+            {
+                std::cerr << "<In function cmll::linear::LinearRegression::model()> Warning : CG did not converge at 'Maximum iterations : " << MaximumIterations << "'\n";
+            }
+
+            return MaximumIterations;
+        }
+
+        void LinearRegression::_fit(const data::Storage& X, const data::Storage& y, const double& penalty)
+        {
+            /*
+                DIRECT forms X^T X (see _accumulate() and _solve()). CG and LSQR never form it : every iteration multiplies by X and X^T,
+                so memory stays at a few vectors besides X
+            */
+            if (Solver == SolverType::DIRECT)
+            {
+                begin();
+                _accumulate(X, y, X[0].size());
+                _solve(penalty);
+                return;
+            }
+
+            if (Solver == SolverType::SGD)
+            {
+                if (!WarmStart) Coefficients.clear();
+
+                Iterations = Sgd(LossType::SQUARED, penalty, BatchSize, Epochs, LearningRate, Schedule, Seed, Threads, Tolerance).fit(X, y, Coefficients);
+                return;
+            }
+
+            std::vector<double> squares;
+
+            _squares(X, squares);
+
+            _iterate([&](const std::vector<double>& v, std::vector<double>& result) { _product(X, v, result); },
+                     [&](const std::vector<double>& u, std::vector<double>& result) { _transposedProduct(X, u, result); },
+                     squares, y, penalty, Solver);
+        }
+
+        void LinearRegression::_fit(const data::Sparse& X, const data::Storage& y, const double& penalty)
+        {
+            /*
+                Forming X^T X would fill it in, so a sparse X is always solved by products (LSQR when Solver is DIRECT)
+            */
+            try
+            {
+                if (X.Offsets.size() != X.Rows + 1 || y.size() != X.Rows) throw std::runtime_error("<In function cmll::linear::LinearRegression::model()>Error :  X has " + std::to_string(X.Rows) + " rows and " + std::to_string(X.Offsets.size()) + " offsets, y has " + std::to_string(y.size()) + " rows");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            if (Solver == SolverType::SGD)
+            {
+                if (!WarmStart) Coefficients.clear();
+
+                Iterations = Sgd(LossType::SQUARED, penalty, BatchSize, Epochs, LearningRate, Schedule, Seed, Threads, Tolerance).fit(X, y, Coefficients);
+                return;
+            }
+
+            std::vector<double> squares;
+
+            _squares(X, squares);
+
+            _iterate([&](const std::vector<double>& v, std::vector<double>& result) { _product(X, v, result); },
+                     [&](const std::vector<double>& u, std::vector<double>& result) { _transposedProduct(X, u, result); },
+                     squares, y, penalty, (Solver == SolverType::DIRECT) ? SolverType::LSQR : Solver);
+        }
+
+        void LinearRegression::_iterate(const Operator& product, const Operator& transposedProduct, const std::vector<double>& squares, const data::Storage& y, const double& penalty, const SolverType& solver)
+        {
+            /*
+                Every output is solved on its own. Jacobi preconditioning divides by the diagonal of X^T X + penalty I
+                (features that are all zero keep a weight of one)
+            */
+            std::size_t features = squares.size(), outputs = y[0].size(), rows = y.size();
+
+            std::vector<double> diagonal(features, 1);
+
+            if (Preconditioning)
+            {
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    if (squares[feature] + penalty > 0) diagonal[feature] = squares[feature] + penalty;
+                }
+            }
+
+            bool warm = WarmStart && Coefficients.size() == features && !Coefficients.empty() && Coefficients[0].size() == outputs;
+
+            data::Storage coefficients(features, std::vector<double>(outputs));
+            std::vector<double> b(features), target(rows), rhs(features), buffer(rows);
+
+            Iterations = 0;
+
+            for (std::size_t output = 0; output < outputs; ++output)
+            {
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    b[feature] = warm ? Coefficients[feature][output] : 0;
+                }
+
+                for (std::size_t row = 0; row < rows; ++row)
+                {
+                    target[row] = y[row][output];
+                }
+
+                std::size_t iterations = 0;
+
+                if (solver == SolverType::CG)
+                {
+                    transposedProduct(target, rhs);
+
+                    iterations = _conjugateGradient([&](const std::vector<double>& v, std::vector<double>& result) { product(v, buffer); transposedProduct(buffer, result); }, diagonal, rhs, penalty, b);
+                }
+
+                else iterations = _lsqr(product, transposedProduct, diagonal, target, penalty, b);
+
+                Iterations = std::max(Iterations, iterations);
+
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    coefficients[feature][output] = b[feature];
+                }
+            }
+
+            Coefficients.swap(coefficients);
+        }
+
+        std::size_t LinearRegression::_lsqr(const Operator& product, const Operator& transposedProduct, const std::vector<double>& diagonal, const std::vector<double>& y, const double& penalty, std::vector<double>& b) const
+        {
+            /*
+                LSQR (Paige and Saunders, 1982) on the stacked system
+
+                                [ X D             ]       [ y - X b0      ]
+                                [ sqrt(penalty) D ] d  =  [ -sqrt(penalty) b0 ]       b = b0 + D d
+
+                where D scales the columns by 1 / sqrt(diagonal) and b0 is the starting point. The lower part only exists with a penalty.
+                u (observations, plus features with a penalty) and v (features) are the Golub-Kahan bidiagonalization vectors.
+
+                Stops when ||r|| <= Tolerance ||r0|| (consistent systems) or ||A^T r|| <= Tolerance ||A|| ||r|| (least squares), with
+                ||A|| estimated by the Frobenius norm of the bidiagonal matrix
+            */
+            std::size_t features = b.size(), rows = y.size();
+            double root = std::sqrt(penalty);
+
+            std::vector<double> scale(features), u(rows), lower((root > 0) ? features : 0), v(features), w(features), d(features, 0), scaled(features), buffer(features);
+
+            for (std::size_t feature = 0; feature < features; ++feature)
+            {
+                scale[feature] = 1 / std::sqrt(diagonal[feature]);
+            }
+
+            // The stacked products
+            auto forward = [&](const std::vector<double>& direction, std::vector<double>& upper, std::vector<double>& bottom)
+            {
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    scaled[feature] = scale[feature] * direction[feature];
+                }
+
+                product(scaled, upper);
+
+                for (std::size_t feature = 0; feature < bottom.size(); ++feature)
+                {
+                    bottom[feature] = root * scaled[feature];
+                }
+            };
+
+            auto backward = [&](const std::vector<double>& upper, const std::vector<double>& bottom, std::vector<double>& direction)
+            {
+                transposedProduct(upper, direction);
+
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    direction[feature] = scale[feature] * (direction[feature] + ((bottom.empty()) ? 0 : root * bottom[feature]));
+                }
+            };
+
+            auto norm = [](const std::vector<double>& upper, const std::vector<double>& bottom)
+            {
+                return std::sqrt(std::inner_product(upper.begin(), upper.end(), upper.begin(), 0.0) + std::inner_product(bottom.begin(), bottom.end(), bottom.begin(), 0.0));
+            };
+
+            // u = r0
+            product(b, u);
+
+            for (std::size_t row = 0; row < rows; ++row)
+            {
+                u[row] = y[row] - u[row];
+            }
+
+            for (std::size_t feature = 0; feature < lower.size(); ++feature)
+            {
+                lower[feature] = -root * b[feature];
+            }
+
+            double beta = norm(u, lower), initial = beta;
+
+            if (beta == 0) return 0;
+
+            for (double& value : u) value /= beta;
+            for (double& value : lower) value /= beta;
+
+            backward(u, lower, v);
+
+            double alpha = std::sqrt(std::inner_product(v.begin(), v.end(), v.begin(), 0.0));
+
+            if (alpha == 0) return 0;
+
+            for (double& value : v) value /= alpha;
+
+            w = v;
+
+            double phiBar = beta, rhoBar = alpha, frobenius = alpha * alpha;
+            std::vector<double> upper(rows), bottom(lower.size());
+            std::size_t iteration = 0;
+            bool converged = false;
+
+            while (iteration < MaximumIterations && !converged)
+            {
+                ++iteration;
+
+                // u = A v - alpha u
+                forward(v, upper, bottom);
+
+                for (std::size_t row = 0; row < rows; ++row)
+                {
+                    u[row] = upper[row] - alpha * u[row];
+                }
+
+                for (std::size_t feature = 0; feature < lower.size(); ++feature)
+                {
+                    lower[feature] = bottom[feature] - alpha * lower[feature];
+                }
+
+                beta = norm(u, lower);
+
+                if (beta > 0)
+                {
+                    for (double& value : u) value /= beta;
+                    for (double& value : lower) value /= beta;
+
+                    // v = A^T u - beta v
+                    backward(u, lower, buffer);
+
+                    for (std::size_t feature = 0; feature < features; ++feature)
+                    {
+                        v[feature] = buffer[feature] - beta * v[feature];
+                    }
+
+                    alpha = std::sqrt(std::inner_product(v.begin(), v.end(), v.begin(), 0.0));
+
+                    if (alpha > 0) for (double& value : v) value /= alpha;
+                }
+
+                frobenius += alpha * alpha + beta * beta;
+
+                // Plane rotation eliminating beta
+                double rho = std::sqrt(rhoBar * rhoBar + beta * beta);
+                double c = rhoBar / rho, s = beta / rho;
+                double theta = s * alpha, phi = c * phiBar;
+
+                rhoBar = -c * alpha;
+                phiBar = s * phiBar;
+
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    d[feature] += (phi / rho) * w[feature];
+                    w[feature] = v[feature] - (theta / rho) * w[feature];
+                }
+
+                // phiBar is ||r|| and phiBar * alpha * |c| is ||A^T r||
+                converged = (phiBar <= Tolerance * initial) || (phiBar * alpha * std::abs(c) <= Tolerance * std::sqrt(frobenius) * phiBar) || alpha == 0 || beta == 0;
+            }
+
+            for (std::size_t feature = 0; feature < features; ++feature)
+            {
+                b[feature] += scale[feature] * d[feature];
+            }
+
+            if (!converged) std::cerr << "<In function cmll::linear::LinearRegression::model()> Warning : LSQR did not converge at 'Maximum iterations : " << MaximumIterations << "'\n";
+
+            return iteration;
+        }
+
+        void LinearRegression::_product(const data::Storage& X, const std::vector<double>& v, std::vector<double>& result) const
+        {
+            std::size_t rows = X.size(), features = v.size();
+
+            result.resize(rows);
+
+            utils::parallel::forEach(0, rows, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t row = first; row < last; ++row)
+                {
+                    result[row] = std::inner_product(X[row].begin(), X[row].begin() + features, v.begin(), 0.0);
+                }
+            }, Threads, 1024);
+        }
+
+        void LinearRegression::_product(const data::Sparse& X, const std::vector<double>& v, std::vector<double>& result) const
+        {
+            result.resize(X.Rows);
+
+            utils::parallel::forEach(0, X.Rows, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t row = first; row < last; ++row)
+                {
+                    double sum = 0;
+
+                    for (std::size_t value = X.Offsets[row]; value < X.Offsets[row + 1]; ++value)
+                    {
+                        sum += X.Values[value] * v[X.Indexes[value]];
+                    }
+
+                    result[row] = sum;
+                }
+            }, Threads, 1024);
+        }
+
+        void LinearRegression::_solve(const double& penalty)
+        {
+            /*
+                X^T X is rebuilt from its upper triangle and solved as in model() of earlier versions (LU decomposition and inverse).
+                The sums are kept, so more observations can still be added
+            */
+            try
+            {
+                if (_observations == 0) throw std::runtime_error("<In function cmll::linear::LinearRegression::finalize()>Error :  No observation has been added. Use accumulate() before finalize()");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            if (Solver != SolverType::DIRECT)
+            {
+                /*
+                    X^T X is kept, so CG multiplies by it directly (O(features^2) per iteration instead of O(features^3) for the inverse).
+                    LSQR and SGD need X itself and are replaced by CG here
+                */
+                std::vector<double> gram(_features * _features), squares(_features), rhs(_features), b(_features);
+
+                for (std::size_t i = 0; i < _features; ++i)
+                {
+                    for (std::size_t j = i; j < _features; ++j)
+                    {
+                        gram[i * _features + j] = gram[j * _features + i] = _gram[i * _features + j];
+                    }
+
+                    squares[i] = _gram[i * _features + i];
+                }
+
+                std::vector<double> diagonal(_features, 1);
+
+                if (Preconditioning)
+                {
+                    for (std::size_t feature = 0; feature < _features; ++feature)
+                    {
+                        if (squares[feature] + penalty > 0) diagonal[feature] = squares[feature] + penalty;
+                    }
+                }
+
+                auto normal = [&](const std::vector<double>& v, std::vector<double>& result)
+                {
+                    result.resize(_features);
+
+                    utils::parallel::forEach(0, _features, [&](std::size_t first, std::size_t last)
+                    {
+                        for (std::size_t i = first; i < last; ++i)
+                        {
+                            result[i] = std::inner_product(v.begin(), v.end(), gram.begin() + i * _features, 0.0);
+                        }
+                    }, Threads, 64);
+                };
+
+                bool warm = WarmStart && Coefficients.size() == _features && !Coefficients.empty() && Coefficients[0].size() == _outputs;
+
+                data::Storage coefficients(_features, std::vector<double>(_outputs));
+
+                Iterations = 0;
+
+                for (std::size_t output = 0; output < _outputs; ++output)
+                {
+                    for (std::size_t feature = 0; feature < _features; ++feature)
+                    {
+                        rhs[feature] = _moment[feature * _outputs + output];
+                        b[feature] = warm ? Coefficients[feature][output] : 0;
+                    }
+
+                    Iterations = std::max(Iterations, _conjugateGradient(normal, diagonal, rhs, penalty, b));
+
+                    for (std::size_t feature = 0; feature < _features; ++feature)
+                    {
+                        coefficients[feature][output] = b[feature];
+                    }
+                }
+
+                Coefficients.swap(coefficients);
+                return;
+            }
+
+            data::Storage X_t_mul_X(_features, std::vector<double>(_features));
+            data::Storage X_t_mul_y(_features, std::vector<double>(_outputs));
+
+            for (std::size_t i = 0; i < _features; ++i)
+            {
+                for (std::size_t j = i; j < _features; ++j)
+                {
+                    X_t_mul_X[i][j] = X_t_mul_X[j][i] = _gram[i * _features + j];
+                }
+
+                X_t_mul_X[i][i] += penalty;
+
+                std::copy(_moment.begin() + i * _outputs, _moment.begin() + (i + 1) * _outputs, X_t_mul_y[i].begin());
+            }
+
+            data::Storage l(_features, std::vector<double>(_features));
+            data::Storage u(_features, std::vector<double>(_features));
+
+            matrix::lu(X_t_mul_X, l, u);
+            matrix::inverse(l, u, X_t_mul_X);
+
+            Coefficients.assign(_features, std::vector<double>(_outputs));
+            matrix::multiplication(X_t_mul_X, X_t_mul_y, Coefficients);
+        }
+
+        void LinearRegression::_squares(const data::Storage& X, std::vector<double>& result) const
+        {
+            std::size_t features = X[0].size();
+
+            result.assign(features, 0);
+
+            utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+            {
+                for (const std::vector<double>& x : X)
+                {
+                    for (std::size_t feature = first; feature < last; ++feature)
+                    {
+                        result[feature] += x[feature] * x[feature];
+                    }
+                }
+            }, Threads, 256);
+        }
+
+        void LinearRegression::_squares(const data::Sparse& X, std::vector<double>& result) const
+        {
+            result.assign(X.Cols, 0);
+
+            for (std::size_t value = 0; value < X.Offsets[X.Rows]; ++value)
+            {
+                result[X.Indexes[value]] += X.Values[value] * X.Values[value];
+            }
+        }
+
+        void LinearRegression::_transposedProduct(const data::Storage& X, const std::vector<double>& u, std::vector<double>& result) const
+        {
+            /*
+                Every thread owns a range of features, so each value of result is added up in row order by a single thread
+            */
+            std::size_t features = X[0].size();
+
+            result.assign(features, 0);
+
+            utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t row = 0; row < X.size(); ++row)
+                {
+                    const double* x = X[row].data();
+                    double weight = u[row];
+
+                    for (std::size_t feature = first; feature < last; ++feature)
+                    {
+                        result[feature] += weight * x[feature];
+                    }
+                }
+            }, Threads, 256);
+        }
+
+        void LinearRegression::_transposedProduct(const data::Sparse& X, const std::vector<double>& u, std::vector<double>& result) const
+        {
+            /*
+                The rows are cut into blocks whose number depends on the size of X only (at least 8 non zero values per feature
+                in a block, so adding the blocks up costs less than filling them), every block is scattered into its own sums
+            */
+            const std::size_t minimumRows = 1024, maximumBlocks = 256, maximumValues = static_cast<std::size_t>(1) << 22;
+
+            std::size_t features = X.Cols, rows = X.Rows, values = X.Offsets[rows];
+            std::size_t blocks = std::min({ (rows + minimumRows - 1) / minimumRows, maximumBlocks, maximumValues / std::max(features, static_cast<std::size_t>(1)), values / std::max(8 * features, static_cast<std::size_t>(1)) });
+
+            blocks = std::max(blocks, static_cast<std::size_t>(1));
+
+            std::size_t blockRows = (rows + blocks - 1) / blocks;
+
+            std::vector<double> partial(blocks * features, 0);
+
+            utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t block = first; block < last; ++block)
+                {
+                    double* sums = partial.data() + block * features;
+
+                    for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
+                    {
+                        double weight = u[row];
+
+                        for (std::size_t value = X.Offsets[row]; value < X.Offsets[row + 1]; ++value)
+                        {
+                            sums[X.Indexes[value]] += weight * X.Values[value];
+                        }
+                    }
+                }
+            }, Threads);
+
+            result.assign(features, 0);
+
+            utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t block = 0; block < blocks; ++block)
+                {
+                    const double* sums = partial.data() + block * features;
+
+                    for (std::size_t feature = first; feature < last; ++feature)
+                    {
+                        result[feature] += sums[feature];
+                    }
+                }
+            }, Threads, 4096);
+        }
+
+        void LinearRegression::accumulate(const data::Storage& X, const data::Storage& y)
+        {
+            /*
+                See _accumulate()
+            */
+            try
+            {
+                if (X.size() != y.size()) throw std::runtime_error("<In function cmll::linear::LinearRegression::accumulate()>Error :  X has " + std::to_string(X.size()) + " rows but y has " + std::to_string(y.size()));
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            if (X.empty()) return;
+
+            _accumulate(X, y, X[0].size());
+        }
+
+        void LinearRegression::accumulate(data::BatchReader& reader, const std::size_t& outputs) // throws std::runtime_error
+        {
+            /*
+                Two batches take turns : while one is added (on Threads threads), the next one is read into the other.
+                The rows of a batch are used as they are : the first columns as features and the last outputs as y
+            */
+            data::Storage batch, nextBatch;
+            const data::Storage y;
+
+            bool more = reader.next(batch);
+
+            while (more)
+            {
+                std::future<bool> reading = std::async(std::launch::async, [&reader, &nextBatch]() { return reader.next(nextBatch); });
+
+                try
+                {
+                    if (batch[0].size() <= outputs) throw std::runtime_error("<In function cmll::linear::LinearRegression::accumulate()>Error :  Rows have " + std::to_string(batch[0].size()) + " columns, no feature is left after " + std::to_string(outputs) + " outputs");
+
+                    _accumulate(batch, y, batch[0].size() - outputs);
+                }
+                catch (const std::runtime_error& e)
+                {
+                    std::cerr << e.what() << '\n';
+                    reading.wait();
+                    return;
+                }
+
+                more = reading.get();
+                batch.swap(nextBatch);
+            }
+        }
+
+        void LinearRegression::begin() noexcept
+        {
+            _gram.clear();
+            _moment.clear();
+            _features = 0;
+            _outputs = 0;
+            _observations = 0;
+        }
+
+        void LinearRegression::finalize()
+        {
+            _solve(0);
+        }
+
+        void LinearRegression::merge(const LinearRegression& other)
+        {
+            /*
+                X^T X and X^T y of the union of two sets of observations are the sums of theirs
+            */
+            if (other._observations == 0) return;
+
+            try
+            {
+                if (_observations > 0 && (other._features != _features || other._outputs != _outputs)) throw std::runtime_error("<In function cmll::linear::LinearRegression::merge()>Error :  The models have " + std::to_string(_features) + " and " + std::to_string(other._features) + " features, " + std::to_string(_outputs) + " and " + std::to_string(other._outputs) + " outputs");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            if (_observations == 0)
+            {
+                _gram = other._gram;
+                _moment = other._moment;
+                _features = other._features;
+                _outputs = other._outputs;
+                _observations = other._observations;
+                return;
+            }
+
+            std::transform(_gram.begin(), _gram.end(), other._gram.begin(), _gram.begin(), std::plus<double>());
+            std::transform(_moment.begin(), _moment.end(), other._moment.begin(), _moment.begin(), std::plus<double>());
+
+            _observations += other._observations;
+        }
+
         void LinearRegression::model(const data::Storage& X, const data::Storage& y) noexcept
         {
             /*
-                This coefficient vector B_hat is calculated for which the residual sum of squares is minimum (RSS)
+                This coefficient vector B_hat is calculated for which the residual sum of squares is minimum (RSS)
+
+                To calculate B_hat normalized equation is used which is 
+
+                                    B_hat = ( X_T * X )^{-1} * X^{T} * y
+
+                Reference : Elements of statistical Learning  Page number 12, equation number 2.6.
+
+                X^T X and X^T y are added up over the rows of X (see _accumulate()), so neither X^T nor any other copy of X is made
+
+                With Solver CG or LSQR the normal equations are solved by products by X and X^T instead (see _fit())
+
+                Note :  It is assumed that X and y parameters have been passed through checks (cmll::utility::checks)
+
+            */
+            _fit(X, y, 0);
+        }
+
+        void LinearRegression::model(const data::Sparse& X, const data::Storage& y) noexcept
+        {
+            _fit(X, y, 0);
+        }
+
+        void LinearRegression::predict(const data::Storage &XTest, data::Storage &result) //throws std::runtime_error
+        {
+            /*
+                 The prediction is applied using the formula
+
+                 result = XTest*Coefficients
+
+                 Note : it is assumed that the X_test has passed utility checks and result is already resized to hold the predicted values
+
+                 If model is not fitted a std::runtime_error exception is thrown
+            */
+
+            try
+            {
+                if (!Coefficients.size()) throw std::runtime_error("Error : Model is not built. Run model() to fit the model.");
+
+                matrix::multiplication(XTest, Coefficients,result);
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << "<In function cmll::linear::Regression::predict()>" << e.what() << '\n';
+                throw e;
+            }
+
+        }
+
+        void LinearRegression::predict(const data::Sparse& XTest, data::Storage& result) //throws std::runtime_error
+        {
+            /*
+                result = XTest*Coefficients, one output at a time
+            */
+            try
+            {
+                if (!Coefficients.size()) throw std::runtime_error("Error : Model is not built. Run model() to fit the model.");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << "<In function cmll::linear::Regression::predict()>" << e.what() << '\n';
+                throw e;
+            }
+
+            std::size_t outputs = Coefficients[0].size();
+            std::vector<double> coefficients(Coefficients.size()), column;
+
+            result.assign(XTest.Rows, std::vector<double>(outputs));
+
+            for (std::size_t output = 0; output < outputs; ++output)
+            {
+                for (std::size_t feature = 0; feature < Coefficients.size(); ++feature)
+                {
+                    coefficients[feature] = Coefficients[feature][output];
+                }
+
+                _product(XTest, coefficients, column);
+
+                for (std::size_t row = 0; row < XTest.Rows; ++row)
+                {
+                    result[row][output] = column[row];
+                }
+            }
+        }
+
+        double LinearRegression::rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept
+        {
+            /*
+                This function uses the following formula for calculating RSS
+                RSS = sum_of_((y_true - y_pred)^ 2)
+            */
+            
+            data::Storage difference(y_true.size(), std::vector<double>(1));
+
+            
+            matrix::subtraction(y_true,y_pred,difference);
+
+            array::power(difference, 2);
+            
+            return array::sum(difference);
+
+
+        }
+
+        double LinearRegression::score(const data::Storage& y_pred, const data::Storage& y_true) noexcept
+        {
+            /*
+                This function uses the following formula for calculating R^square
+                R^2 = 1 - RSS/TSS
+             */
+            return (1 - (rss(y_pred, y_true) / (tss(y_true))));
+        }
+
+        double LinearRegression::tss(const data::Storage& y) noexcept
+        {
+            /*
+                This function uses the following formula for calculating TSS
+                TSS = sum_of_((y_true - y_true.mean())^2)
+            */
+
+            data::Storage difference(y.size(), std::vector<double>(1));
+            data::Storage yCopy = y;
+
+            
+            double mean = array::average(y);
+            array::subtract(yCopy, mean);
+            array::power(yCopy, 2);
+
+            return array::sum(yCopy);
+        }
+
+        /*
+            Members of Ridge Regression class
+        */
+        RidgeRegression::RidgeRegression(const double lambda, const std::size_t& threads) : LinearRegression(threads)
+        {
+            /*
+                If no lambda is provided the default lambda constant defined in cmll::linear::defaults::LAMBDA is used
+            */
+            Lambda = lambda;
+        }
+
+        void RidgeRegression::finalize()
+        {
+            _solve(Lambda);
+        }
+
+        void RidgeRegression::fitPath(const data::Storage& X, const data::Storage& y, const std::vector<double>& lambdas) noexcept
+        {
+            /*
+                The steps followed by the function are as follows
+
+                1) X^T X and X^T y are added up (see _accumulate()) and X^T X = V diag(e) V^T is decomposed (see matrix::eigen())
+                2) u = V^T X^T y. For every penalty b = V (u / (e + lambda)) and, with y^T y,
+
+                            RSS = y^T y - sum_k u_k^2 (e_k + 2 lambda) / (e_k + lambda)^2        trace(H) = sum_k e_k / (e_k + lambda)
+
+                3) One pass over blocks of rows (their number only depends on the number of rows) : z = V^T x_i, then for every penalty
+                   h_ii = sum_k z_k^2 / (e_k + lambda) and the fitted value sum_k z_k u_k / (e_k + lambda). The errors of the blocks
+                   are added in block order, so the result is the same on any number of threads
+            */
+            try
+            {
+                if (X.empty() || X.size() != y.size()) throw std::runtime_error("<In function cmll::linear::RidgeRegression::fitPath()>Error :  X has " + std::to_string(X.size()) + " rows but y has " + std::to_string(y.size()));
+
+                if (lambdas.empty()) throw std::runtime_error("<In function cmll::linear::RidgeRegression::fitPath()>Error :  No penalty is given");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            std::size_t rows = X.size(), features = X[0].size(), outputs = y[0].size(), count = lambdas.size();
+
+            begin();
+            _accumulate(X, y, features);
+
+            data::Storage gram(features, std::vector<double>(features)), values, vectors;
+
+            for (std::size_t i = 0; i < features; ++i)
+            {
+                for (std::size_t j = i; j < features; ++j)
+                {
+                    gram[i][j] = gram[j][i] = _gram[i * features + j];
+                }
+            }
+
+            matrix::eigen(gram, values, vectors);
+
+            // Rounding can leave the eigen values of a singular X^T X slightly negative
+            std::vector<double> e(features), u(features * outputs, 0), squares(outputs, 0);
+
+            for (std::size_t k = 0; k < features; ++k)
+            {
+                e[k] = std::max(values[k][0], 0.0);
+            }
+
+            for (std::size_t j = 0; j < features; ++j)
+            {
+                for (std::size_t k = 0; k < features; ++k)
+                {
+                    for (std::size_t output = 0; output < outputs; ++output)
+                    {
+                        u[k * outputs + output] += vectors[j][k] * _moment[j * outputs + output];
+                    }
+                }
+            }
+
+            for (const std::vector<double>& observation : y)
+            {
+                for (std::size_t output = 0; output < outputs; ++output)
+                {
+                    squares[output] += observation[output] * observation[output];
+                }
+            }
+
+            Lambdas = lambdas;
+            Path.assign(count, data::Storage(features, std::vector<double>(outputs, 0)));
+            Gcv.assign(count, 0);
+            LeaveOneOut.assign(count, 0);
+
+            double n = static_cast<double>(rows);
+
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                double lambda = lambdas[index], trace = 0;
+
+                for (std::size_t k = 0; k < features; ++k)
+                {
+                    if (e[k] + lambda > 0) trace += e[k] / (e[k] + lambda);
+                }
+
+                for (std::size_t output = 0; output < outputs; ++output)
+                {
+                    double rss = squares[output];
+
+                    for (std::size_t k = 0; k < features; ++k)
+                    {
+                        if (e[k] + lambda <= 0) continue;
+
+                        double weight = u[k * outputs + output] / (e[k] + lambda);
+
+                        rss -= weight * u[k * outputs + output] * (e[k] + 2 * lambda) / (e[k] + lambda);
+
+                        for (std::size_t j = 0; j < features; ++j)
+                        {
+                            Path[index][j][output] += vectors[j][k] * weight;
+                        }
+                    }
+
+                    Gcv[index] += (std::max(rss, 0.0) / n) / ((1 - trace / n) * (1 - trace / n)) / static_cast<double>(outputs);
+                }
+            }
+
+            const std::size_t minimumRows = 1024, maximumBlocks = 256;
+
+            std::size_t blocks = std::max(std::min((rows + minimumRows - 1) / minimumRows, maximumBlocks), static_cast<std::size_t>(1));
+            std::size_t blockRows = (rows + blocks - 1) / blocks;
+
+            std::vector<double> partial(blocks * count, 0);
+
+            utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+            {
+                std::vector<double> z(features), fitted(outputs);
+
+                for (std::size_t block = first; block < last; ++block)
+                {
+                    double* errors = partial.data() + block * count;
+
+                    for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
+                    {
+                        std::fill(z.begin(), z.end(), 0.0);
+
+                        for (std::size_t j = 0; j < features; ++j)
+                        {
+                            double x = X[row][j];
+
+                            if (x == 0) continue;
+
+                            for (std::size_t k = 0; k < features; ++k)
+                            {
+                                z[k] += x * vectors[j][k];
+                            }
+                        }
+
+                        for (std::size_t index = 0; index < count; ++index)
+                        {
+                            double lambda = lambdas[index], leverage = 0;
+
+                            std::fill(fitted.begin(), fitted.end(), 0.0);
+
+                            for (std::size_t k = 0; k < features; ++k)
+                            {
+                                if (e[k] + lambda <= 0) continue;
+
+                                double weight = z[k] / (e[k] + lambda);
+
+                                leverage += weight * z[k];
+
+                                for (std::size_t output = 0; output < outputs; ++output)
+                                {
+                                    fitted[output] += weight * u[k * outputs + output];
+                                }
+                            }
+
+                            for (std::size_t output = 0; output < outputs; ++output)
+                            {
+                                double error = (y[row][output] - fitted[output]) / (1 - leverage);
+
+                                errors[index] += error * error;
+                            }
+                        }
+                    }
+                }
+            }, Threads);
+
+            for (std::size_t block = 0; block < blocks; ++block)
+            {
+                for (std::size_t index = 0; index < count; ++index)
+                {
+                    LeaveOneOut[index] += partial[block * count + index];
+                }
+            }
+
+            std::size_t best = 0;
+
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                LeaveOneOut[index] /= n * static_cast<double>(outputs);
+
+                if (LeaveOneOut[index] < LeaveOneOut[best]) best = index;
+            }
+
+            Lambda = lambdas[best];
+            Coefficients = Path[best];
+        }
+
+        void RidgeRegression::model(const data::Storage& X, const data::Storage& y) noexcept
+        {
+            /*
+
+             This model is based on the linear regression (See LinearRegression::model() for information about model) with an additional penalty for the coefficients.
+
+             The residual sum of squares for ridge regression is given by
+
+                           RSS(lambda) = (y-XB)^{T}(y-XB) + lambdaB^{T}B
+
+             B can be calculated using
+
+                           B = (X^{T}X+lambdaI)^{-1}X^{T}y
+
+             Alternatively if a linear regression model is built. THe ridge regression coefficients can be found using
+
+                           B = B_LinearRegression/(1+lambda)
+
+             With Solver CG or LSQR the penalty is added to the products instead (see LinearRegression::_fit())
+
+            */
+            _fit(X, y, Lambda);
+        }
+
+        void RidgeRegression::model(const data::Sparse& X, const data::Storage& y) noexcept
+        {
+            _fit(X, y, Lambda);
+        }
+
+        /*
+            RidgeClassifier class members
+        */
+
+        RidgeClassifier::RidgeClassifier(const double lambda, ClassificationType method)
+        {
+            /*
+                Initializing the penalty and the type of classification
+            */
+            
+            Lambda = lambda;
+
+            Method = method;
+
+            Classes = 2;
+        }
+
+        void RidgeClassifier::_binarizer(data::Storage &yNew) noexcept
+        {   
+            /*
+                Function converts the Y into a binary output scenario.
+
+                For example  [0,1,2] are changed to [ [1,-1,-1], [-1,1,-1],[-1,-1,1] ]
+            */
+            
+            for (data::Storage::size_type row = 0; row < Y.size(); ++row)
+            {               
+                for (std::vector<double>::size_type col = 0; col < Y[row].size(); ++col)
+                {
+                    yNew[row][static_cast<data::Storage::size_type>(Y[row][col])] = 1;
+                }
+            }
+        }
+
+        void RidgeClassifier::_encoder(const double value) noexcept
+        {
+            /*
+                Function iterates through all elements of y. sets those elements to -1 which are equal to value
+            */
+            
+            for (data::Storage::size_type row = 0; row < Y.size(); ++row)
+            {
+                for (std::vector<double>::size_type col = 0; col < Y[0].size(); ++col)
+                {
+                    if (Y[row][col] == value)
+                    {
+                        Y[row][col] = -1;
+                    }
+                }
+            }
+        }
+
+        void RidgeClassifier::_decoder(const double value) noexcept
+        {
+            /*
+                Function iterates through all elements of y. sets those elements to value which were set to -1
+            */
+            
+            for (data::Storage::size_type row = 0; row < Y.size(); ++row)
+            {
+                for (std::vector<double>::size_type col = 0; col < Y[0].size(); ++col)
+                {
+                    if (Y[row][col] == -1)
+                    {
+                        Y[row][col] = value;
+                    }
+                }
+            }
+        }
+
+        bool RidgeClassifier::_sign(const double value) const
+        {
+            /*
+                Function returns 1 if value is grater than 0 else 0;
+            */
+            
+            return (value > 0) ? 1 : 0;
+        }
+
+        void RidgeClassifier::_scores(const data::Storage& XTest, const std::size_t& first, const std::size_t& last, double* scores) const
+        {
+            std::size_t features = Coefficients.size(), classes = Coefficients[0].size();
+
+            std::fill(scores, scores + (last - first) * classes, 0.0);
+
+            for (std::size_t feature = 0; feature < features; ++feature)
+            {
+                const double* w = Coefficients[feature].data();
+
+                for (std::size_t row = first; row < last; ++row)
+                {
+                    double x = XTest[row][feature];
+                    double* score = scores + (row - first) * classes;
+
+                    for (std::size_t type = 0; type < classes; ++type)
+                    {
+                        score[type] += x * w[type];
+                    }
+                }
+            }
+        }
+
+        void RidgeClassifier::model(const data::Storage& X, const data::Storage& y) noexcept
+        {
+            /*
+                The labels are converted into -1 and 1 
+                and the regression model is built. 
+
+                For multi class setting, one vs all (one-vs-rest or ova or o.v.r) approach is followed)
+            */
+
+            Y = y;
+            
+            if (Method == ClassificationType::BINARY)
+            {
+                _encoder(0);
+                RidgeRegression::model(X,Y);
+                _decoder(0);
+            }
+
+            else if (Method == ClassificationType::MULTI_CLASS)
+            {
+                Classes = array::unique(Y);
+
+                data::Storage yLabelled(Y.size(), std::vector<double>(Classes,-1));
+               
+				_binarizer(yLabelled);
+
+				RidgeRegression::model(X, yLabelled);
+
+            }
+        }
+
+        void RidgeClassifier::predict(const data::Storage& XTest, data::Storage& result) const // throws std::runtime_error
+        {
+            /*
+                For binary class prediction the label is the sign of the score (the labels were encoded as -1 and 1)
+
+                For multi class prediction the label is the class of the largest score (one vs all)
+
+                Blocks of 64 rows are scored into a buffer of the thread and labelled at once
+
+                A std::runtime_error is thrown if the model is not built before predicting
+            */
+            const std::size_t blockRows = 64;
+
+            try
+            {
+                if (!Coefficients.size()) throw std::runtime_error("<In function cmll::linear::RidgeClassifier::predict()>Error : Model is not built yet. Use model() to fit the model");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            std::size_t rows = XTest.size(), classes = Coefficients[0].size(), blocks = (rows + blockRows - 1) / blockRows;
+
+            result.resize(rows);
+
+            utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+            {
+                std::vector<double> scores(blockRows * classes);
+
+                for (std::size_t block = first; block < last; ++block)
+                {
+                    std::size_t firstRow = block * blockRows, lastRow = std::min(rows, firstRow + blockRows);
+
+                    _scores(XTest, firstRow, lastRow, scores.data());
+
+                    for (std::size_t row = firstRow; row < lastRow; ++row)
+                    {
+                        const double* score = scores.data() + (row - firstRow) * classes;
+
+                        double label = (Method == ClassificationType::MULTI_CLASS) ? static_cast<double>(std::max_element(score, score + classes) - score) : _sign(score[0]);
+
+                        result[row].assign(1, label);
+                    }
+                }
+            }, Threads);
+        }
+
+        void RidgeClassifier::predictScores(const data::Storage& XTest, data::Storage& scores) const // throws std::runtime_error
+        {
+            const std::size_t blockRows = 64;
+
+            try
+            {
+                if (!Coefficients.size()) throw std::runtime_error("<In function cmll::linear::RidgeClassifier::predictScores()>Error : Model is not built yet. Use model() to fit the model");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            std::size_t rows = XTest.size(), classes = Coefficients[0].size(), blocks = (rows + blockRows - 1) / blockRows;
+
+            scores.resize(rows);
+
+            utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+            {
+                std::vector<double> buffer(blockRows * classes);
+
+                for (std::size_t block = first; block < last; ++block)
+                {
+                    std::size_t firstRow = block * blockRows, lastRow = std::min(rows, firstRow + blockRows);
+
+                    _scores(XTest, firstRow, lastRow, buffer.data());
+
+                    for (std::size_t row = firstRow; row < lastRow; ++row)
+                    {
+                        scores[row].assign(buffer.begin() + (row - firstRow) * classes, buffer.begin() + (row - firstRow + 1) * classes);
+                    }
+                }
+            }, Threads);
+        }
+
+        double RidgeClassifier::score(const data::Storage& y_pred, const data::Storage& y) noexcept
+        {
+            
+            /*
+                Function uses standard indicator function for calculating accuracy.
+
+                Note :  Y_pred and y are supposed to be in correct order of NX1.
+            */
+            
+            double count = 0;
+            data::Storage::size_type observation = y.size();
+
+            for (data::Storage::size_type value = 0; value < observation; ++value)
+            {
+                if (y[value][0] == y_pred[value][0]) ++count;
+            }
+
+            return static_cast<double>(count / observation);
+        }
+
+        /*
+            ElasticNet class members
+        */
+
+        ElasticNet::ElasticNet(const double lambda, const double l1Ratio, const std::size_t& threads) : LinearRegression(threads)
+        {
+            Lambda = lambda;
+            L1Ratio = l1Ratio;
+            Selection = SelectionType::CYCLIC;
+        }
+
+        std::size_t ElasticNet::_descend(const std::vector<double>& squares, const double& lambda, const std::vector<std::size_t>& set, const Correlation& correlation, const Update& update, std::mt19937& generator, std::vector<double>& b) const
+        {
+            /*
+                The minimum over b_j alone, the others fixed, is
 
-                To calculate B_hat normalized equation is used which is 
+                        b_j = S( x_j^T r / N + (x_j^T x_j / N) b_j , lambda L1Ratio ) / ( x_j^T x_j / N + lambda (1 - L1Ratio) )
 
-                                    B_hat = ( X_T * X )^{-1} * X^{T} * y
+                where S(z, t) = sign(z) max(|z| - t, 0) is the soft threshold
+            */
+            double threshold = lambda * L1Ratio, ridge = lambda * (1 - L1Ratio);
 
-                Reference : Elements of statistical Learning  Page number 12, equation number 2.6.
+            std::vector<std::size_t> all(set), active;
+            std::size_t passes = 0;
 
-                Note :  It is assumed that X and y parameters have been passed through checks (cmll::utility::checks)
+            auto pass = [&](std::vector<std::size_t>& features)
+            {
+                if (Selection == SelectionType::RANDOM) std::shuffle(features.begin(), features.end(), generator);
 
-            */
+                double largestStep = 0, largest = 0;
 
-            
-            std::vector<double>::size_type features = X[0].size(),ySize = y[0].size();
-            data::Storage::size_type observations = X.size();
-            
+                for (const std::size_t& feature : features)
+                {
+                    if (squares[feature] + ridge <= 0) continue;
 
-            // Initializations
-            data::Storage X_t(features, std::vector<double>(observations));
-            data::Storage X_t_mul_y(features, std::vector<double>(ySize));
-            data::Storage X_t_mul_X(features, std::vector<double>(features));
-            
-            // Calculating the formula in steps
-            matrix::transpose(X,X_t);
-            matrix::multiplication(X_t, y,X_t_mul_y);
-            matrix::multiplication(X_t, X,X_t_mul_X);
+                    double z = correlation(feature) + squares[feature] * b[feature];
+                    double next = (std::abs(z) > threshold) ? (z - std::copysign(threshold, z)) / (squares[feature] + ridge) : 0;
+                    double step = next - b[feature];
 
-            
-            /*
-                Removing allocated memory since it is not required and as have to initialize more in next step
-                Debatable whether this step is useful or not but since the time complexity of these is o(n) It doesn't matter.
-            */
-            X_t.clear();
-            X_t.shrink_to_fit();
+                    if (step != 0)
+                    {
+                        update(feature, step);
+                        b[feature] = next;
+                    }
 
-            
-            // for L and U decomposition to find inverse
-            data::Storage::size_type X_t_size = X_t_mul_X.size();
+                    largestStep = std::max(largestStep, std::abs(step));
+                    largest = std::max(largest, std::abs(next));
+                }
 
-            
-            data::Storage l(X_t_size, std::vector<double>(X_t_size));
-            data::Storage u(X_t_size, std::vector<double>(X_t_size));
-            
-            matrix::lu(X_t_mul_X, l, u);
-            matrix::inverse(l, u, X_t_mul_X);
+                ++passes;
 
+                return largestStep <= Tolerance * largest;
+            };
 
-            /*
-                Again, Removing allocated memory since it is not required and as have to initialize more in next step
-                Debatable whether this step is useful or not but since the time complexity of these is o(n) It doesn't matter.
-            */
-            l.clear();
-            l.shrink_to_fit();
-            u.clear();
-            u.shrink_to_fit();
-        
-            // Final step
-            Coefficients.resize(features,std::vector<double>(ySize));
-            matrix::multiplication(X_t_mul_X, X_t_mul_y,Coefficients);
-        }
+            while (passes < MaximumIterations)
+            {
+                if (pass(all)) break;
 
-        void LinearRegression::predict(const data::Storage &XTest, data::Storage &result) //throws std::runtime_error
-        {
-            /*
-                 The prediction is applied using the formula
+                active.clear();
 
-                 result = XTest*Coefficients
+                for (const std::size_t& feature : set)
+                {
+                    if (b[feature] != 0) active.emplace_back(feature);
+                }
 
-                 Note : it is assumed that the X_test has passed utility checks and result is already resized to hold the predicted values
+                while (passes < MaximumIterations && !pass(active));
+            }
 
-                 If model is not fitted a std::runtime_error exception is thrown
-            */
+            return passes;
+        }
 
+        void ElasticNet::_fit(const std::size_t& count, const double& ratio)
+        {
+            /*
+                The upper triangle of X^T X is completed and scaled by 1 / N. The correlations c = X^T y / N - (X^T X / N) b are
+                kept for every feature : moving b_j by delta subtracts delta times row j of X^T X / N, O(features) whatever N is
+            */
             try
             {
-                if (!Coefficients.size()) throw std::runtime_error("Error : Model is not built. Run model() to fit the model.");
-
-                matrix::multiplication(XTest, Coefficients,result);
+                if (_observations == 0) throw std::runtime_error("<In function cmll::linear::ElasticNet::finalize()>Error :  No observation has been added. Use accumulate() before finalize()");
             }
             catch (const std::runtime_error& e)
             {
-                std::cerr << "<In function cmll::linear::Regression::predict()>" << e.what() << '\n';
-                throw e;
+                std::cerr << e.what() << '\n';
+                return;
             }
 
-        }
+            std::size_t features = _features, outputs = _outputs;
+            double scale = 1 / static_cast<double>(_observations), largest = 0;
 
-        double LinearRegression::rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept
-        {
-            /*
-                This function uses the following formula for calculating RSS
-                RSS = sum_of_((y_true - y_pred)^ 2)
-            */
-            
-            data::Storage difference(y_true.size(), std::vector<double>(1));
+            std::vector<double> gram(features * features), squares(features);
 
-            
-            matrix::subtraction(y_true,y_pred,difference);
+            for (std::size_t i = 0; i < features; ++i)
+            {
+                for (std::size_t j = i; j < features; ++j)
+                {
+                    gram[i * features + j] = gram[j * features + i] = _gram[i * features + j] * scale;
+                }
 
-            array::power(difference, 2);
-            
-            return array::sum(difference);
+                squares[i] = gram[i * features + i];
 
+                for (std::size_t output = 0; output < outputs; ++output)
+                {
+                    largest = std::max(largest, std::abs(_moment[i * outputs + output]) * scale);
+                }
+            }
 
-        }
+            bool warm = WarmStart && Coefficients.size() == features && !Coefficients.empty() && Coefficients[0].size() == outputs;
 
-        double LinearRegression::score(const data::Storage& y_pred, const data::Storage& y_true) noexcept
-        {
-            /*
-                This function uses the following formula for calculating R^square
-                R^2 = 1 - RSS/TSS
-             */
-            return (1 - (rss(y_pred, y_true) / (tss(y_true))));
-        }
+            data::Storage start = warm ? Coefficients : data::Storage(features, std::vector<double>(outputs, 0));
 
-        double LinearRegression::tss(const data::Storage& y) noexcept
-        {
-            /*
-                This function uses the following formula for calculating TSS
-                TSS = sum_of_((y_true - y_true.mean())^2)
-            */
+            largest = _lambdas(largest, count, ratio);
 
-            data::Storage difference(y.size(), std::vector<double>(1));
-            data::Storage yCopy = y;
+            Coefficients.assign(features, std::vector<double>(outputs));
+            Path.assign(count, data::Storage(features, std::vector<double>(outputs)));
+            Iterations = 0;
 
-            
-            double mean = array::average(y);
-            array::subtract(yCopy, mean);
-            array::power(yCopy, 2);
+            std::vector<double> b(features), c(features);
 
-            return array::sum(yCopy);
+            for (std::size_t output = 0; output < outputs; ++output)
+            {
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    b[feature] = start[feature][output];
+                }
+
+                for (std::size_t i = 0; i < features; ++i)
+                {
+                    c[i] = _moment[i * outputs + output] * scale - std::inner_product(b.begin(), b.end(), gram.begin() + i * features, 0.0);
+                }
+
+                _path(squares, largest, [&](std::vector<double>& result) { result = c; },
+                      [&](const std::size_t& feature) { return c[feature]; },
+                      [&](const std::size_t& feature, const double& delta)
+                      {
+                          const double* row = gram.data() + feature * features;
+
+                          for (std::size_t i = 0; i < features; ++i)
+                          {
+                              c[i] -= delta * row[i];
+                          }
+                      }, output, b);
+            }
         }
 
-        /*
-            Members of Ridge Regression class
-        */
-        RidgeRegression::RidgeRegression(const double lambda)
+        void ElasticNet::_fit(const std::size_t& count, const double& ratio, const std::size_t& rows, const std::size_t& features, const Column& column, const data::Storage& y)
         {
             /*
-                If no lambda is provided the default lambda constant defined in cmll::linear::defaults::LAMBDA is used
+                The residual r = y - Xb is kept : the correlation of feature j is a pass over its column, and moving b_j by delta
+                subtracts delta x_j from r. The correlations of every feature (strong rule and optimality checks) are found in parallel
             */
-            Lambda = lambda;
-        }
+            std::size_t outputs = y[0].size();
+            double scale = 1 / static_cast<double>(std::max(rows, static_cast<std::size_t>(1))), largest = 0;
 
-        void RidgeRegression::model(const data::Storage& X, const data::Storage& y) noexcept
-        {
-            /*
+            std::vector<double> residual(rows), squares(features), c(features);
 
-             This model is based on the linear regression (See LinearRegression::model() for information about model) with an additional penalty for the coefficients.
+            auto dot = [&](const std::size_t& feature, const std::vector<double>& u)
+            {
+                const std::size_t* indexes = nullptr;
+                const double* values = nullptr;
+                std::size_t size = column(feature, indexes, values);
+                double sum = 0;
 
-             The residual sum of squares for ridge regression is given by
+                for (std::size_t value = 0; value < size; ++value)
+                {
+                    sum += values[value] * u[(indexes == nullptr) ? value : indexes[value]];
+                }
 
-                           RSS(lambda) = (y-XB)^{T}(y-XB) + lambdaB^{T}B
+                return sum * scale;
+            };
 
-             B can be calculated using
+            auto correlations = [&](std::vector<double>& result)
+            {
+                result.resize(features);
 
-                           B = (X^{T}X+lambdaI)^{-1}X^{T}y
+                utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t feature = first; feature < last; ++feature)
+                    {
+                        result[feature] = dot(feature, residual);
+                    }
+                }, Threads, 16);
+            };
 
-             Alternatively if a linear regression model is built. THe ridge regression coefficients can be found using
+            auto update = [&](const std::size_t& feature, const double& delta)
+            {
+                const std::size_t* indexes = nullptr;
+                const double* values = nullptr;
+                std::size_t size = column(feature, indexes, values);
 
-                           B = B_LinearRegression/(1+lambda)
+                for (std::size_t value = 0; value < size; ++value)
+                {
+                    residual[(indexes == nullptr) ? value : indexes[value]] -= delta * values[value];
+                }
+            };
 
-            */
+            utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t feature = first; feature < last; ++feature)
+                {
+                    const std::size_t* indexes = nullptr;
+                    const double* values = nullptr;
+                    std::size_t size = column(feature, indexes, values);
 
-            std::vector<double>::size_type features = X[0].size(), ySize = y[0].size();;
-            data::Storage::size_type observations = X.size();
+                    squares[feature] = std::inner_product(values, values + size, values, 0.0) * scale;
+                }
+            }, Threads, 16);
 
-            data::Storage X_t(features, std::vector<double>(observations));
-            data::Storage X_t_mul_X(features, std::vector<double>(features));
-            data::Storage X_t_mul_y(features, std::vector<double>(ySize));
-            data::Storage lamda_I(features, std::vector<double>(1, Lambda));
-            data::Storage X_t_mul_X_plus_lamda_I(features, std::vector<double>(features));
+            for (std::size_t output = 0; output < outputs; ++output)
+            {
+                for (std::size_t row = 0; row < rows; ++row)
+                {
+                    residual[row] = y[row][output];
+                }
 
-            matrix::transpose(X, X_t);
-            matrix::multiplication(X_t, y, X_t_mul_y);
-            matrix::multiplication(X_t, X, X_t_mul_X);
+                correlations(c);
 
-            
-            matrix::diagonalAddition(X_t_mul_X, lamda_I, X_t_mul_X_plus_lamda_I);
-           
-            /*
-                Removing allocated memory since it is not required and as have to initialize more in next step
-                Debatable whether this step is useful or not but since the time complexity of these is o(n) It doesn't matter.
-            */
-            X_t.clear();
-            X_t.shrink_to_fit();
-            X_t_mul_X.clear();
-            X_t_mul_X.shrink_to_fit();
-            lamda_I.clear();
-            lamda_I.shrink_to_fit();
+                for (const double& value : c) largest = std::max(largest, std::abs(value));
+            }
 
-            data::Storage l(features, std::vector<double>(features));
-            data::Storage u(features, std::vector<double>(features));
+            bool warm = WarmStart && Coefficients.size() == features && !Coefficients.empty() && Coefficients[0].size() == outputs;
 
-            matrix::lu(X_t_mul_X_plus_lamda_I, l, u);
-            matrix::inverse(l, u, X_t_mul_X_plus_lamda_I);
-            
-            Coefficients.resize(features, std::vector<double>(ySize));
-            matrix::multiplication(X_t_mul_X_plus_lamda_I, X_t_mul_y, Coefficients);
-        }
+            data::Storage start = warm ? Coefficients : data::Storage(features, std::vector<double>(outputs, 0));
 
-        /*
-            RidgeClassifier class members
-        */
+            largest = _lambdas(largest, count, ratio);
 
-        RidgeClassifier::RidgeClassifier(const double lambda, ClassificationType method)
+            Coefficients.assign(features, std::vector<double>(outputs));
+            Path.assign(count, data::Storage(features, std::vector<double>(outputs)));
+            Iterations = 0;
+
+            std::vector<double> b(features);
+
+            for (std::size_t output = 0; output < outputs; ++output)
+            {
+                for (std::size_t row = 0; row < rows; ++row)
+                {
+                    residual[row] = y[row][output];
+                }
+
+                for (std::size_t feature = 0; feature < features; ++feature)
+                {
+                    b[feature] = start[feature][output];
+
+                    if (b[feature] != 0) update(feature, b[feature]);
+                }
+
+                _path(squares, largest, correlations, [&](const std::size_t& feature) { return dot(feature, residual); }, update, output, b);
+            }
+        }
+
+        double ElasticNet::_lambdas(const double& largest, const std::size_t& count, const double& ratio)
         {
             /*
-                Initializing the penalty and the type of classification
+                With b = 0 the optimality conditions hold as long as |x_j^T y| / N <= lambda L1Ratio for every feature.
+                A ridge penalty (L1Ratio 0) never zeroes the coefficients, so the path then starts as if L1Ratio were 0.001
             */
-            
-            Lambda = lambda;
+            double maximum = largest / std::max(L1Ratio, 0.001);
 
-            Method = method;
+            if (count == 0)
+            {
+                Lambdas.assign(1, Lambda);
+                return std::max(maximum, Lambda);
+            }
 
-            Classes = 2;
+            Lambdas.resize(count);
+
+            for (std::size_t index = 0; index < count; ++index)
+            {
+                Lambdas[index] = (count == 1) ? maximum : maximum * std::pow(ratio, static_cast<double>(index) / static_cast<double>(count - 1));
+            }
+
+            return maximum;
         }
 
-        void RidgeClassifier::_binarizer(data::Storage &yNew) noexcept
-        {   
-            /*
-                Function converts the Y into a binary output scenario.
+        void ElasticNet::_path(const std::vector<double>& squares, const double& largest, const Correlations& correlations, const Correlation& correlation, const Update& update, const std::size_t& output, std::vector<double>& b)
+        {
+            std::size_t features = squares.size();
+            std::mt19937 generator(Seed);
 
-                For example  [0,1,2] are changed to [ [1,-1,-1], [-1,1,-1],[-1,-1,1] ]
-            */
-            
-            for (data::Storage::size_type row = 0; row < Y.size(); ++row)
-            {               
-                for (std::vector<double>::size_type col = 0; col < Y[row].size(); ++col)
+            std::vector<double> c(features);
+            std::vector<char> strong(features);
+            std::vector<std::size_t> set;
+            double previous = largest;
+            bool converged = true;
+
+            for (std::size_t index = 0; index < Lambdas.size(); ++index)
+            {
+                double lambda = Lambdas[index], bound = L1Ratio * (2 * lambda - previous);
+                std::size_t passes = 0;
+
+                correlations(c);
+                set.clear();
+
+                for (std::size_t feature = 0; feature < features; ++feature)
                 {
-                    yNew[row][static_cast<data::Storage::size_type>(Y[row][col])] = 1;
+                    strong[feature] = (b[feature] != 0 || std::abs(c[feature]) >= bound);
+
+                    if (strong[feature]) set.emplace_back(feature);
+                }
+
+                while (true)
+                {
+                    passes += _descend(squares, lambda, set, correlation, update, generator, b);
+
+                    if (passes >= MaximumIterations) break;
+
+                    correlations(c);
+
+                    bool violated = false;
+
+                    for (std::size_t feature = 0; feature < features; ++feature)
+                    {
+                        if (!strong[feature] && std::abs(c[feature]) > L1Ratio * lambda)
+                        {
+                            strong[feature] = true;
+                            set.emplace_back(feature);
+                            violated = true;
+                        }
+                    }
+
+                    if (!violated) break;
+                }
+
+                converged = converged && passes < MaximumIterations;
+                Iterations += passes;
+
+                if (index < Path.size())
+                {
+                    for (std::size_t feature = 0; feature < features; ++feature)
+                    {
+                        Path[index][feature][output] = b[feature];
+                    }
                 }
+
+                previous = lambda;
+            }
+
+            for (std::size_t feature = 0; feature < features; ++feature)
+            {
+                Coefficients[feature][output] = b[feature];
+            }
+
+            if (!converged)
+            {
+                std::cerr << "<In function cmll::linear::ElasticNet::model()> Warning : Coordinate descent did not converge at 'Maximum iterations : " << MaximumIterations << "'\n";
             }
         }
 
-        void RidgeClassifier::_encoder(const double value) noexcept
+        void ElasticNet::finalize()
+        {
+            _fit(0, 0);
+        }
+
+        void ElasticNet::fitPath(const data::Storage& X, const data::Storage& y, const std::size_t& count, const double& ratio) noexcept
         {
             /*
-                Function iterates through all elements of y. sets those elements to -1 which are equal to value
+                With at least as many observations as features X^T X is formed (O(N features^2) once, then every update costs O(features)).
+                Otherwise X is copied column by column, so a column is contiguous for the residual updates
             */
-            
-            for (data::Storage::size_type row = 0; row < Y.size(); ++row)
+            try
             {
-                for (std::vector<double>::size_type col = 0; col < Y[0].size(); ++col)
+                if (X.empty() || X.size() != y.size()) throw std::runtime_error("<In function cmll::linear::ElasticNet::fitPath()>Error :  X has " + std::to_string(X.size()) + " rows but y has " + std::to_string(y.size()));
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            std::size_t rows = X.size(), features = X[0].size();
+
+            if (rows >= features)
+            {
+                begin();
+                _accumulate(X, y, features);
+                _fit(count, ratio);
+                return;
+            }
+
+            std::vector<double> columns(features * rows);
+
+            utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t row = 0; row < rows; ++row)
                 {
-                    if (Y[row][col] == value)
+                    for (std::size_t feature = first; feature < last; ++feature)
                     {
-                        Y[row][col] = -1;
+                        columns[feature * rows + row] = X[row][feature];
                     }
                 }
-            }
+            }, Threads, 64);
+
+            _fit(count, ratio, rows, features, [&](const std::size_t& feature, const std::size_t*& indexes, const double*& values)
+            {
+                indexes = nullptr;
+                values = columns.data() + feature * rows;
+                return rows;
+            }, y);
         }
 
-        void RidgeClassifier::_decoder(const double value) noexcept
+        void ElasticNet::fitPath(const data::Sparse& X, const data::Storage& y, const std::size_t& count, const double& ratio) noexcept
         {
             /*
-                Function iterates through all elements of y. sets those elements to value which were set to -1
+                The columns are gathered into compressed sparse columns (the observations of a column stay in increasing order)
             */
-            
-            for (data::Storage::size_type row = 0; row < Y.size(); ++row)
+            try
             {
-                for (std::vector<double>::size_type col = 0; col < Y[0].size(); ++col)
-                {
-                    if (Y[row][col] == -1)
-                    {
-                        Y[row][col] = value;
-                    }
+                if (X.Offsets.size() != X.Rows + 1 || y.size() != X.Rows) throw std::runtime_error("<In function cmll::linear::ElasticNet::fitPath()>Error :  X has " + std::to_string(X.Rows) + " rows and " + std::to_string(X.Offsets.size()) + " offsets, y has " + std::to_string(y.size()) + " rows");
+            }
+            catch (const std::runtime_error& e)
+            {
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            std::size_t values = X.Offsets[X.Rows];
+
+            std::vector<std::size_t> offsets(X.Cols + 1, 0), rows(values);
+            std::vector<double> columns(values);
+
+            for (std::size_t value = 0; value < values; ++value)
+            {
+                ++offsets[X.Indexes[value] + 1];
+            }
+
+            std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+            std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+
+            for (std::size_t row = 0; row < X.Rows; ++row)
+            {
+                for (std::size_t value = X.Offsets[row]; value < X.Offsets[row + 1]; ++value)
+                {
+                    std::size_t position = next[X.Indexes[value]]++;
+
+                    rows[position] = row;
+                    columns[position] = X.Values[value];
                 }
             }
+
+            _fit(count, ratio, X.Rows, X.Cols, [&](const std::size_t& feature, const std::size_t*& indexes, const double*& result)
+            {
+                indexes = rows.data() + offsets[feature];
+                result = columns.data() + offsets[feature];
+                return offsets[feature + 1] - offsets[feature];
+            }, y);
         }
 
-        bool RidgeClassifier::_sign(const double value) const
+        void ElasticNet::model(const data::Storage& X, const data::Storage& y) noexcept
         {
-            /*
-                Function returns 1 if value is grater than 0 else 0;
-            */
-            
-            return (value > 0) ? 1 : 0;
+            fitPath(X, y, 0);
         }
 
-        void RidgeClassifier::_assingSign(data::Storage& vector) noexcept
+        void ElasticNet::model(const data::Sparse& X, const data::Storage& y) noexcept
+        {
+            fitPath(X, y, 0);
+        }
+
+        /*
+            Lasso class members
+        */
+
+        Lasso::Lasso(const double lambda, const std::size_t& threads) : ElasticNet(lambda, 1, threads)
         {
-            /*
-                Function uses _sign() function to assign 0 or 1 to a multidimensional vector passed
-            */
-			
-            for (data::Storage::size_type row = 0; row < vector.size(); ++row)
-			{
-				for (std::vector<double>::size_type col = 0; col < vector[row].size(); ++col)
-				{
-					vector[row][col] = _sign(vector[row][col]);
-				}
-			}
         }
 
-        void RidgeClassifier::_keepMaximum(const data::Storage& newVals, data::Storage& change) noexcept
+        /*
+            LogisticRegression Class members
+        */
+
+        LogisticRegression::LogisticRegression(const int maximumIterations, const double tolerance, ClassificationType method)
         {
             /*
-                Function updates maximum vector if for any index a grater value is found
-
-                The change index stores at what iteration of function calling the change was done for particular index
+                Constructor to load defaults
             */
+            MaximumIterations = maximumIterations;
+            Tolerance = tolerance;
+            Method = method;
 
-            static data::Storage maximum = newVals;
-
-            for (data::Storage::size_type row = 0; row < maximum.size(); ++row)
-			{
-				for (std::vector<double>::size_type col = 0; col < maximum[row].size(); ++col)
-				{
-                    if (maximum[row][col] < newVals[row][col])
-                    {
-                        maximum[row][col] = newVals[row][col];
-                        change[row][col]++;
-                    }
-				}
-			}
+            Solver = SolverType::DIRECT;
+            BatchSize = static_cast<std::size_t>(defaults::BATCH_SIZE);
+            Epochs = static_cast<std::size_t>(defaults::EPOCHS);
+            LearningRate = defaultsd::LEARNING_RATE;
+            Schedule = ScheduleType::INVERSE_SCALING;
+            Seed = 0;
+            Threads = 0;
+            History = static_cast<std::size_t>(defaults::HISTORY);
+
+            Classes = 0;
+            Iterations = 0;
         }
-        void RidgeClassifier::model(const data::Storage& X, const data::Storage& y) noexcept
+
+        double LogisticRegression::_loss(const std::size_t& rows, const Row& row, const data::Storage& y, const std::size_t& columns, const std::vector<double>& weights, std::vector<double>& gradient) const
         {
             /*
-                The labels are converted into -1 and 1 
-                and the regression model is built. 
-
-                For multi class setting, one vs all (one-vs-rest or ova or o.v.r) approach is followed)
+                The steps followed by the function are as follows
+
+                1) Cut the rows into blocks. Their number only depends on the size of the problem (at least 8 non zero values per
+                   coefficient in a block, so adding the blocks up costs less than filling them, and at most 2^22 values of sums),
+                   so the loss is the same on any number of threads
+                2) For every row of a block the scores s = x W are added feature by feature (row j of W is contiguous)
+                3) Binary :		loss = log(1 + e^s) - y s, and the residual is sigmoid(s) - y
+                   Multinomial :	loss = log sum_c e^{s_c} - s_y (shifted by the largest score so nothing overflows), and the
+                                    residual is softmax(s) - one hot(y)
+                4) The gradient x^T residual of the row is added to the sums of the block
+                5) Add the sums of the blocks in block order and average over the rows
             */
+            const std::size_t minimumRows = 1024, maximumBlocks = 256, maximumValues = static_cast<std::size_t>(1) << 22;
 
-            Y = y;
-            
-            if (Method == ClassificationType::BINARY)
+            std::size_t values = weights.size(), nonZeros = 0;
+
+            for (std::size_t observation = 0; observation < rows; ++observation)
             {
-                _encoder(0);
-                RidgeRegression::model(X,Y);
-                _decoder(0);
+                const std::size_t* indexes = nullptr;
+                const double* x = nullptr;
+
+                nonZeros += row(observation, indexes, x);
             }
 
-            else if (Method == ClassificationType::MULTI_CLASS)
+            std::size_t blocks = std::min({ (rows + minimumRows - 1) / minimumRows, maximumBlocks, maximumValues / std::max(values, static_cast<std::size_t>(1)), nonZeros * columns / std::max(8 * values, static_cast<std::size_t>(1)) });
+
+            blocks = std::max(blocks, static_cast<std::size_t>(1));
+
+            std::size_t blockRows = (rows + blocks - 1) / blocks;
+
+            std::vector<double> partial(blocks * values, 0), losses(blocks, 0);
+
+            utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
             {
-                Classes = array::unique(Y);
+                std::vector<double> scores(columns);
 
-                data::Storage yLabelled(Y.size(), std::vector<double>(Classes,-1));
-               
-				_binarizer(yLabelled);
+                for (std::size_t block = first; block < last; ++block)
+                {
+                    double* sums = partial.data() + block * values;
+                    double loss = 0;
 
-				RidgeRegression::model(X, yLabelled);
+                    for (std::size_t observation = block * blockRows; observation < std::min(rows, (block + 1) * blockRows); ++observation)
+                    {
+                        const std::size_t* indexes = nullptr;
+                        const double* x = nullptr;
+                        std::size_t size = row(observation, indexes, x);
 
-            }
-        }
+                        std::fill(scores.begin(), scores.end(), 0.0);
 
-        void RidgeClassifier::predict(const data::Storage& XTest, data::Storage& result) // throws std::runtime_error
-        {
-            /*
-                For binary class prediction linear regression's predict method is used and then the predicted labels are assigned
-                the earlier encoded numbers
+                        for (std::size_t value = 0; value < size; ++value)
+                        {
+                            const double* w = weights.data() + ((indexes == nullptr) ? value : indexes[value]) * columns;
 
-                For multi class prediction from each separator model is obtained and argmax is returned.
+                            for (std::size_t column = 0; column < columns; ++column)
+                            {
+                                scores[column] += x[value] * w[column];
+                            }
+                        }
 
-                A std::runtime_error is thrown if the model is not built before predicting
+                        if (columns == 1)
+                        {
+                            double margin = scores[0], target = y[observation][0];
 
-                Xtest, result are required to be in correct shapes or undefined behavior may occur
-            */
+                            loss += std::max(margin, 0.0) + std::log1p(std::exp(-std::abs(margin))) - target * margin;
+                            scores[0] = 1 / (1 + std::exp(-margin)) - target;
+                        }
 
-            try
-            {
-                if (!Coefficients.size()) throw std::runtime_error("<In function cmll::linear::RidgeClassifier::predict()>Error : Model is not built yet. Use model() to fit the model");
+                        else
+                        {
+                            std::size_t label = static_cast<std::size_t>(y[observation][0]);
+                            double largest = *std::max_element(scores.begin(), scores.end()), sum = 0;
 
-                if (Method == ClassificationType::BINARY)
-                {
-                    RidgeRegression::predict(XTest, result);
-                    _decoder(0);
-                    _assingSign(result);
+                            loss += largest - scores[label];
+
+                            for (double& score : scores)
+                            {
+                                score = std::exp(score - largest);
+                                sum += score;
+                            }
+
+                            loss += std::log(sum);
+
+                            for (double& score : scores) score /= sum;
+
+                            scores[label] -= 1;
+                        }
+
+                        for (std::size_t value = 0; value < size; ++value)
+                        {
+                            double* g = sums + ((indexes == nullptr) ? value : indexes[value]) * columns;
+
+                            for (std::size_t column = 0; column < columns; ++column)
+                            {
+                                g[column] += x[value] * scores[column];
+                            }
+                        }
+                    }
+
+                    losses[block] = loss;
                 }
+            }, Threads);
 
-                else if (Method == ClassificationType::MULTI_CLASS)
+            double scale = 1 / static_cast<double>(std::max(rows, static_cast<std::size_t>(1)));
+
+            gradient.assign(values, 0);
+
+            utils::parallel::forEach(0, values, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t block = 0; block < blocks; ++block)
                 {
-                    data::Storage CoefficientsAll = Coefficients;
-                    Coefficients.clear();
-                    Coefficients.shrink_to_fit();
-                    Coefficients.resize(CoefficientsAll.size(), std::vector<double>(1));
-                    data::Storage psudoResult(result.size(), std::vector<double>(result[0].size()));
+                    const double* sums = partial.data() + block * values;
 
-                    for (std::size_t classType = 0; classType < CoefficientsAll[0].size(); ++classType)
+                    for (std::size_t value = first; value < last; ++value)
                     {
-                        array::columns(CoefficientsAll, { classType }, Coefficients);
-                        RidgeRegression::predict(XTest, psudoResult);
-                        _keepMaximum(psudoResult, result);
+                        gradient[value] += sums[value];
                     }
                 }
-            }
 
-            catch (const std::runtime_error& e)
-            {
-                std::cerr << e.what() << '\n';
-            }
+                for (std::size_t value = first; value < last; ++value)
+                {
+                    gradient[value] *= scale;
+                }
+            }, Threads, 4096);
+
+            return std::accumulate(losses.begin(), losses.end(), 0.0) * scale;
         }
 
-        double RidgeClassifier::score(const data::Storage& y_pred, const data::Storage& y) noexcept
+        void LogisticRegression::_minimize(const std::size_t& rows, const std::size_t& features, const Row& row, const data::Storage& y)
         {
-            
             /*
-                Function uses standard indicator function for calculating accuracy.
-
-                Note :  Y_pred and y are supposed to be in correct order of NX1.
+                The coefficients are kept as one flat vector ( features X columns, row major ), so the L-BFGS pairs are plain vectors
+                and no matrix of the size of X is ever allocated
             */
-            
-            double count = 0;
-            data::Storage::size_type observation = y.size();
+            std::size_t columns = 1;
 
-            for (data::Storage::size_type value = 0; value < observation; ++value)
+            if (Method == ClassificationType::MULTI_CLASS)
             {
-                if (y[value][0] == y_pred[value][0]) ++count;
+                double largest = 0;
+
+                try
+                {
+                    for (std::size_t observation = 0; observation < rows; ++observation)
+                    {
+                        double label = y[observation][0];
+
+                        if (label < 0 || label != std::floor(label)) throw std::runtime_error("<In function cmll::linear::LogisticRegression::model()>Error :  Labels of a multi class model must be 0, 1, 2 ... but row " + std::to_string(observation) + " has " + std::to_string(label));
+
+                        largest = std::max(largest, label);
+                    }
+                }
+                catch (const std::runtime_error& e)
+                {
+                    std::cerr << e.what() << '\n';
+                    return;
+                }
+
+                Classes = static_cast<std::size_t>(largest) + 1;
+                columns = Classes;
             }
 
-            return static_cast<double>(count / observation);
-        }
+            else Classes = 2;
 
-        /*
-            LogisticRegression Class members
-        */
+            std::vector<double> weights(features * columns, 0);
 
-        LogisticRegression::LogisticRegression(const int maximumIterations, const double tolerance, ClassificationType method)
-        {
-            /*
-                Constructor to load defaults
-            */
-            MaximumIterations = maximumIterations;
-            Tolerance = tolerance;
-            Method = method;
+            Iterations = Lbfgs(History, static_cast<std::size_t>(std::max(MaximumIterations, 0)), Tolerance).minimize([&](const std::vector<double>& w, std::vector<double>& gradient)
+            {
+                return _loss(rows, row, y, columns, w, gradient);
+            }, weights);
+
+            Coefficients.assign(features, std::vector<double>(columns));
+
+            for (std::size_t feature = 0; feature < features; ++feature)
+            {
+                std::copy(weights.begin() + feature * columns, weights.begin() + (feature + 1) * columns, Coefficients[feature].begin());
+            }
         }
 
         void LogisticRegression::_model(const data::Storage& X, const data::Storage& y) noexcept
@@ -508,136 +2231,364 @@ namespace cmll
             Thus                β =  (X^{T}WX)^{−1}X^{T}Wz
             where               z = Xβ^{old} + W^{−1}(y − p)
 
-            Multi label classification is not supported (yet).
+            Multinomial models are fitted with L-BFGS instead (see _minimize()).
             Note it is assumed that X and y are in correct order. use cmll::utility::checks::.. for checking correctness
+
+            The steps followed by every iteration are as follows
+
+            1) One pass over the rows : the margin x.β, p, w = p (1 - p) and w z = w x.β + (y - p) (no division by w, which
+               vanishes for confident observations)
+            2) One pass over blocks of rows adds w x_i x_j (j >= i) and x_i w z, as LinearRegression::accumulate() adds X^T X.
+               The number of blocks only depends on the size of X, so the result is the same on any number of threads
+            3) The gradient X^T (y - p) = X^T W z - X^T W X β. Stop once its largest value is at most Tolerance
+            4) β = (X^T W X)^{−1} X^T W z by Cholesky
             */
+            const std::size_t minimumRows = 1024, maximumBlocks = 256, maximumValues = static_cast<std::size_t>(1) << 22;
 
-			data::Storage::size_type observations = X.size();
-			std::vector<double>::size_type features = X[0].size();
-            
-            Coefficients.resize(features, std::vector<double>(1));
-             
-            data::Storage XMulCoef(observations, std::vector<double>(1)), p(observations, std::vector<double>(1)), pNeg(observations, std::vector<double>(1));
-            data::Storage w(observations, std::vector<double>(1)), wInverse(observations, std::vector<double>(1));
-            data::Storage yMinusp(observations, std::vector<double>(1));
-            data::Storage wInverseMulyMinusp(observations, std::vector<double>(1)),z(observations, std::vector<double>(1));
-            data::Storage Xt(features, std::vector<double>(observations));
-            data::Storage XtMulw(features, std::vector<double>(observations));
-            data::Storage XtMulwMulX(features, std::vector<double>(features));
-            data::Storage XtMulwMulXMulXt(features, std::vector<double>(observations));
-            data::Storage XtMulwMulXMulXtMulw(features, std::vector<double>(observations));
-			data::Storage l(features,std::vector<double>(features));
-            data::Storage u(features, std::vector<double>(features));
-            data::Storage gradient(features,std::vector<double>(1));
-            double change;
-
-            long interationIndex = 0;
-
-            do 
-            {
-                matrix::multiplication(X, Coefficients, XMulCoef);
-
-                for (data::Storage::size_type val = 0; val < p.size(); ++val)
-                {
-                    p[val][0] = functions::activation::sigmoid(XMulCoef[val][0]);
-                    pNeg[val][0] = 1 - p[val][0];
-                    w[val][0] = p[val][0] * pNeg[val][0];
-                }
-                
-                matrix::transpose(X, Xt);
-                matrix::diagonalMultiplication(Xt, w,XtMulw,matrix::selection::RHS);
-                matrix::multiplication(XtMulw, X, XtMulwMulX);
-
-                matrix::lu(XtMulwMulX, l, u);
-                matrix::inverse(l, u, XtMulwMulX);
-                matrix::multiplication(XtMulwMulX, Xt, XtMulwMulXMulXt);
-                matrix::diagonalMultiplication(XtMulwMulXMulXt, w, XtMulwMulXMulXtMulw,matrix::selection::RHS);
-
-                matrix::diagonalInverse(w, wInverse);
-                matrix::subtraction(y, p, yMinusp);
-                matrix::diagonalMultiplication(wInverse, yMinusp, wInverseMulyMinusp,matrix::selection::LHS);
-                matrix::addition(XMulCoef, wInverseMulyMinusp,z);
-
-                matrix::multiplication(XtMulwMulXMulXtMulw, z, Coefficients);
-                matrix::multiplication(Xt, yMinusp, gradient);
-                change = std::abs(array::maximum(gradient));
-                
-                
-                ++interationIndex;
-                
-
-            } while ((interationIndex < MaximumIterations) && (change < Tolerance));
-
-            if (change <= Tolerance)
+            std::size_t observations = X.size(), features = X[0].size(), values = features * (features + 1);
+            std::size_t blocks = std::max(std::min({ (observations + minimumRows - 1) / minimumRows, maximumBlocks, maximumValues / std::max(values, static_cast<std::size_t>(1)) }), static_cast<std::size_t>(1));
+            std::size_t blockRows = (observations + blocks - 1) / blocks;
+
+            std::size_t threads = utils::parallel::threads(Threads);
+            std::size_t ranges = std::max(std::min(features, (4 * threads + blocks - 1) / blocks), static_cast<std::size_t>(1));
+
+            std::vector<std::size_t> bounds(1, 0);
+            double work = 0, total = static_cast<double>(features) * (features + 3) / 2;
+
+            for (std::size_t row = 0; row < features; ++row)
+            {
+                work += static_cast<double>(features - row + 1);
+
+                if (work * ranges >= total * bounds.size() && bounds.size() < ranges) bounds.emplace_back(row + 1);
+            }
+
+            if (bounds.back() != features) bounds.emplace_back(features);
+
+            ranges = bounds.size() - 1;
+
+            Coefficients.assign(features, std::vector<double>(1, 0));
+
+            std::vector<double> weights(observations), responses(observations), partial(blocks * values);
+            data::Storage hessian(features, std::vector<double>(features)), moment(features, std::vector<double>(1)), l;
+            double change = 0;
+
+            Iterations = 0;
+
+            while (true)
+            {
+                utils::parallel::forEach(0, observations, [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t row = first; row < last; ++row)
+                    {
+                        double margin = 0;
+
+                        for (std::size_t feature = 0; feature < features; ++feature)
+                        {
+                            margin += X[row][feature] * Coefficients[feature][0];
+                        }
+
+                        double p = functions::activation::sigmoid(margin);
+
+                        weights[row] = p * (1 - p);
+                        responses[row] = weights[row] * margin + (y[row][0] - p);
+                    }
+                }, threads, 1024);
+
+                std::fill(partial.begin(), partial.end(), 0.0);
+
+                utils::parallel::forEach(0, blocks * ranges, [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t task = first; task < last; ++task)
+                    {
+                        std::size_t block = task / ranges, range = task % ranges;
+                        std::size_t firstRow = block * blockRows, lastRow = std::min(observations, firstRow + blockRows);
+                        std::size_t firstFeature = bounds[range], lastFeature = bounds[range + 1];
+
+                        double* gram = partial.data() + block * values;
+                        double* rhs = gram + features * features;
+
+                        std::size_t row = firstRow;
+
+                        for (; row + 4 <= lastRow; row += 4)
+                        {
+                            const double* x0 = X[row].data(), * x1 = X[row + 1].data(), * x2 = X[row + 2].data(), * x3 = X[row + 3].data();
+                            double w0 = weights[row], w1 = weights[row + 1], w2 = weights[row + 2], w3 = weights[row + 3];
+
+                            for (std::size_t i = firstFeature; i < lastFeature; ++i)
+                            {
+                                double a0 = w0 * x0[i], a1 = w1 * x1[i], a2 = w2 * x2[i], a3 = w3 * x3[i];
+                                double* g = gram + i * features;
+
+                                for (std::size_t j = i; j < features; ++j)
+                                {
+                                    g[j] += a0 * x0[j] + a1 * x1[j] + a2 * x2[j] + a3 * x3[j];
+                                }
+
+                                rhs[i] += x0[i] * responses[row] + x1[i] * responses[row + 1] + x2[i] * responses[row + 2] + x3[i] * responses[row + 3];
+                            }
+                        }
+
+                        for (; row < lastRow; ++row)
+                        {
+                            const double* x0 = X[row].data();
+
+                            for (std::size_t i = firstFeature; i < lastFeature; ++i)
+                            {
+                                double a0 = weights[row] * x0[i];
+                                double* g = gram + i * features;
+
+                                for (std::size_t j = i; j < features; ++j)
+                                {
+                                    g[j] += a0 * x0[j];
+                                }
+
+                                rhs[i] += x0[i] * responses[row];
+                            }
+                        }
+                    }
+                }, threads);
+
+                utils::parallel::forEach(0, features, [&](std::size_t first, std::size_t last)
+                {
+                    for (std::size_t i = first; i < last; ++i)
+                    {
+                        std::fill(hessian[i].begin() + i, hessian[i].end(), 0.0);
+                        moment[i][0] = 0;
+
+                        for (std::size_t block = 0; block < blocks; ++block)
+                        {
+                            const double* gram = partial.data() + block * values;
+
+                            for (std::size_t j = i; j < features; ++j)
+                            {
+                                hessian[i][j] += gram[i * features + j];
+                            }
+
+                            moment[i][0] += gram[features * features + i];
+                        }
+                    }
+                }, threads);
+
+                change = 0;
+
+                for (std::size_t i = 0; i < features; ++i)
+                {
+                    double gradient = moment[i][0];
+
+                    for (std::size_t j = 0; j < features; ++j)
+                    {
+                        gradient -= ((j < i) ? hessian[j][i] : hessian[i][j]) * Coefficients[j][0];
+                    }
+
+                    change = std::max(change, std::abs(gradient));
+
+                    for (std::size_t j = 0; j < i; ++j)
+                    {
+                        hessian[i][j] = hessian[j][i];
+                    }
+                }
+
+                if (change <= Tolerance || static_cast<long>(Iterations) >= MaximumIterations) break;
+
+                try
+                {
+                    if (!matrix::cholesky(hessian, l)) throw std::runtime_error("<In function cmll::linear::LogisticRegression::model()>Error :  X^T W X is not positive definite at iteration " + std::to_string(Iterations) + " (the features are linearly dependent, or the classes are separable)");
+                }
+                catch (const std::runtime_error& e)
+                {
+                    std::cerr << e.what() << '\n';
+                    return;
+                }
+
+                matrix::choleskySolve(l, moment, Coefficients);
+
+                ++Iterations;
+            }
+
+            if (change > Tolerance)
             {
                 std::cerr << "<In function cmll::Linear::LogisticRegression::model> Warning : The solution did not converge at 'Maximum iterations : " << MaximumIterations << "\n";
             }
+        }
+
+        void LogisticRegression::_scores(const std::size_t& rows, const Row& row, data::Storage& result) const
+        {
+            /*
+                The scores of a row are x times the Coefficients, passed through the sigmoid (one column) or the softmax
+                (shifted by the largest score so nothing overflows)
+            */
+            std::size_t columns = Coefficients[0].size();
+
+            result.assign(rows, std::vector<double>(columns));
+
+            utils::parallel::forEach(0, rows, [&](std::size_t first, std::size_t last)
+            {
+                for (std::size_t observation = first; observation < last; ++observation)
+                {
+                    const std::size_t* indexes = nullptr;
+                    const double* x = nullptr;
+                    std::size_t size = row(observation, indexes, x);
+
+                    std::vector<double>& scores = result[observation];
+
+                    for (std::size_t value = 0; value < size; ++value)
+                    {
+                        const std::vector<double>& w = Coefficients[(indexes == nullptr) ? value : indexes[value]];
 
+                        for (std::size_t column = 0; column < columns; ++column)
+                        {
+                            scores[column] += x[value] * w[column];
+                        }
+                    }
+
+                    if (columns == 1)
+                    {
+                        scores[0] = functions::activation::sigmoid(scores[0]);
+                        continue;
+                    }
+
+                    double largest = *std::max_element(scores.begin(), scores.end()), sum = 0;
+
+                    for (double& score : scores)
+                    {
+                        score = std::exp(score - largest);
+                        sum += score;
+                    }
+
+                    for (double& score : scores) score /= sum;
+                }
+            }, Threads, 1024);
         }
 
         void LogisticRegression::predictProbabilities(const data::Storage& XTest, data::Storage& result) noexcept
         {
             /*
-                To obtain the prediction probabilities. The Test set matrix is multiplied by the Coefficients.
-                And each element of the new product matrix is passed through the activation function to get the probabilities
+                To obtain the prediction probabilities. Every test observation is multiplied by the Coefficients
+                and passed through the activation function (see _scores())
 
                 Note : The model is supposed to be fit using model() an exception will not be thrown by this function
             */
-            data::Storage XMulCoef(XTest.size(), std::vector<double>(1));
-
-            matrix::multiplication(XTest, Coefficients, XMulCoef);
+            _scores(XTest.size(), [&XTest](const std::size_t& row, const std::size_t*& indexes, const double*& values)
+            {
+                indexes = nullptr;
+                values = XTest[row].data();
+                return XTest[row].size();
+            }, result);
+        }
 
-            for (data::Storage::size_type row = 0; row < XTest.size(); ++row)
+        void LogisticRegression::predictProbabilities(const data::Sparse& XTest, data::Storage& result) noexcept
+        {
+            /*
+                Only the non zero values of a row are multiplied by their coefficients
+            */
+            _scores(XTest.Rows, [&XTest](const std::size_t& row, const std::size_t*& indexes, const double*& values)
             {
-                result[row][0] = functions::activation::sigmoid(XMulCoef[row][0]);
-            }
+                indexes = XTest.Indexes.data() + XTest.Offsets[row];
+                values = XTest.Values.data() + XTest.Offsets[row];
+                return XTest.Offsets[row + 1] - XTest.Offsets[row];
+            }, result);
         }
 
         void LogisticRegression::model(const data::Storage& X, const data::Storage& y) noexcept
         {   
             /*
-                The function calls the internal _model() function to build the model
+                The function calls the internal _model() function to build the model with Newton-Raphson, the SGD solver or
+                _minimize() for L-BFGS (always used for a multinomial model)
             */
-            
-            if (Method == ClassificationType::BINARY)
+            if (Method == ClassificationType::MULTI_CLASS || Solver == SolverType::LBFGS)
+            {
+                _minimize(X.size(), X[0].size(), [&X](const std::size_t& row, const std::size_t*& indexes, const double*& values)
+                {
+                    indexes = nullptr;
+                    values = X[row].data();
+                    return X[row].size();
+                }, y);
+            }
+
+            else if (Solver == SolverType::SGD)
+            {
+                Coefficients.clear();
+                Classes = 2;
+
+                Iterations = Sgd(LossType::LOGISTIC, 0, BatchSize, Epochs, LearningRate, Schedule, Seed, Threads, Tolerance).fit(X, y, Coefficients);
+            }
+
+            else
             {
+                Classes = 2;
+
                 _model(X, y);
             }
+        }
 
-            else if (Method == ClassificationType::MULTI_CLASS)
+        void LogisticRegression::model(const data::Sparse& X, const data::Storage& y) noexcept
+        {
+            /*
+                Newton-Raphson would need X^T W X, so a sparse X is fitted with SGD, or with L-BFGS
+            */
+            if (Method == ClassificationType::MULTI_CLASS || Solver == SolverType::LBFGS)
             {
-                std::cerr << "<In function cmll::linear::LogisticRegression> Information: Multi class classification is not supported with Newton Raphson Method \n";
+                _minimize(X.Rows, X.Cols, [&X](const std::size_t& row, const std::size_t*& indexes, const double*& values)
+                {
+                    indexes = X.Indexes.data() + X.Offsets[row];
+                    values = X.Values.data() + X.Offsets[row];
+                    return X.Offsets[row + 1] - X.Offsets[row];
+                }, y);
+
+                return;
             }
+
+            Coefficients.clear();
+            Classes = 2;
+
+            Iterations = Sgd(LossType::LOGISTIC, 0, BatchSize, Epochs, LearningRate, Schedule, Seed, Threads, Tolerance).fit(X, y, Coefficients);
         }
 
         void LogisticRegression::predict(const data::Storage& XTest, data::Storage& result) // throws std::runtime_error
         {
             /*
                 Function calls predictProbability() for calculating probabilities for each test st observations and then
-                the label is assigned according to the probability
+                the label is assigned according to the probability (the most probable class of a multinomial model)
             */
             try
             {
                 if (!Coefficients.size()) throw std::runtime_error("<In function cmll::linear::LogisticRegression::predict()>Error : Model is not built yet. Use model() to fit the model");
+            }
+            catch (const std::runtime_error& e)
+            {
+				std::cerr << e.what() << '\n';
+                return;
+            }
 
-                if (Method == ClassificationType::BINARY)
-                {
-                    predictProbabilities(XTest, result);
+            predictProbabilities(XTest, result);
 
-                    for (data::Storage::size_type row = 0; row < XTest.size(); ++row)
-                    {
-                        result[row][0] = (result[row][0] >= 0.5) ? 1 : 0;
-                    }
-                }
+            for (std::vector<double>& row : result)
+            {
+                if (row.size() == 1) row[0] = (row[0] >= 0.5) ? 1 : 0;
 
-                else if (Method == ClassificationType::MULTI_CLASS)
-                {
-					std::cerr << "<In function cmll::linear::LogisticRegression> Information: Multi class classification is not supported with Newton Raphson Method \n";
-                }
+                else row.assign(1, static_cast<double>(std::max_element(row.begin(), row.end()) - row.begin()));
+            }
+        }
+
+        void LogisticRegression::predict(const data::Sparse& XTest, data::Storage& result) // throws std::runtime_error
+        {
+            try
+            {
+                if (!Coefficients.size()) throw std::runtime_error("<In function cmll::linear::LogisticRegression::predict()>Error : Model is not built yet. Use model() to fit the model");
             }
             catch (const std::runtime_error& e)
             {
-				std::cerr << e.what() << '\n';
+                std::cerr << e.what() << '\n';
+                return;
+            }
+
+            predictProbabilities(XTest, result);
+
+            for (std::vector<double>& row : result)
+            {
+                if (row.size() == 1) row[0] = (row[0] >= 0.5) ? 1 : 0;
+
+                else row.assign(1, static_cast<double>(std::max_element(row.begin(), row.end()) - row.begin()));
             }
         }
 
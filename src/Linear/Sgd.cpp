@@ -0,0 +1,258 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Linear/Sgd.h"
+
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		linear name space : Name space for linear models of regression and classification
+	*/
+	namespace linear
+	{
+		/*
+			Sgd class members
+		*/
+
+		Sgd::Sgd(const LossType& loss, const double& penalty, const std::size_t& batchSize, const std::size_t& epochs, const double& learningRate, const ScheduleType& schedule, const unsigned int& seed, const std::size_t& threads, const double& tolerance)
+		{
+			Loss = loss;
+			Penalty = penalty;
+			BatchSize = batchSize;
+			Epochs = epochs;
+			LearningRate = learningRate;
+			Schedule = schedule;
+			Seed = seed;
+			Threads = threads;
+			Tolerance = tolerance;
+		}
+
+		std::size_t Sgd::_fit(const std::size_t& rows, const std::vector<std::size_t>& counts, const Row& row, const data::Storage& y, data::Storage& coefficients) const
+		{
+			/*
+				The steps followed by the function are as follows (for every output)
+
+				1) Copy the coefficients into atomics, read and written with relaxed order : plain loads and stores on common
+				   hardware, but without the undefined behavior of a data race
+				2) For every epoch shuffle the row indexes and cut them into one range per thread. Every thread, BatchSize rows at a time :
+				   add up residual * x (residual = x.b - y, or sigmoid(x.b) - y) for every feature present and the number of rows it is
+				   present in, then step every such coefficient by
+								 - rate * ( gradient + present * Penalty / count * b ) / batch rows
+				3) Stop when the average loss of an epoch improves by less than Tolerance
+			*/
+			std::size_t features = counts.size(), outputs = y[0].size();
+			std::size_t batchSize = std::max(BatchSize, static_cast<std::size_t>(1));
+			std::size_t threads = std::min(utils::parallel::threads(Threads), std::max((rows + batchSize - 1) / batchSize, static_cast<std::size_t>(1)));
+
+			std::vector<double> penalties(features, 0);
+
+			for (std::size_t feature = 0; feature < features; ++feature)
+			{
+				if (counts[feature] > 0) penalties[feature] = Penalty / static_cast<double>(counts[feature]);
+			}
+
+			std::vector<std::atomic<double>> weights(features);
+			std::vector<std::size_t> order(rows);
+			std::vector<double> losses(threads);
+			std::size_t epochsRun = 0;
+
+			for (std::size_t output = 0; output < outputs; ++output)
+			{
+				for (std::size_t feature = 0; feature < features; ++feature)
+				{
+					weights[feature].store(coefficients[feature][output], std::memory_order_relaxed);
+				}
+
+				std::iota(order.begin(), order.end(), static_cast<std::size_t>(0));
+
+				std::mt19937 generator(Seed);
+				double previous = std::numeric_limits<double>::infinity();
+				std::size_t epoch = 0;
+
+				while (epoch < Epochs)
+				{
+					std::shuffle(order.begin(), order.end(), generator);
+
+					std::size_t rangeRows = (rows + threads - 1) / threads;
+
+					utils::parallel::forEach(0, threads, [&](std::size_t first, std::size_t last)
+					{
+						std::vector<double> gradient(features, 0);
+						std::vector<std::size_t> present(features, 0), touched;
+
+						for (std::size_t thread = first; thread < last; ++thread)
+						{
+							std::size_t begin = std::min(rows, thread * rangeRows), end = std::min(rows, begin + rangeRows);
+							double loss = 0;
+
+							for (std::size_t batch = begin; batch < end; batch += batchSize)
+							{
+								std::size_t batchEnd = std::min(end, batch + batchSize);
+								bool dense = false;
+
+								for (std::size_t position = batch; position < batchEnd; ++position)
+								{
+									std::size_t observation = order[position];
+									const std::size_t* indexes = nullptr;
+									const double* values = nullptr;
+									std::size_t size = row(observation, indexes, values);
+
+									dense = (indexes == nullptr);
+
+									double margin = 0;
+
+									for (std::size_t value = 0; value < size; ++value)
+									{
+										margin += values[value] * weights[dense ? value : indexes[value]].load(std::memory_order_relaxed);
+									}
+
+									double target = y[observation][output], residual;
+
+									if (Loss == LossType::LOGISTIC)
+									{
+										// log(1 + e^margin) - target * margin, without overflow
+										loss += std::max(margin, 0.0) + std::log1p(std::exp(-std::abs(margin))) - target * margin;
+										residual = 1 / (1 + std::exp(-margin)) - target;
+									}
+
+									else
+									{
+										residual = margin - target;
+										loss += residual * residual / 2;
+									}
+
+									for (std::size_t value = 0; value < size; ++value)
+									{
+										std::size_t feature = dense ? value : indexes[value];
+
+										if (present[feature]++ == 0 && !dense) touched.emplace_back(feature);
+
+										gradient[feature] += residual * values[value];
+									}
+								}
+
+								double progress = 1 + static_cast<double>(epoch) + static_cast<double>(batchEnd - begin) / static_cast<double>(std::max(end - begin, static_cast<std::size_t>(1)));
+								double rate = LearningRate;
+
+								if (Schedule == ScheduleType::INVERSE) rate /= progress;
+
+								else if (Schedule == ScheduleType::INVERSE_SCALING) rate /= std::sqrt(progress);
+
+								rate /= static_cast<double>(batchEnd - batch);
+
+								auto step = [&](const std::size_t& feature)
+								{
+									double weight = weights[feature].load(std::memory_order_relaxed);
+
+									weights[feature].store(weight - rate * (gradient[feature] + present[feature] * penalties[feature] * weight), std::memory_order_relaxed);
+
+									gradient[feature] = 0;
+									present[feature] = 0;
+								};
+
+								if (dense)
+								{
+									for (std::size_t feature = 0; feature < features; ++feature)
+									{
+										if (present[feature] > 0) step(feature);
+									}
+								}
+
+								else
+								{
+									for (std::size_t feature : touched)
+									{
+										step(feature);
+									}
+
+									touched.clear();
+								}
+							}
+
+							losses[thread] = loss;
+						}
+					}, threads);
+
+					++epoch;
+
+					double current = std::accumulate(losses.begin(), losses.end(), 0.0) / static_cast<double>(std::max(rows, static_cast<std::size_t>(1)));
+
+					if (previous - current < Tolerance * std::abs(previous)) break;
+
+					previous = current;
+				}
+
+				epochsRun = std::max(epochsRun, epoch);
+
+				for (std::size_t feature = 0; feature < features; ++feature)
+				{
+					coefficients[feature][output] = weights[feature].load(std::memory_order_relaxed);
+				}
+			}
+
+			return epochsRun;
+		}
+
+		std::size_t Sgd::fit(const data::Storage& X, const data::Storage& y, data::Storage& coefficients) const
+		{
+			std::size_t features = X[0].size(), outputs = y[0].size();
+
+			if (coefficients.size() != features || coefficients.empty() || coefficients[0].size() != outputs) coefficients.assign(features, std::vector<double>(outputs, 0));
+
+			return _fit(X.size(), std::vector<std::size_t>(features, X.size()), [&X](const std::size_t& row, const std::size_t*& indexes, const double*& values)
+			{
+				indexes = nullptr;
+				values = X[row].data();
+				return X[row].size();
+			}, y, coefficients);
+		}
+
+		std::size_t Sgd::fit(const data::Sparse& X, const data::Storage& y, data::Storage& coefficients) const
+		{
+			std::size_t outputs = y[0].size();
+
+			if (coefficients.size() != X.Cols || coefficients.empty() || coefficients[0].size() != outputs) coefficients.assign(X.Cols, std::vector<double>(outputs, 0));
+
+			std::vector<std::size_t> counts(X.Cols, 0);
+
+			for (std::size_t value = 0; value < X.Offsets[X.Rows]; ++value)
+			{
+				++counts[X.Indexes[value]];
+			}
+
+			return _fit(X.Rows, counts, [&X](const std::size_t& row, const std::size_t*& indexes, const double*& values)
+			{
+				indexes = X.Indexes.data() + X.Offsets[row];
+				values = X.Values.data() + X.Offsets[row];
+				return X.Offsets[row + 1] - X.Offsets[row];
+			}, y, coefficients);
+		}
+	}
+}
@@ -0,0 +1,413 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Neighbors/BallTree.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			BallTree class members
+		*/
+
+		void BallTree::_buildNode(const std::size_t& node, const data::Storage& X, std::vector<std::size_t>& order)
+		{
+			/*
+				1) centroid = mean of the observations of the node, radius = largest distance from the centroid
+				2) If the node is not a leaf, the observation farthest from the centroid (a) and the observation farthest from a (b)
+				   are taken as pivots. The observations are ordered by distance(x, a) - distance(x, b) and the first half goes to
+				   the left child, the rest to the right child.
+
+				Only the range of this node and its own children are written, so the nodes of a level can be built in parallel
+			*/
+			std::size_t begin = static_cast<std::size_t>(_nodes[node].Begin), end = static_cast<std::size_t>(_nodes[node].End);
+			std::size_t middle = begin + (end - begin) / 2;
+
+			if (!_nodes[node].Leaf)
+			{
+				_nodes[2 * node + 1].Begin = begin;
+				_nodes[2 * node + 1].End = middle;
+				_nodes[2 * node + 2].Begin = middle;
+				_nodes[2 * node + 2].End = end;
+			}
+
+			if (begin == end) return;
+
+			double* centroid = _centroids.data() + node * _cols;
+
+			for (std::size_t row = begin; row < end; ++row)
+			{
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					centroid[col] += X[order[row]][col];
+				}
+			}
+
+			for (std::size_t col = 0; col < _cols; ++col)
+			{
+				centroid[col] /= static_cast<double>(end - begin);
+			}
+
+			std::size_t farthest = begin;
+			double radius = 0;
+
+			for (std::size_t row = begin; row < end; ++row)
+			{
+				double distance = _distance(centroid, X[order[row]].data());
+
+				if (distance > radius)
+				{
+					radius = distance;
+					farthest = row;
+				}
+			}
+
+			_nodes[node].Radius = radius;
+
+			if (_nodes[node].Leaf || end - begin < 2) return;
+
+			const double* pivotA = X[order[farthest]].data();
+			const double* pivotB = pivotA;
+			double largest = -1;
+
+			for (std::size_t row = begin; row < end; ++row)
+			{
+				double distance = _distance(pivotA, X[order[row]].data());
+
+				if (distance > largest)
+				{
+					largest = distance;
+					pivotB = X[order[row]].data();
+				}
+			}
+
+			std::vector<std::pair<double, std::size_t>> keys(end - begin);
+
+			for (std::size_t row = begin; row < end; ++row)
+			{
+				const double* x = X[order[row]].data();
+				keys[row - begin] = { _distance(x, pivotA) - _distance(x, pivotB), order[row] };
+			}
+
+			std::nth_element(keys.begin(), keys.begin() + (middle - begin), keys.end());
+
+			for (std::size_t row = begin; row < end; ++row)
+			{
+				order[row] = keys[row - begin].second;
+			}
+		}
+
+		double BallTree::_distance(const double* x, const double* y) const noexcept
+		{
+			return functions::distance::fromReduced(functions::distance::reduced(x, y, _cols, _metric, _p), _metric, _p);
+		}
+
+		BallTree::BallTree(const std::size_t& leafSize, const std::size_t& threads)
+		{
+			/*
+				A leaf size of 0 would never stop splitting
+			*/
+			LeafSize = std::max(leafSize, static_cast<std::size_t>(1));
+			Threads = threads;
+			_metric = distanceMetric::EUCLEDIAN;
+			_p = static_cast<double>(defaults::P);
+			_cols = 0;
+		}
+
+		void BallTree::build(const data::Storage& X, const distanceMetric& metric, const double& p)
+		{
+			/*
+				The number of levels is the smallest for which the leaves hold at most LeafSize observations.
+				The levels are built one after another, the nodes inside a level in parallel.
+				Once done the observations are copied in node order
+			*/
+			_metric = metric;
+			_p = p;
+
+			_nodes.clear();
+			_centroids.clear();
+			_points = Values<double>();
+			_ids.clear();
+			_positions.clear();
+
+			if (X.size() == 0) return;
+
+			std::size_t rows = X.size(), levels = 1;
+
+			_cols = X[0].size();
+
+			while (levels < 48 && rows > (LeafSize << (levels - 1)))
+			{
+				++levels;
+			}
+
+			std::size_t nodes = (static_cast<std::size_t>(1) << levels) - 1;
+
+			_nodes.assign(nodes, { 0, 0, 0, 0 });
+			_centroids.assign(nodes * _cols, 0);
+			_nodes[0].End = rows;
+
+			std::vector<std::size_t> order(rows);
+			for (std::size_t row = 0; row < rows; ++row)
+			{
+				order[row] = row;
+			}
+
+			for (std::size_t level = 0; level < levels; ++level)
+			{
+				std::size_t first = (static_cast<std::size_t>(1) << level) - 1, last = (static_cast<std::size_t>(1) << (level + 1)) - 1;
+
+				for (std::size_t node = first; node < last; ++node)
+				{
+					_nodes[node].Leaf = (level + 1 == levels);
+				}
+
+				utils::parallel::forEach(first, last, [&](std::size_t begin, std::size_t end)
+				{
+					for (std::size_t node = begin; node < end; ++node)
+					{
+						_buildNode(node, X, order);
+					}
+				}, Threads);
+			}
+
+			std::vector<double> points(rows * _cols);
+
+			_ids.resize(rows);
+			_positions.resize(rows);
+
+			for (std::size_t row = 0; row < rows; ++row)
+			{
+				std::copy(X[order[row]].begin(), X[order[row]].end(), points.begin() + row * _cols);
+				_ids[row] = order[row];
+				_positions[order[row]] = row;
+			}
+
+			_points = Values<double>(std::move(points));
+		}
+
+		bool BallTree::holdsObservations() const noexcept
+		{
+			return true;
+		}
+
+		void BallTree::load(std::istream& in) // throws std::runtime_error
+		{
+			/*
+				Reads the layout written by save()
+			*/
+			auto read = [&](void* data, std::size_t bytes) { in.read(reinterpret_cast<char*>(data), static_cast<std::streamsize>(bytes)); };
+
+			char magic[8];
+			std::uint64_t header[6];
+			double p;
+
+			read(magic, sizeof(magic));
+			read(header, sizeof(header));
+			read(&p, sizeof(p));
+
+			if (!in || std::string(magic, sizeof(magic)) != std::string("CMLLBTR1", 8)) throw std::runtime_error("<In function cmll::neighbors::BallTree::load()>Error : The stream does not hold a ball tree");
+
+			_metric = static_cast<distanceMetric>(header[0]);
+			_p = p;
+			_cols = static_cast<std::size_t>(header[1]);
+			LeafSize = static_cast<std::size_t>(header[2]);
+
+			if (_cols > 0 && header[5] > std::numeric_limits<std::uint64_t>::max() / _cols) throw std::runtime_error("<In function cmll::neighbors::BallTree::load()>Error : The stream holds more observations than can be stored");
+
+			_read(in, header[3], _nodes);
+			_read(in, header[4], _centroids);
+			_read(in, header[5] * _cols, _points);
+			_read(in, header[5], _ids);
+
+			if (!in) throw std::runtime_error("<In function cmll::neighbors::BallTree::load()>Error : The stream ended before the tree was read");
+
+			_positions.assign(_ids.size(), 0);
+
+			for (std::size_t row = 0; row < _ids.size(); ++row)
+			{
+				if (_ids[row] >= _ids.size()) throw std::runtime_error("<In function cmll::neighbors::BallTree::load()>Error : The stream holds an observation out of the tree");
+
+				_positions[static_cast<std::size_t>(_ids[row])] = row;
+			}
+		}
+
+		const double* BallTree::observation(const std::size_t& id) const noexcept
+		{
+			return _points.data() + _positions[id] * _cols;
+		}
+
+		void BallTree::query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& /*effort*/) const
+		{
+			/*
+				Depth first search with an explicit stack of (lower bound, node).
+
+				By the triangle inequality no observation of a ball is closer to x than distance(x, centroid) - radius.
+				The child with the smaller bound is visited first and a node is skipped when popped if its bound
+				is farther than the current k-th neighbor.
+
+				MINKOWSKI with P below 1 is not a metric (the triangle inequality does not hold), so every bound is 0
+				and all the leaves are scanned (brute force)
+			*/
+			result.clear();
+
+			if (_nodes.empty() || k == 0) return;
+
+			bool prune = !(_metric == distanceMetric::MINKOWSKI && _p < 1);
+
+			auto bound = [&](std::size_t node)
+			{
+				return prune ? std::max(0.0, _distance(x.data(), _centroids.data() + node * _cols) - _nodes[node].Radius) : 0.0;
+			};
+
+			NeighborHeap heap(k);
+			std::vector<std::pair<double, std::size_t>> stack;
+
+			stack.emplace_back(bound(0), 0);
+
+			while (!stack.empty())
+			{
+				std::pair<double, std::size_t> top = stack.back();
+				stack.pop_back();
+
+				const Node& node = _nodes[top.second];
+
+				if (node.Begin == node.End || functions::distance::toReduced(top.first, _metric, _p) > heap.worst()) continue;
+
+				if (node.Leaf)
+				{
+					for (std::size_t row = static_cast<std::size_t>(node.Begin); row < node.End; ++row)
+					{
+						heap.push(functions::distance::reduced(x.data(), _points.data() + row * _cols, _cols, _metric, _p), static_cast<std::size_t>(_ids[row]));
+					}
+					continue;
+				}
+
+				std::size_t left = 2 * top.second + 1, right = left + 1;
+				double leftBound = bound(left), rightBound = bound(right);
+
+				if (leftBound <= rightBound)
+				{
+					stack.emplace_back(rightBound, right);
+					stack.emplace_back(leftBound, left);
+				}
+
+				else
+				{
+					stack.emplace_back(leftBound, left);
+					stack.emplace_back(rightBound, right);
+				}
+			}
+
+			heap.sorted(result);
+
+			for (Neighbor& neighbor : result)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, _metric, _p);
+			}
+		}
+
+		void BallTree::radius(const std::vector<double>& x, const double& r, std::vector<Neighbor>& result, const std::size_t& /*effort*/) const
+		{
+			/*
+				Same walk as query() with the radius in place of the k-th neighbor : a ball is skipped if
+				distance(x, centroid) - radius is larger than r, and the distance of an observation is abandoned
+				as soon as it is beyond r (see reducedWithin()). No ball is skipped for MINKOWSKI with P below 1 (see query())
+			*/
+			result.clear();
+
+			if (_nodes.empty() || r < 0) return;
+
+			bool prune = !(_metric == distanceMetric::MINKOWSKI && _p < 1);
+			double bound = functions::distance::toReduced(r, _metric, _p);
+			std::vector<std::size_t> stack(1, 0);
+
+			while (!stack.empty())
+			{
+				std::size_t top = stack.back();
+				stack.pop_back();
+
+				const Node& node = _nodes[top];
+
+				if (node.Begin == node.End || (prune && _distance(x.data(), _centroids.data() + top * _cols) - node.Radius > r)) continue;
+
+				if (node.Leaf)
+				{
+					for (std::size_t row = static_cast<std::size_t>(node.Begin); row < node.End; ++row)
+					{
+						double distance = functions::distance::reducedWithin(x.data(), _points.data() + row * _cols, _cols, _metric, _p, bound);
+
+						if (distance <= bound) result.push_back(Neighbor{ distance, static_cast<std::size_t>(_ids[row]) });
+					}
+					continue;
+				}
+
+				stack.push_back(2 * top + 2);
+				stack.push_back(2 * top + 1);
+			}
+
+			std::sort(result.begin(), result.end());
+
+			for (Neighbor& neighbor : result)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, _metric, _p);
+			}
+		}
+
+		void BallTree::save(std::ostream& out) const
+		{
+			/*
+				Layout (native byte order) :
+
+				magic "CMLLBTR1", metric, features, leaf size, nodes, centroid values, observations (uint64 each), p (double)
+				nodes, centroids, observations, indexes
+			*/
+			auto write = [&](const void* data, std::size_t bytes) { out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes)); };
+
+			std::uint64_t header[6] = { static_cast<std::uint64_t>(_metric), _cols, LeafSize, _nodes.size(), _centroids.size(), _ids.size() };
+
+			write("CMLLBTR1", 8);
+			write(header, sizeof(header));
+			write(&_p, sizeof(_p));
+			write(_nodes.data(), _nodes.size() * sizeof(Node));
+			write(_centroids.data(), _centroids.size() * sizeof(double));
+			write(_points.data(), _points.size() * sizeof(double));
+			write(_ids.data(), _ids.size() * sizeof(std::uint64_t));
+		}
+
+		std::size_t BallTree::size() const noexcept
+		{
+			return _ids.size();
+		}
+	}
+}
@@ -0,0 +1,448 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Neighbors/Hnsw.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			Hnsw class members
+		*/
+
+		double Hnsw::_distance(const double* x, const std::uint32_t& node) const noexcept
+		{
+			return functions::distance::reduced(x, _points.data() + static_cast<std::size_t>(node) * _cols, _cols, _metric, _p);
+		}
+
+		void Hnsw::_insert(const std::uint32_t& node)
+		{
+			/*
+				1) Read the entry node. If the new node reaches above the top layer the entry lock is held until it is inserted,
+				   since it becomes the new entry node
+				2) Walk greedily down the layers above the ones of the node
+				3) On every layer of the node, from its highest to 0, search EfConstruction candidates, link the node to the
+				   selected ones and link them back. A node that gets more links than allowed keeps the selected ones only
+			*/
+			const double* x = _points.data() + static_cast<std::size_t>(node) * _cols;
+			std::uint32_t level = _levels[node];
+
+			std::unique_lock<std::mutex> entryLock(_entryLock);
+			std::uint32_t entry = _entry, maxLevel = _maxLevel;
+
+			if (level <= maxLevel) entryLock.unlock();
+
+			std::vector<Neighbor> entries{ { _distance(x, entry), entry } }, found;
+
+			for (std::uint32_t layer = maxLevel; layer > level; --layer)
+			{
+				_searchLayer(x, entries, 1, layer, found, true);
+				entries.swap(found);
+			}
+
+			for (std::uint32_t layer = std::min(level, maxLevel) + 1; layer-- > 0;)
+			{
+				_searchLayer(x, entries, EfConstruction, layer, found, true);
+
+				std::vector<Neighbor> chosen(found);
+				_selectNeighbors(chosen, M);
+
+				std::size_t maximum = (layer == 0) ? 2 * M : M;
+
+				{
+					std::lock_guard<std::mutex> guard(_locks[node]);
+					std::uint32_t* links = _links(node, layer);
+
+					links[0] = static_cast<std::uint32_t>(chosen.size());
+					for (std::size_t link = 0; link < chosen.size(); ++link)
+					{
+						links[link + 1] = static_cast<std::uint32_t>(chosen[link].Index);
+					}
+				}
+
+				for (const Neighbor& neighbor : chosen)
+				{
+					std::uint32_t other = static_cast<std::uint32_t>(neighbor.Index);
+
+					std::lock_guard<std::mutex> guard(_locks[other]);
+					std::uint32_t* links = _links(other, layer);
+
+					if (links[0] < maximum)
+					{
+						links[++links[0]] = node;
+						continue;
+					}
+
+					const double* y = _points.data() + static_cast<std::size_t>(other) * _cols;
+					std::vector<Neighbor> candidates{ { neighbor.Distance, node } };
+
+					for (std::uint32_t link = 1; link <= links[0]; ++link)
+					{
+						candidates.push_back({ _distance(y, links[link]), links[link] });
+					}
+
+					std::sort(candidates.begin(), candidates.end());
+					_selectNeighbors(candidates, maximum);
+
+					links[0] = static_cast<std::uint32_t>(candidates.size());
+					for (std::size_t link = 0; link < candidates.size(); ++link)
+					{
+						links[link + 1] = static_cast<std::uint32_t>(candidates[link].Index);
+					}
+				}
+
+				entries.swap(found);
+			}
+
+			if (level > maxLevel)
+			{
+				_entry = node;
+				_maxLevel = level;
+			}
+		}
+
+		std::uint32_t* Hnsw::_links(const std::uint32_t& node, const std::uint32_t& level) noexcept
+		{
+			if (level == 0) return _links0.data() + static_cast<std::size_t>(node) * (2 * M + 1);
+
+			return _linksUpper[node].data() + static_cast<std::size_t>(level - 1) * (M + 1);
+		}
+
+		const std::uint32_t* Hnsw::_links(const std::uint32_t& node, const std::uint32_t& level) const noexcept
+		{
+			if (level == 0) return _links0.data() + static_cast<std::size_t>(node) * (2 * M + 1);
+
+			return _linksUpper[node].data() + static_cast<std::size_t>(level - 1) * (M + 1);
+		}
+
+		void Hnsw::_searchLayer(const double* x, const std::vector<Neighbor>& entries, const std::size_t& ef, const std::uint32_t& level, std::vector<Neighbor>& result, bool building) const
+		{
+			/*
+				Best first search. The closest unexpanded candidate is expanded until it is farther than the worst of the ef nodes kept.
+
+				Visited nodes are marked with a tag in a per thread array, so nothing is cleared between searches.
+				While building, the links of a node are copied under its lock since other threads may be rewriting them
+			*/
+			thread_local std::vector<std::uint32_t> visited;
+			thread_local std::uint32_t tag = 0;
+
+			if (visited.size() < _rows)
+			{
+				visited.assign(_rows, 0);
+				tag = 0;
+			}
+
+			if (++tag == 0)
+			{
+				std::fill(visited.begin(), visited.end(), 0);
+				tag = 1;
+			}
+
+			auto closer = [](const Neighbor& first, const Neighbor& second) { return second < first; };
+			std::priority_queue<Neighbor, std::vector<Neighbor>, decltype(closer)> candidates(closer);
+			NeighborHeap best(ef);
+			std::vector<std::uint32_t> copy;
+
+			for (const Neighbor& entry : entries)
+			{
+				visited[entry.Index] = tag;
+				candidates.push(entry);
+				best.push(entry.Distance, entry.Index);
+			}
+
+			while (!candidates.empty())
+			{
+				Neighbor current = candidates.top();
+				candidates.pop();
+
+				if (current.Distance > best.worst()) break;
+
+				const std::uint32_t* links = _links(static_cast<std::uint32_t>(current.Index), level);
+
+				if (building)
+				{
+					std::lock_guard<std::mutex> guard(_locks[current.Index]);
+					copy.assign(links + 1, links + 1 + links[0]);
+				}
+
+				else
+				{
+					copy.assign(links + 1, links + 1 + links[0]);
+				}
+
+				for (std::uint32_t other : copy)
+				{
+					if (visited[other] == tag) continue;
+
+					visited[other] = tag;
+
+					double distance = _distance(x, other);
+
+					if (!best.full() || distance < best.worst())
+					{
+						candidates.push({ distance, other });
+						best.push(distance, other);
+					}
+				}
+			}
+
+			best.sorted(result);
+		}
+
+		void Hnsw::_selectNeighbors(std::vector<Neighbor>& candidates, const std::size_t& maximum) const
+		{
+			/*
+				Walk the candidates from the closest. A candidate is kept only if no kept node is closer to it than the node being linked
+			*/
+			if (candidates.size() <= maximum) return;
+
+			std::vector<Neighbor> chosen;
+			chosen.reserve(maximum);
+
+			for (const Neighbor& candidate : candidates)
+			{
+				if (chosen.size() >= maximum) break;
+
+				const double* y = _points.data() + candidate.Index * _cols;
+				bool keep = true;
+
+				for (const Neighbor& kept : chosen)
+				{
+					if (_distance(y, static_cast<std::uint32_t>(kept.Index)) < candidate.Distance)
+					{
+						keep = false;
+						break;
+					}
+				}
+
+				if (keep) chosen.push_back(candidate);
+			}
+
+			candidates.swap(chosen);
+		}
+
+		Hnsw::Hnsw(const std::size_t& m, const std::size_t& efConstruction, const std::size_t& efSearch, const std::size_t& threads, const unsigned int& seed)
+		{
+			/*
+				With less than 2 links per node the layers would not shrink
+			*/
+			M = std::max(m, static_cast<std::size_t>(2));
+			EfConstruction = std::max(efConstruction, static_cast<std::size_t>(1));
+			EfSearch = std::max(efSearch, static_cast<std::size_t>(1));
+			Threads = threads;
+			Seed = seed;
+			_metric = distanceMetric::EUCLEDIAN;
+			_p = static_cast<double>(defaults::P);
+			_cols = 0;
+			_rows = 0;
+			_entry = 0;
+			_maxLevel = 0;
+		}
+
+		void Hnsw::build(const data::Storage& X, const distanceMetric& metric, const double& p)
+		{
+			/*
+				1) Copy the observations and draw the highest layer of every node : floor(-ln(u) / ln(M)) for u uniform in (0, 1]
+				2) Allocate all the links up front so that no thread reallocates while others read
+				3) The first observation is the entry node, the others are inserted in parallel
+				Nodes are 32 bit, so at most 4294967295 observations can be indexed
+			*/
+			_metric = metric;
+			_p = p;
+
+			_points = Values<double>();
+			_levels.clear();
+			_links0.clear();
+			_linksUpper.clear();
+			_rows = 0;
+			_entry = 0;
+			_maxLevel = 0;
+
+			if (X.size() == 0) return;
+
+			_rows = X.size();
+			_cols = X[0].size();
+
+			std::vector<double> points(_rows * _cols);
+			for (std::size_t row = 0; row < _rows; ++row)
+			{
+				std::copy(X[row].begin(), X[row].end(), points.begin() + row * _cols);
+			}
+
+			_points = Values<double>(std::move(points));
+
+			std::mt19937 generator(Seed);
+			std::uniform_real_distribution<double> uniform(0.0, 1.0);
+			double normalization = 1.0 / std::log(static_cast<double>(M));
+
+			_levels.resize(_rows);
+			_linksUpper.resize(_rows);
+
+			for (std::size_t row = 0; row < _rows; ++row)
+			{
+				double level = std::floor(-std::log(1.0 - uniform(generator)) * normalization);
+
+				_levels[row] = static_cast<std::uint32_t>(std::min(level, 31.0));
+				_linksUpper[row].assign(static_cast<std::size_t>(_levels[row]) * (M + 1), 0);
+			}
+
+			_links0.assign(_rows * (2 * M + 1), 0);
+			_locks.reset(new std::mutex[_rows]);
+
+			_maxLevel = _levels[0];
+
+			utils::parallel::forEach(1, _rows, [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t row = begin; row < end; ++row)
+				{
+					_insert(static_cast<std::uint32_t>(row));
+				}
+			}, Threads, 16);
+
+			_locks.reset();
+		}
+
+		bool Hnsw::holdsObservations() const noexcept
+		{
+			return true;
+		}
+
+		void Hnsw::load(std::istream& in) // throws std::runtime_error
+		{
+			/*
+				Reads the layout written by save(). The links of the upper layers are cut back into one block per node
+			*/
+			std::uint64_t header[6] = { 0 };
+			std::vector<std::uint32_t> upper;
+
+			if (!_readHeader(in, "CMLLHNS1")) throw std::runtime_error("<In function cmll::neighbors::Hnsw::load()>Error : The stream does not hold a HNSW graph");
+
+			in.read(reinterpret_cast<char*>(header), sizeof(header));
+
+			_read(in, _points);
+			_read(in, _levels);
+			_read(in, _links0);
+			_read(in, upper);
+
+			if (!in) throw std::runtime_error("<In function cmll::neighbors::Hnsw::load()>Error : The stream ended before the graph was read");
+
+			M = static_cast<std::size_t>(header[0]);
+			EfConstruction = static_cast<std::size_t>(header[1]);
+			EfSearch = static_cast<std::size_t>(header[2]);
+			_entry = static_cast<std::uint32_t>(header[3]);
+			_maxLevel = static_cast<std::uint32_t>(header[4]);
+			_rows = static_cast<std::size_t>(header[5]);
+
+			if (_levels.size() != _rows || _points.size() != _rows * _cols || (_rows > 0 && _entry >= _rows)) throw std::runtime_error("<In function cmll::neighbors::Hnsw::load()>Error : The stream holds a graph of another size than it counts");
+
+			_linksUpper.assign(_rows, std::vector<std::uint32_t>());
+
+			std::size_t offset = 0;
+
+			for (std::size_t row = 0; row < _rows && row < _levels.size(); ++row)
+			{
+				std::size_t count = static_cast<std::size_t>(_levels[row]) * (M + 1);
+
+				if (offset + count > upper.size()) throw std::runtime_error("<In function cmll::neighbors::Hnsw::load()>Error : The stream ended before the graph was read");
+
+				_linksUpper[row].assign(upper.begin() + static_cast<std::ptrdiff_t>(offset), upper.begin() + static_cast<std::ptrdiff_t>(offset + count));
+				offset += count;
+			}
+
+			_locks.reset();
+		}
+
+		const double* Hnsw::observation(const std::size_t& id) const noexcept
+		{
+			return _points.data() + id * _cols;
+		}
+
+		void Hnsw::query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort) const
+		{
+			/*
+				Greedy walk (one candidate) from the entry node down to layer 1, then max(ef, k) candidates on layer 0
+			*/
+			result.clear();
+
+			if (_rows == 0 || k == 0) return;
+
+			std::size_t ef = std::max((effort > 0) ? effort : EfSearch, k);
+			std::vector<Neighbor> entries{ { _distance(x.data(), _entry), _entry } };
+
+			for (std::uint32_t layer = _maxLevel; layer > 0; --layer)
+			{
+				_searchLayer(x.data(), entries, 1, layer, result, false);
+				entries.swap(result);
+			}
+
+			_searchLayer(x.data(), entries, ef, 0, result, false);
+
+			if (result.size() > k) result.resize(k);
+
+			for (Neighbor& neighbor : result)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, _metric, _p);
+			}
+		}
+
+		void Hnsw::save(std::ostream& out) const
+		{
+			/*
+				Layout (native byte order) :
+
+				header (see Index), M, EfConstruction, EfSearch, entry node, top layer, nodes (uint64 each), then observations,
+				layers, links of layer 0 and links of the upper layers of all nodes one after the other, each preceded by its count
+			*/
+			std::uint64_t header[6] = { M, EfConstruction, EfSearch, _entry, _maxLevel, _rows };
+			std::vector<std::uint32_t> upper;
+
+			for (const std::vector<std::uint32_t>& links : _linksUpper)
+			{
+				upper.insert(upper.end(), links.begin(), links.end());
+			}
+
+			_writeHeader(out, "CMLLHNS1");
+			out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+			_write(out, _points);
+			_write(out, _levels);
+			_write(out, _links0);
+			_write(out, upper);
+		}
+
+		std::size_t Hnsw::size() const noexcept
+		{
+			return _rows;
+		}
+	}
+}
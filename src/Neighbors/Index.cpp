@@ -0,0 +1,197 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Neighbors/Index.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			Neighbor Heap class members
+		*/
+
+		NeighborHeap::NeighborHeap(const std::size_t& capacity)
+		{
+			reset(capacity);
+		}
+
+		bool NeighborHeap::full() const noexcept
+		{
+			return _heap.size() >= _capacity;
+		}
+
+		void NeighborHeap::push(const double& distance, const std::size_t& index) noexcept
+		{
+			/*
+				While the heap is not full every candidate is kept.
+				Once full a candidate replaces the top (worst neighbor) only if it is ordered before it
+			*/
+			if (_capacity == 0) return;
+
+			Neighbor candidate{ distance, index };
+
+			if (_heap.size() < _capacity)
+			{
+				_heap.push_back(candidate);
+				std::push_heap(_heap.begin(), _heap.end());
+			}
+
+			else if (candidate < _heap.front())
+			{
+				std::pop_heap(_heap.begin(), _heap.end());
+				_heap.back() = candidate;
+				std::push_heap(_heap.begin(), _heap.end());
+			}
+		}
+
+		void NeighborHeap::reset(const std::size_t& capacity) noexcept
+		{
+			_heap.clear();
+			_capacity = capacity;
+		}
+
+		void NeighborHeap::sorted(std::vector<Neighbor>& result) noexcept
+		{
+			/*
+				sort_heap leaves the elements in increasing order
+			*/
+			std::sort_heap(_heap.begin(), _heap.end());
+
+			result.assign(_heap.begin(), _heap.end());
+
+			_heap.clear();
+		}
+
+		double NeighborHeap::worst() const noexcept
+		{
+			if (!full() || _heap.empty()) return std::numeric_limits<double>::infinity();
+
+			return _heap.front().Distance;
+		}
+
+		/*
+			Index class members
+		*/
+
+		bool Index::_readHeader(std::istream& in, const char* magic)
+		{
+			/*
+				Layout : magic (8 characters), metric and features (uint64 each), p (double)
+			*/
+			char read[8];
+			std::uint64_t header[2];
+			double p;
+
+			in.read(read, sizeof(read));
+			in.read(reinterpret_cast<char*>(header), sizeof(header));
+			in.read(reinterpret_cast<char*>(&p), sizeof(p));
+
+			if (!in || std::string(read, sizeof(read)) != std::string(magic, 8)) return false;
+
+			_metric = static_cast<distanceMetric>(header[0]);
+			_cols = static_cast<std::size_t>(header[1]);
+			_p = p;
+
+			return true;
+		}
+
+		std::uint64_t Index::_remaining(std::istream& in)
+		{
+			/*
+				The end is found by seeking to it and back. A stream that can not seek reports the position -1
+			*/
+			if (!in) return std::numeric_limits<std::uint64_t>::max();
+
+			std::istream::pos_type here = in.tellg();
+
+			if (here == std::istream::pos_type(-1)) return std::numeric_limits<std::uint64_t>::max();
+
+			in.seekg(0, std::ios_base::end);
+
+			std::istream::pos_type end = in.tellg();
+
+			in.clear();
+			in.seekg(here);
+
+			if (end == std::istream::pos_type(-1) || end < here) return std::numeric_limits<std::uint64_t>::max();
+
+			return static_cast<std::uint64_t>(end - here);
+		}
+
+		void Index::_writeHeader(std::ostream& out, const char* magic) const
+		{
+			std::uint64_t header[2] = { static_cast<std::uint64_t>(_metric), _cols };
+
+			out.write(magic, 8);
+			out.write(reinterpret_cast<const char*>(header), sizeof(header));
+			out.write(reinterpret_cast<const char*>(&_p), sizeof(_p));
+		}
+
+		std::size_t Index::features() const noexcept
+		{
+			return _cols;
+		}
+
+		bool Index::holdsObservations() const noexcept
+		{
+			return false;
+		}
+
+		const double* Index::observation(const std::size_t& /*id*/) const noexcept
+		{
+			return nullptr;
+		}
+
+		void Index::radius(const std::vector<double>& x, const double& r, std::vector<Neighbor>& result, const std::size_t& effort) const
+		{
+			/*
+				The neighbors come back in increasing order of distance, so once the last one is out of the radius
+				(or fewer than asked are returned) every observation within it has been seen
+			*/
+			result.clear();
+
+			std::size_t rows = size();
+
+			if (rows == 0 || r < 0) return;
+
+			for (std::size_t k = std::min<std::size_t>(16, rows); ; k = std::min(2 * k, rows))
+			{
+				query(x, k, result, effort);
+
+				if (result.size() < k || result.back().Distance > r || k == rows) break;
+			}
+
+			result.erase(std::upper_bound(result.begin(), result.end(), Neighbor{ r, std::numeric_limits<std::size_t>::max() }), result.end());
+		}
+	}
+}
@@ -0,0 +1,507 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Neighbors/IvfPq.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			IvfPq class members
+		*/
+
+		std::size_t IvfPq::_assign(const double* x) const noexcept
+		{
+			std::size_t best = 0;
+			double bestDistance = std::numeric_limits<double>::infinity();
+
+			for (std::size_t list = 0; list < _lists; ++list)
+			{
+				double distance = functions::distance::reduced(x, _coarse.data() + list * _cols, _cols, _metric, _p);
+
+				if (distance < bestDistance)
+				{
+					bestDistance = distance;
+					best = list;
+				}
+			}
+
+			return best;
+		}
+
+		void IvfPq::_encode(const double* residual, std::uint8_t* codes) const noexcept
+		{
+			for (std::size_t part = 0; part < _parts; ++part)
+			{
+				std::size_t begin = _offsets[part], dimensions = _offsets[part + 1] - begin;
+				const double* codebook = _codebooks.data() + _centroids * begin;
+
+				std::size_t best = 0;
+				double bestDistance = std::numeric_limits<double>::infinity();
+
+				for (std::size_t centroid = 0; centroid < _centroids; ++centroid)
+				{
+					double distance = functions::distance::reduced(residual + begin, codebook + centroid * dimensions, dimensions, _metric, _p);
+
+					if (distance < bestDistance)
+					{
+						bestDistance = distance;
+						best = centroid;
+					}
+				}
+
+				codes[part] = static_cast<std::uint8_t>(best);
+			}
+		}
+
+		void IvfPq::_kMeans(const std::vector<double>& data, const std::size_t& dimensions, const std::size_t& k, std::vector<double>& centroids, std::mt19937& generator) const
+		{
+			/*
+				1) Start from k distinct random observations
+				2) Assign every observation to its closest centroid (in parallel). Stop if no assignment changed
+				3) Move every centroid to the mean of its observations
+			*/
+			const std::size_t iterations = 20;
+			std::size_t rows = data.size() / dimensions;
+
+			std::vector<std::size_t> order(rows);
+			std::iota(order.begin(), order.end(), 0);
+			std::shuffle(order.begin(), order.end(), generator);
+
+			centroids.resize(k * dimensions);
+			for (std::size_t centroid = 0; centroid < k; ++centroid)
+			{
+				std::copy(data.begin() + order[centroid] * dimensions, data.begin() + (order[centroid] + 1) * dimensions, centroids.begin() + centroid * dimensions);
+			}
+
+			std::vector<std::size_t> assigned(rows, k), counts;
+			std::vector<double> sums;
+			std::uniform_int_distribution<std::size_t> pick(0, rows - 1);
+
+			for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+			{
+				std::atomic<std::size_t> changes(0);
+
+				utils::parallel::forEach(0, rows, [&](std::size_t begin, std::size_t end)
+				{
+					std::size_t changed = 0;
+
+					for (std::size_t row = begin; row < end; ++row)
+					{
+						std::size_t best = 0;
+						double bestDistance = std::numeric_limits<double>::infinity();
+
+						for (std::size_t centroid = 0; centroid < k; ++centroid)
+						{
+							double distance = functions::distance::reduced(data.data() + row * dimensions, centroids.data() + centroid * dimensions, dimensions, distanceMetric::EUCLEDIAN, 2);
+
+							if (distance < bestDistance)
+							{
+								bestDistance = distance;
+								best = centroid;
+							}
+						}
+
+						if (assigned[row] != best)
+						{
+							assigned[row] = best;
+							++changed;
+						}
+					}
+
+					changes += changed;
+				}, Threads, 256);
+
+				if (changes == 0) break;
+
+				sums.assign(k * dimensions, 0);
+				counts.assign(k, 0);
+
+				for (std::size_t row = 0; row < rows; ++row)
+				{
+					++counts[assigned[row]];
+
+					for (std::size_t col = 0; col < dimensions; ++col)
+					{
+						sums[assigned[row] * dimensions + col] += data[row * dimensions + col];
+					}
+				}
+
+				for (std::size_t centroid = 0; centroid < k; ++centroid)
+				{
+					std::size_t source = pick(generator);
+
+					for (std::size_t col = 0; col < dimensions; ++col)
+					{
+						centroids[centroid * dimensions + col] = (counts[centroid] > 0) ? sums[centroid * dimensions + col] / static_cast<double>(counts[centroid]) : data[source * dimensions + col];
+					}
+				}
+			}
+		}
+
+		IvfPq::IvfPq(const std::size_t& lists, const std::size_t& probes, const std::size_t& subQuantizers, const std::size_t& threads, const unsigned int& seed)
+		{
+			Lists = std::max(lists, static_cast<std::size_t>(1));
+			Probes = std::max(probes, static_cast<std::size_t>(1));
+			SubQuantizers = std::max(subQuantizers, static_cast<std::size_t>(1));
+			TrainingSize = static_cast<std::size_t>(defaults::TRAINING_SIZE);
+			Threads = threads;
+			Seed = seed;
+			_metric = distanceMetric::EUCLEDIAN;
+			_p = static_cast<double>(defaults::P);
+			_cols = 0;
+			_lists = 0;
+			_parts = 0;
+			_centroids = 0;
+			_rows = 0;
+		}
+
+		void IvfPq::add(const data::Storage& X) // throws std::runtime_error
+		{
+			/*
+				The list and the codes of every observation are found in parallel, then appended to the lists in order
+			*/
+			if (_lists == 0) throw std::runtime_error("<In function cmll::neighbors::IvfPq::add()>Error : The index is not trained. Use train() first");
+
+			std::vector<std::uint32_t> lists(X.size());
+			std::vector<std::uint8_t> codes(X.size() * _parts);
+
+			utils::parallel::forEach(0, X.size(), [&](std::size_t begin, std::size_t end)
+			{
+				std::vector<double> residual(_cols);
+
+				for (std::size_t row = begin; row < end; ++row)
+				{
+					std::size_t list = _assign(X[row].data());
+
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						residual[col] = X[row][col] - _coarse[list * _cols + col];
+					}
+
+					lists[row] = static_cast<std::uint32_t>(list);
+					_encode(residual.data(), codes.data() + row * _parts);
+				}
+			}, Threads, 256);
+
+			for (std::size_t row = 0; row < X.size(); ++row)
+			{
+				_codes[lists[row]].insert(_codes[lists[row]].end(), codes.begin() + row * _parts, codes.begin() + (row + 1) * _parts);
+				_ids[lists[row]].push_back(static_cast<std::uint32_t>(_rows + row));
+			}
+
+			_rows += X.size();
+		}
+
+		void IvfPq::build(const data::Storage& X, const distanceMetric& metric, const double& p)
+		{
+			train(X, metric, p);
+
+			if (_lists > 0) add(X);
+		}
+
+		void IvfPq::load(std::istream& in) // throws std::runtime_error
+		{
+			/*
+				Reads the layout written by save()
+			*/
+			std::uint64_t header[8] = { 0 };
+
+			if (!_readHeader(in, "CMLLIVF1")) throw std::runtime_error("<In function cmll::neighbors::IvfPq::load()>Error : The stream does not hold an IVF_PQ index");
+
+			in.read(reinterpret_cast<char*>(header), sizeof(header));
+
+			Lists = static_cast<std::size_t>(header[0]);
+			Probes = static_cast<std::size_t>(header[1]);
+			SubQuantizers = static_cast<std::size_t>(header[2]);
+			TrainingSize = static_cast<std::size_t>(header[3]);
+			_lists = static_cast<std::size_t>(header[4]);
+			_parts = static_cast<std::size_t>(header[5]);
+			_centroids = static_cast<std::size_t>(header[6]);
+			_rows = static_cast<std::size_t>(header[7]);
+
+			_read(in, _coarse);
+			_read(in, _codebooks);
+			_read(in, _offsets);
+
+			// Every list holds at least the counts of its codes and indexes
+			if (in && _lists > _remaining(in) / (2 * sizeof(std::uint64_t))) throw std::runtime_error("<In function cmll::neighbors::IvfPq::load()>Error : The stream holds fewer lists than it counts");
+
+			_codes.assign(in ? _lists : 0, std::vector<std::uint8_t>());
+			_ids.assign(_codes.size(), std::vector<std::uint32_t>());
+
+			for (std::size_t list = 0; list < _codes.size() && in; ++list)
+			{
+				_read(in, _codes[list]);
+				_read(in, _ids[list]);
+			}
+
+			if (!in) throw std::runtime_error("<In function cmll::neighbors::IvfPq::load()>Error : The stream ended before the index was read");
+		}
+
+		std::size_t IvfPq::memoryUsage() const noexcept
+		{
+			std::size_t bytes = (_coarse.size() + _codebooks.size()) * sizeof(double);
+
+			for (std::size_t list = 0; list < _codes.size(); ++list)
+			{
+				bytes += _codes[list].size() * sizeof(std::uint8_t) + _ids[list].size() * sizeof(std::uint32_t);
+			}
+
+			return bytes;
+		}
+
+		void IvfPq::query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort) const
+		{
+			/*
+				1) Order the lists by the distance of their centroid from x and keep the first probes
+				2) For every list kept :
+				   table[part][centroid] = reduced distance of the part of (x - list centroid) from the centroid of the part
+				   and the distance of an observation is the sum over the parts of table[part][code of the part]
+			*/
+			result.clear();
+
+			if (_rows == 0 || k == 0) return;
+
+			std::size_t probes = std::min((effort > 0) ? effort : Probes, _lists);
+
+			std::vector<Neighbor> lists(_lists);
+			for (std::size_t list = 0; list < _lists; ++list)
+			{
+				lists[list] = { functions::distance::reduced(x.data(), _coarse.data() + list * _cols, _cols, _metric, _p), list };
+			}
+
+			std::partial_sort(lists.begin(), lists.begin() + static_cast<std::ptrdiff_t>(probes), lists.end());
+
+			NeighborHeap heap(k);
+			std::vector<double> residual(_cols), table(_parts * _centroids);
+
+			for (std::size_t probe = 0; probe < probes; ++probe)
+			{
+				std::size_t list = lists[probe].Index;
+				const std::vector<std::uint8_t>& codes = _codes[list];
+
+				if (codes.empty()) continue;
+
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					residual[col] = x[col] - _coarse[list * _cols + col];
+				}
+
+				for (std::size_t part = 0; part < _parts; ++part)
+				{
+					std::size_t begin = _offsets[part], dimensions = _offsets[part + 1] - begin;
+					const double* codebook = _codebooks.data() + _centroids * begin;
+
+					for (std::size_t centroid = 0; centroid < _centroids; ++centroid)
+					{
+						table[part * _centroids + centroid] = functions::distance::reduced(residual.data() + begin, codebook + centroid * dimensions, dimensions, _metric, _p);
+					}
+				}
+
+				const std::uint8_t* code = codes.data();
+				const std::uint32_t* ids = _ids[list].data();
+				std::size_t observations = _ids[list].size();
+
+				for (std::size_t observation = 0; observation < observations; ++observation, code += _parts)
+				{
+					double distance = 0;
+
+					for (std::size_t part = 0; part < _parts; ++part)
+					{
+						distance += table[part * _centroids + code[part]];
+					}
+
+					heap.push(distance, ids[observation]);
+				}
+			}
+
+			heap.sorted(result);
+
+			for (Neighbor& neighbor : result)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, _metric, _p);
+			}
+		}
+
+		void IvfPq::remove(const std::vector<std::uint8_t>& removed) noexcept
+		{
+			/*
+				An observation keeps its place in its list, so the lists are compacted in place and every index
+				is replaced by the number of observations kept before it
+			*/
+			std::vector<std::uint32_t> numbers(_rows);
+			std::uint32_t kept = 0;
+
+			for (std::size_t row = 0; row < _rows; ++row)
+			{
+				numbers[row] = kept;
+
+				if (row >= removed.size() || !removed[row]) ++kept;
+			}
+
+			for (std::size_t list = 0; list < _ids.size(); ++list)
+			{
+				std::vector<std::uint32_t>& ids = _ids[list];
+				std::vector<std::uint8_t>& codes = _codes[list];
+				std::size_t count = 0;
+
+				for (std::size_t entry = 0; entry < ids.size(); ++entry)
+				{
+					if (ids[entry] < removed.size() && removed[ids[entry]]) continue;
+
+					std::copy(codes.begin() + entry * _parts, codes.begin() + (entry + 1) * _parts, codes.begin() + count * _parts);
+					ids[count++] = numbers[ids[entry]];
+				}
+
+				ids.resize(count);
+				codes.resize(count * _parts);
+			}
+
+			_rows = kept;
+		}
+
+		void IvfPq::save(std::ostream& out) const
+		{
+			/*
+				Layout (native byte order) :
+
+				header (see Index), Lists, Probes, SubQuantizers, TrainingSize, lists, parts, centroids per part, observations (uint64 each),
+				then coarse centroids, codebooks, part offsets and the codes and indexes of every list, each preceded by its count
+			*/
+			std::uint64_t header[8] = { Lists, Probes, SubQuantizers, TrainingSize, _lists, _parts, _centroids, _rows };
+
+			_writeHeader(out, "CMLLIVF1");
+			out.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+			_write(out, _coarse);
+			_write(out, _codebooks);
+			_write(out, _offsets);
+
+			for (std::size_t list = 0; list < _lists; ++list)
+			{
+				_write(out, _codes[list]);
+				_write(out, _ids[list]);
+			}
+		}
+
+		std::size_t IvfPq::size() const noexcept
+		{
+			return _rows;
+		}
+
+		void IvfPq::train(const data::Storage& X, const distanceMetric& metric, const double& p)
+		{
+			/*
+				1) Pick at most TrainingSize observations at random
+				2) Coarse centroids = k-means of the sample with min(Lists, sample size) clusters
+				3) Cut the features into min(SubQuantizers, features) parts of (almost) equal size
+				4) For every part, centroids = k-means of that part of the residuals of the sample, with min(256, sample size) clusters
+			*/
+			_metric = metric;
+			_p = p;
+
+			_coarse.clear();
+			_codebooks.clear();
+			_offsets.clear();
+			_codes.clear();
+			_ids.clear();
+			_lists = 0;
+			_parts = 0;
+			_centroids = 0;
+			_rows = 0;
+
+			if (X.size() == 0 || X[0].size() == 0) return;
+
+			_cols = X[0].size();
+
+			std::mt19937 generator(Seed);
+
+			std::vector<std::size_t> order(X.size());
+			std::iota(order.begin(), order.end(), 0);
+			std::shuffle(order.begin(), order.end(), generator);
+			order.resize(std::min(order.size(), std::max(TrainingSize, static_cast<std::size_t>(1))));
+
+			std::size_t samples = order.size();
+			std::vector<double> sample(samples * _cols);
+
+			for (std::size_t row = 0; row < samples; ++row)
+			{
+				std::copy(X[order[row]].begin(), X[order[row]].end(), sample.begin() + row * _cols);
+			}
+
+			_lists = std::min(Lists, samples);
+			_kMeans(sample, _cols, _lists, _coarse, generator);
+
+			for (std::size_t row = 0; row < samples; ++row)
+			{
+				std::size_t list = _assign(sample.data() + row * _cols);
+
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					sample[row * _cols + col] -= _coarse[list * _cols + col];
+				}
+			}
+
+			_parts = std::min(SubQuantizers, _cols);
+			_centroids = std::min(static_cast<std::size_t>(256), samples);
+			_codebooks.resize(_centroids * _cols);
+			_offsets.resize(_parts + 1);
+
+			for (std::size_t part = 0; part <= _parts; ++part)
+			{
+				_offsets[part] = part * (_cols / _parts) + std::min(part, _cols % _parts);
+			}
+
+			std::vector<double> partData, centroids;
+
+			for (std::size_t part = 0; part < _parts; ++part)
+			{
+				std::size_t begin = _offsets[part], dimensions = _offsets[part + 1] - begin;
+
+				partData.resize(samples * dimensions);
+				for (std::size_t row = 0; row < samples; ++row)
+				{
+					std::copy(sample.begin() + row * _cols + begin, sample.begin() + row * _cols + begin + dimensions, partData.begin() + row * dimensions);
+				}
+
+				_kMeans(partData, dimensions, _centroids, centroids, generator);
+
+				std::copy(centroids.begin(), centroids.end(), _codebooks.begin() + _centroids * begin);
+			}
+
+			_codes.resize(_lists);
+			_ids.resize(_lists);
+		}
+	}
+}
@@ -0,0 +1,345 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Neighbors/KdTree.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			KdTree class members
+		*/
+
+		double KdTree::_boxDistance(const double* x, const std::size_t& node) const noexcept
+		{
+			/*
+				For every feature the gap between x and the box is max(lower - x, 0, x - upper).
+				The gaps are combined the same way the metric combines differences
+			*/
+			const double* lower = _lower.data() + node * _cols;
+			const double* upper = _upper.data() + node * _cols;
+			double sum = 0;
+
+			for (std::size_t col = 0; col < _cols; ++col)
+			{
+				double gap = std::max(std::max(lower[col] - x[col], 0.0), x[col] - upper[col]);
+
+				if (_metric == distanceMetric::EUCLEDIAN) sum += gap * gap;
+				else if (_metric == distanceMetric::MANHATTAN) sum += gap;
+				else sum += std::pow(gap, _p);
+			}
+
+			return sum;
+		}
+
+		void KdTree::_build(const data::Storage& X, std::vector<std::size_t>& order, std::size_t begin, std::size_t end)
+		{
+			/*
+				1) Create the node and calculate its bounding box
+				2) If it has more than LeafSize observations, split at the median of the feature with the largest spread.
+				   The left child is created right after the node (pre order) and the right child after the whole left sub tree
+			*/
+			std::size_t node = _nodes.size();
+
+			_nodes.push_back({ begin, end, 0 });
+			_lower.insert(_lower.end(), X[order[begin]].begin(), X[order[begin]].end());
+			_upper.insert(_upper.end(), X[order[begin]].begin(), X[order[begin]].end());
+
+			double* lower = _lower.data() + node * _cols;
+			double* upper = _upper.data() + node * _cols;
+
+			for (std::size_t row = begin + 1; row < end; ++row)
+			{
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					lower[col] = std::min(lower[col], X[order[row]][col]);
+					upper[col] = std::max(upper[col], X[order[row]][col]);
+				}
+			}
+
+			if (end - begin <= LeafSize) return;
+
+			std::size_t dimension = 0;
+			double spread = -1;
+
+			for (std::size_t col = 0; col < _cols; ++col)
+			{
+				if (upper[col] - lower[col] > spread)
+				{
+					spread = upper[col] - lower[col];
+					dimension = col;
+				}
+			}
+
+			// Every observation of the node is the same point
+			if (spread <= 0) return;
+
+			std::size_t middle = begin + (end - begin) / 2;
+
+			std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end, [&](std::size_t index1, std::size_t index2) {return X[index1][dimension] < X[index2][dimension]; });
+
+			_build(X, order, begin, middle);
+
+			_nodes[node].Right = _nodes.size();
+
+			_build(X, order, middle, end);
+		}
+
+		KdTree::KdTree(const std::size_t& leafSize)
+		{
+			/*
+				A leaf size of 0 would never stop splitting
+			*/
+			LeafSize = std::max(leafSize, static_cast<std::size_t>(1));
+			_metric = distanceMetric::EUCLEDIAN;
+			_p = static_cast<double>(defaults::P);
+			_cols = 0;
+		}
+
+		void KdTree::build(const data::Storage& X, const distanceMetric& metric, const double& p)
+		{
+			/*
+				The tree is built over the indexes of the observations. Once done the observations are copied in leaf order
+			*/
+			_metric = metric;
+			_p = p;
+
+			_nodes.clear();
+			_lower.clear();
+			_upper.clear();
+			_points = Values<double>();
+			_ids.clear();
+			_positions.clear();
+
+			if (X.size() == 0) return;
+
+			_cols = X[0].size();
+
+			std::vector<std::size_t> order(X.size());
+			for (std::size_t row = 0; row < order.size(); ++row)
+			{
+				order[row] = row;
+			}
+
+			_build(X, order, 0, order.size());
+
+			std::vector<double> points(order.size() * _cols);
+
+			for (std::size_t row = 0; row < order.size(); ++row)
+			{
+				std::copy(X[order[row]].begin(), X[order[row]].end(), points.begin() + row * _cols);
+			}
+
+			_points = Values<double>(std::move(points));
+
+			_ids = std::move(order);
+			_positions.resize(_ids.size());
+
+			for (std::size_t row = 0; row < _ids.size(); ++row)
+			{
+				_positions[_ids[row]] = row;
+			}
+		}
+
+		bool KdTree::holdsObservations() const noexcept
+		{
+			return true;
+		}
+
+		void KdTree::load(std::istream& in) // throws std::runtime_error
+		{
+			/*
+				Reads the layout written by save()
+			*/
+			std::uint64_t leafSize = 0;
+
+			if (!_readHeader(in, "CMLLKDT1")) throw std::runtime_error("<In function cmll::neighbors::KdTree::load()>Error : The stream does not hold a KD tree");
+
+			in.read(reinterpret_cast<char*>(&leafSize), sizeof(leafSize));
+
+			_read(in, _nodes);
+			_read(in, _lower);
+			_read(in, _upper);
+			_read(in, _points);
+			_read(in, _ids);
+
+			if (!in) throw std::runtime_error("<In function cmll::neighbors::KdTree::load()>Error : The stream ended before the tree was read");
+
+			_positions.assign(_ids.size(), 0);
+
+			for (std::size_t row = 0; row < _ids.size(); ++row)
+			{
+				if (_ids[row] >= _ids.size()) throw std::runtime_error("<In function cmll::neighbors::KdTree::load()>Error : The stream holds an observation out of the tree");
+
+				_positions[_ids[row]] = row;
+			}
+
+			LeafSize = static_cast<std::size_t>(leafSize);
+		}
+
+		const double* KdTree::observation(const std::size_t& id) const noexcept
+		{
+			return _points.data() + _positions[id] * _cols;
+		}
+
+		void KdTree::query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& /*effort*/) const
+		{
+			/*
+				Depth first search with an explicit stack of (distance to box, node).
+
+				The farther child is pushed first so the closer child is visited first. A node is skipped when popped if its box
+				is farther than the current k-th neighbor. Every observation of a leaf is compared with the reduced distance,
+				reading the contiguous block of the leaf.
+			*/
+			result.clear();
+
+			if (_nodes.empty() || k == 0) return;
+
+			NeighborHeap heap(k);
+			std::vector<std::pair<double, std::size_t>> stack;
+
+			stack.emplace_back(_boxDistance(x.data(), 0), 0);
+
+			while (!stack.empty())
+			{
+				std::pair<double, std::size_t> top = stack.back();
+				stack.pop_back();
+
+				if (top.first > heap.worst()) continue;
+
+				const Node& node = _nodes[top.second];
+
+				if (node.Right == 0)
+				{
+					for (std::size_t row = node.Begin; row < node.End; ++row)
+					{
+						heap.push(functions::distance::reduced(x.data(), _points.data() + row * _cols, _cols, _metric, _p), _ids[row]);
+					}
+					continue;
+				}
+
+				std::size_t left = top.second + 1;
+				double leftDistance = _boxDistance(x.data(), left), rightDistance = _boxDistance(x.data(), node.Right);
+
+				if (leftDistance <= rightDistance)
+				{
+					stack.emplace_back(rightDistance, node.Right);
+					stack.emplace_back(leftDistance, left);
+				}
+
+				else
+				{
+					stack.emplace_back(leftDistance, left);
+					stack.emplace_back(rightDistance, node.Right);
+				}
+			}
+
+			heap.sorted(result);
+
+			for (Neighbor& neighbor : result)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, _metric, _p);
+			}
+		}
+
+		void KdTree::radius(const std::vector<double>& x, const double& r, std::vector<Neighbor>& result, const std::size_t& /*effort*/) const
+		{
+			/*
+				Same walk as query() with the radius in place of the k-th neighbor : a node is skipped if its box is farther than r
+				and the distance of an observation is abandoned as soon as it is beyond r (see reducedWithin()).
+				The order children are visited in does not matter since the bound never shrinks
+			*/
+			result.clear();
+
+			if (_nodes.empty() || r < 0) return;
+
+			double bound = functions::distance::toReduced(r, _metric, _p);
+			std::vector<std::size_t> stack(1, 0);
+
+			while (!stack.empty())
+			{
+				std::size_t top = stack.back();
+				stack.pop_back();
+
+				if (_boxDistance(x.data(), top) > bound) continue;
+
+				const Node& node = _nodes[top];
+
+				if (node.Right == 0)
+				{
+					for (std::size_t row = node.Begin; row < node.End; ++row)
+					{
+						double distance = functions::distance::reducedWithin(x.data(), _points.data() + row * _cols, _cols, _metric, _p, bound);
+
+						if (distance <= bound) result.push_back(Neighbor{ distance, _ids[row] });
+					}
+					continue;
+				}
+
+				stack.push_back(node.Right);
+				stack.push_back(top + 1);
+			}
+
+			std::sort(result.begin(), result.end());
+
+			for (Neighbor& neighbor : result)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, _metric, _p);
+			}
+		}
+
+		void KdTree::save(std::ostream& out) const
+		{
+			/*
+				Layout (native byte order) :
+
+				header (see Index), leaf size, then nodes, lower bounds, upper bounds, observations and indexes, each preceded by its count
+			*/
+			std::uint64_t leafSize = LeafSize;
+
+			_writeHeader(out, "CMLLKDT1");
+			out.write(reinterpret_cast<const char*>(&leafSize), sizeof(leafSize));
+
+			_write(out, _nodes);
+			_write(out, _lower);
+			_write(out, _upper);
+			_write(out, _points);
+			_write(out, _ids);
+		}
+
+		std::size_t KdTree::size() const noexcept
+		{
+			return _ids.size();
+		}
+	}
+}
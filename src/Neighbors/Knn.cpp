@@ -15,7 +15,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 8, 2020
-	* Last modified : April 19, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (.1.0)
 
@@ -42,369 +42,2520 @@ namespace cmll
 			Linear Regressor class members
 		*/
 		
-		void KnnRegressor::_calculateDistances(const data::Storage& XTest, data::Storage& distances) noexcept
+		void KnnRegressor::_bruteNeighbors(const data::Storage& XTest, const std::size_t& first, const std::size_t& last, const std::size_t& k, std::vector<Neighbor>& neighbors) const noexcept
 		{
 			/*
-				For each test observation distances from all observations in Feature Matrix X are calculated by calling _distancesFromX()
+				The steps followed by the function are as follows
+
+				For every block of the queries first .. last
+				1) Reset a bounded heap per query (max(k, Rerank) candidates when quantized codes are re-ranked)
+				2) For every tile of X copy its observations to the contiguous buffer (the codes are already contiguous)
+				   and offer the reduced distance of every observation of the tile to the heap of every query of the block
+				3) Take the candidates out of the heaps. If re-ranking, calculate their full precision distances and sort again.
+				   Keep the first k
+
+				Ties are broken by the index of the observation, as with a stable sort of all the distances.
+				Erased observations are skipped
+			*/
+
+			// Queries per block and doubles per tile of X (256 KB)
+			const std::size_t queryBlock = 64, tileValues = 32768;
+
+			bool quantized = _quantizer.rows() > 0;
+			bool rerank = quantized && Rerank > 0 && _fullPrecision();
+			bool mapped = _storeX != nullptr;
+
+			std::size_t observations = quantized ? _quantizer.rows() : _observations();
+			std::size_t cols = (XTest.size() > 0) ? XTest[0].size() : 0;
+			std::size_t tileRows = std::max(tileValues / std::max(cols, static_cast<std::size_t>(1)), static_cast<std::size_t>(1));
+			std::size_t candidates = rerank ? std::max(k, Rerank) : k;
+			const std::uint8_t* erased = (_erasedCount > 0) ? _erased.data() : nullptr;
+
+			std::vector<NeighborHeap> heaps(std::min(queryBlock, last - first));
+			std::vector<std::vector<float>> prepared(quantized ? heaps.size() : 0);
+			std::vector<double> tile;
+			std::vector<Neighbor> found;
+
+			neighbors.resize((last - first) * k);
+
+			for (std::size_t blockBegin = first; blockBegin < last; blockBegin += queryBlock)
+			{
+				std::size_t blockEnd = std::min(blockBegin + queryBlock, last);
+
+				for (std::size_t query = blockBegin; query < blockEnd; ++query)
+				{
+					heaps[query - blockBegin].reset(candidates);
+
+					if (quantized) _quantizer.prepare(XTest[query], prepared[query - blockBegin]);
+				}
+
+				for (std::size_t tileBegin = 0; tileBegin < observations; tileBegin += tileRows)
+				{
+					std::size_t tileEnd = std::min(tileBegin + tileRows, observations);
+
+					if (quantized)
+					{
+						for (std::size_t query = blockBegin; query < blockEnd; ++query)
+						{
+							NeighborHeap& heap = heaps[query - blockBegin];
+
+							for (std::size_t row = tileBegin; row < tileEnd; ++row)
+							{
+								if (erased != nullptr && erased[row]) continue;
+
+								heap.push(_quantizer.distance(prepared[query - blockBegin], row, Metric, P), row);
+							}
+						}
+						continue;
+					}
+
+					// A loaded training set is already contiguous
+					const double* block = mapped ? _storeX + tileBegin * cols : nullptr;
+
+					if (!mapped)
+					{
+						tile.resize((tileEnd - tileBegin) * cols);
+
+						for (std::size_t row = tileBegin; row < tileEnd; ++row)
+						{
+							if (erased != nullptr && erased[row]) continue;
+
+							std::copy(_observation(row), _observation(row) + cols, tile.begin() + (row - tileBegin) * cols);
+						}
+
+						block = tile.data();
+					}
+
+					for (std::size_t query = blockBegin; query < blockEnd; ++query)
+					{
+						NeighborHeap& heap = heaps[query - blockBegin];
+						const double* x = XTest[query].data();
+
+						for (std::size_t row = tileBegin; row < tileEnd; ++row)
+						{
+							if (erased != nullptr && erased[row]) continue;
+
+							heap.push(functions::distance::reduced(x, block + (row - tileBegin) * cols, cols, Metric, P), row);
+						}
+					}
+				}
+
+				for (std::size_t query = blockBegin; query < blockEnd; ++query)
+				{
+					heaps[query - blockBegin].sorted(found);
+
+					if (rerank)
+					{
+						for (Neighbor& neighbor : found)
+						{
+							neighbor.Distance = functions::distance::reduced(XTest[query].data(), _observation(neighbor.Index), cols, Metric, P);
+						}
+
+						std::sort(found.begin(), found.end());
+					}
+
+					std::copy(found.begin(), found.begin() + static_cast<std::ptrdiff_t>(k), neighbors.begin() + static_cast<std::ptrdiff_t>((query - first) * k));
+				}
+			}
+		}
+
+		std::shared_ptr<Index> KnnRegressor::_createIndex(const searchAlgorithm& algorithm) const
+		{
+			if (algorithm == searchAlgorithm::KD_TREE) return std::make_shared<KdTree>(LeafSize);
+
+			if (algorithm == searchAlgorithm::BALL_TREE) return std::make_shared<BallTree>(LeafSize, Threads);
+
+			if (algorithm == searchAlgorithm::HNSW) return std::make_shared<Hnsw>(M, EfConstruction, EfSearch, Threads);
+
+			if (algorithm == searchAlgorithm::IVF_PQ) return std::make_shared<IvfPq>(Lists, Probes, SubQuantizers, Threads);
+
+			if (algorithm == searchAlgorithm::LSH) return std::make_shared<Lsh>(Tables, HashFunctions, Probes, Width, Threads);
+
+			return nullptr;
+		}
+
+		bool KnnRegressor::_fullPrecision() const noexcept
+		{
+			return _storeX != nullptr || (X.size() > 0 && X.size() == y.size()) || (_index && _index->holdsObservations());
+		}
+
+		std::size_t KnnRegressor::_kNeighbors(const data::Storage& XTest, const std::size_t& first, const std::size_t& last, std::vector<std::size_t>& indexes, std::vector<double>& distances) const noexcept
+		{
+			/*
+				If an index is built every observation of first .. last is simply queried, otherwise all the observations are compared.
+				Reduced distances are converted to actual distances at the end.
+				IVF_PQ distances are approximate, so with Rerank set max(K, Rerank) candidates are asked for and sorted again by their exact distances
+
+				With an index :
+				1) Its neighbors are turned into rows and the erased ones dropped. While that leaves less than k, twice as many are asked for
+				   (IVF_PQ finally probes all its lists)
+				2) The observations inserted since the index was built are compared by brute force and merged with them
+				3) If less than k neighbors are still found (HNSW and LSH can miss observations), the query is compared with every observation
+			*/
+			std::size_t observations = _observations() - _erasedCount;
+			std::size_t k = std::min(K, observations);
+
+			indexes.resize((last - first) * k);
+			distances.resize((last - first) * k);
+
+			if (_index)
+			{
+				bool ivf = Algorithm == searchAlgorithm::IVF_PQ;
+				bool rerank = ivf && Rerank > 0 && _fullPrecision();
+				bool brute = _fullPrecision() || _quantizer.rows() > 0;
+				std::size_t indexed = _index->size();
+				std::vector<Neighbor> neighbors, inserted;
+				NeighborHeap heap(k);
+
+				for (std::size_t row = first; row < last; ++row)
+				{
+					std::size_t asked = std::min(k + std::min(_staleRows.size(), k), indexed);
+					std::size_t effort = (ivf || Algorithm == searchAlgorithm::LSH) ? Probes : EfSearch;
+
+					while (true)
+					{
+						_index->query(XTest[row], rerank ? std::max(asked, Rerank) : asked, neighbors, effort);
+
+						std::size_t kept = 0;
+
+						for (const Neighbor& neighbor : neighbors)
+						{
+							std::size_t observation = _indexRows ? (*_indexRows)[neighbor.Index] : neighbor.Index;
+
+							if (_erasedCount > 0 && _erased[observation]) continue;
+
+							neighbors[kept++] = { neighbor.Distance, observation };
+						}
+
+						neighbors.resize(kept);
+
+						if (kept >= k) break;
+
+						if (asked < indexed)
+						{
+							asked = std::min(2 * asked, indexed);
+							continue;
+						}
+
+						// Every indexed observation was asked for. IVF_PQ only returns those of the probed lists, so all the lists are probed once
+						if (!ivf || effort == std::numeric_limits<std::size_t>::max()) break;
+
+						effort = std::numeric_limits<std::size_t>::max();
+					}
+
+					if (rerank)
+					{
+						for (Neighbor& neighbor : neighbors)
+						{
+							neighbor.Distance = functions::distance::fromReduced(functions::distance::reduced(XTest[row].data(), _observation(neighbor.Index), XTest[row].size(), Metric, P), Metric, P);
+						}
+
+						std::sort(neighbors.begin(), neighbors.end());
+					}
+
+					if (_delta.size() > 0)
+					{
+						heap.reset(k);
+
+						for (std::size_t observation = 0; observation < _delta.size(); ++observation)
+						{
+							if (_erasedCount > 0 && _erased[_indexEnd + observation]) continue;
+
+							heap.push(functions::distance::reduced(XTest[row].data(), _delta[observation].data(), _delta[observation].size(), Metric, P), _indexEnd + observation);
+						}
+
+						heap.sorted(inserted);
+
+						for (Neighbor& neighbor : inserted)
+						{
+							neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, Metric, P);
+						}
+
+						neighbors.insert(neighbors.end(), inserted.begin(), inserted.end());
+						std::sort(neighbors.begin(), neighbors.end());
+					}
+
+					if (neighbors.size() < k && brute)
+					{
+						_bruteNeighbors(XTest, row, row + 1, k, neighbors);
+
+						for (Neighbor& neighbor : neighbors)
+						{
+							neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, Metric, P);
+						}
+					}
+
+					for (std::size_t col = 0; col < k && col < neighbors.size(); ++col)
+					{
+						indexes[(row - first) * k + col] = neighbors[col].Index;
+						distances[(row - first) * k + col] = neighbors[col].Distance;
+					}
+				}
+				return k;
+			}
+
+			std::vector<Neighbor> neighbors;
+
+			_bruteNeighbors(XTest, first, last, k, neighbors);
+
+			for (std::size_t neighbor = 0; neighbor < neighbors.size(); ++neighbor)
+			{
+				indexes[neighbor] = neighbors[neighbor].Index;
+				distances[neighbor] = functions::distance::fromReduced(neighbors[neighbor].Distance, Metric, P);
+			}
+
+			return k;
+		}
+
+		double KnnRegressor::_label(const std::size_t& row) const noexcept
+		{
+			return (_storeY != nullptr) ? _storeY[row] : y[row][0];
+		}
+
+		const double* KnnRegressor::_observation(const std::size_t& row) const noexcept
+		{
+			/*
+				Without X the rows the index covers are read back from it. Its rows are ascending, so the id of a row is found by bisection
+			*/
+			if (_storeX != nullptr) return _storeX + row * _storeCols;
+
+			if (X.size() > 0) return X[row].data();
+
+			if (row >= _indexEnd) return _delta[row - _indexEnd].data();
+
+			if (!_indexRows) return _index->observation(row);
+
+			return _index->observation(static_cast<std::size_t>(std::lower_bound(_indexRows->begin(), _indexRows->end(), row) - _indexRows->begin()));
+		}
+
+		std::size_t KnnRegressor::_observations() const noexcept
+		{
+			return _store ? _storeRows : y.size();
+		}
+
+		std::size_t KnnRegressor::_queryBlock(const std::size_t& rows) const noexcept
+		{
+			/*
+				Blocks of up to 64 queries keep a tile of X in cache for all of them (see _bruteNeighbors()).
+				With few queries the blocks shrink so that every thread still gets about 4 of them to balance
+			*/
+			std::size_t blocks = 4 * utils::parallel::threads(Threads);
+
+			return std::min(static_cast<std::size_t>(64), std::max(static_cast<std::size_t>(1), rows / blocks));
+		}
+
+		void KnnRegressor::_radiusNeighbors(const std::vector<double>& x, const double& radius, std::vector<Neighbor>& neighbors) const noexcept
+		{
+			/*
+				Reduced distances are compared with the reduced radius and converted to actual distances at the end.
+
+				With an index :
+				1) Its neighbors within the radius are turned into rows and the erased ones dropped
+				2) The observations inserted since the index was built are compared by brute force and appended
+
+				Approximate distances (codes, IVF_PQ) are replaced by the full precision ones when they are available,
+				dropping the candidates that turn out to be out of the radius
+			*/
+			double bound = functions::distance::toReduced(radius, Metric, P);
+			bool approximate = false;
+
+			neighbors.clear();
+
+			if (_index)
+			{
+				bool ivf = Algorithm == searchAlgorithm::IVF_PQ;
+
+				_index->radius(x, radius, neighbors, (ivf || Algorithm == searchAlgorithm::LSH) ? Probes : EfSearch);
+
+				std::size_t kept = 0;
+
+				for (const Neighbor& neighbor : neighbors)
+				{
+					std::size_t observation = _indexRows ? (*_indexRows)[neighbor.Index] : neighbor.Index;
+
+					if (_erasedCount > 0 && _erased[observation]) continue;
+
+					neighbors[kept++] = { functions::distance::toReduced(neighbor.Distance, Metric, P), observation };
+				}
+
+				neighbors.resize(kept);
+
+				for (std::size_t observation = 0; observation < _delta.size(); ++observation)
+				{
+					if (_erasedCount > 0 && _erased[_indexEnd + observation]) continue;
+
+					double distance = functions::distance::reducedWithin(x.data(), _delta[observation].data(), x.size(), Metric, P, bound);
+
+					if (distance <= bound) neighbors.push_back({ distance, _indexEnd + observation });
+				}
+
+				approximate = ivf;
+			}
+
+			else if (_quantizer.rows() > 0)
+			{
+				std::vector<float> prepared;
+
+				_quantizer.prepare(x, prepared);
+
+				for (std::size_t row = 0; row < _quantizer.rows(); ++row)
+				{
+					if (_erasedCount > 0 && _erased[row]) continue;
+
+					double distance = _quantizer.distance(prepared, row, Metric, P);
+
+					if (distance <= bound) neighbors.push_back({ distance, row });
+				}
+
+				approximate = true;
+			}
+
+			else
+			{
+				for (std::size_t row = 0; row < _observations(); ++row)
+				{
+					if (_erasedCount > 0 && _erased[row]) continue;
+
+					double distance = functions::distance::reducedWithin(x.data(), _observation(row), x.size(), Metric, P, bound);
+
+					if (distance <= bound) neighbors.push_back({ distance, row });
+				}
+			}
+
+			if (approximate && _fullPrecision())
+			{
+				std::size_t kept = 0;
+
+				for (const Neighbor& neighbor : neighbors)
+				{
+					double distance = functions::distance::reducedWithin(x.data(), _observation(neighbor.Index), x.size(), Metric, P, bound);
+
+					if (distance <= bound) neighbors[kept++] = { distance, neighbor.Index };
+				}
+
+				neighbors.resize(kept);
+			}
+
+			std::sort(neighbors.begin(), neighbors.end());
+
+			for (Neighbor& neighbor : neighbors)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, Metric, P);
+			}
+		}
+
+		void KnnRegressor::_rebuildIndex()
+		{
+			/*
+				Only the erased rows the index holds and the inserted observations are copied here, so the caller may keep inserting
+				and erasing while the background thread works. Rows erased after this point are kept in _compactionStaleRows,
+				rows inserted after it stay in the brute force buffer.
+
+				The background thread walks the observations of the old index in the order it numbers them. Their rows are ascending,
+				so the stale ones are found by merging with the sorted stale rows. The rows of the new index stay ascending since the
+				inserted rows come after every indexed one
+			*/
+			if (!_index || _compaction.valid() || _store) return;
+
+			std::shared_ptr<Index> old = _index, fresh;
+			std::shared_ptr<IvfPq> ivf = std::dynamic_pointer_cast<IvfPq>(_index);
+
+			if (!ivf)
+			{
+				if (!_index->holdsObservations()) return;
+
+				fresh = _createIndex(Algorithm);
+
+				if (!fresh) return;
+			}
+
+			std::size_t rows = y.size();
+			std::vector<std::size_t> stale = _staleRows, insertedRows;
+			data::Storage inserted;
+
+			for (std::size_t row = _indexEnd; row < rows; ++row)
+			{
+				if (_erasedCount > 0 && _erased[row]) continue;
+
+				inserted.push_back(_delta[row - _indexEnd]);
+				insertedRows.push_back(row);
+			}
+
+			_compactionEnd = rows;
+			_compactionStaleRows.clear();
+
+			std::shared_ptr<const std::vector<std::size_t>> oldRows = _indexRows;
+			distanceMetric metric = Metric;
+			double p = P;
+
+			_compaction = std::async(std::launch::async, [old, oldRows, ivf, fresh, metric, p, rows](std::vector<std::size_t> stale, data::Storage inserted, const std::vector<std::size_t>& insertedRows)
+			{
+				std::sort(stale.begin(), stale.end());
+
+				std::shared_ptr<std::vector<std::size_t>> newRows = std::make_shared<std::vector<std::size_t>>();
+				std::vector<std::uint8_t> removed(ivf ? old->size() : 0, 0);
+				std::vector<std::size_t>::const_iterator next = stale.begin();
+				data::Storage live;
+
+				newRows->reserve(old->size() - stale.size() + inserted.size());
+
+				for (std::size_t id = 0; id < old->size(); ++id)
+				{
+					std::size_t row = oldRows ? (*oldRows)[id] : id;
+
+					while (next != stale.end() && *next < row) ++next;
+
+					if (next != stale.end() && *next == row)
+					{
+						if (ivf) removed[id] = 1;
+						continue;
+					}
+
+					newRows->push_back(row);
+
+					if (!ivf) live.emplace_back(old->observation(id), old->observation(id) + old->features());
+				}
+
+				newRows->insert(newRows->end(), insertedRows.begin(), insertedRows.end());
+
+				Rebuilt rebuilt;
+
+				// Rows only grow, so as many rows as observations means they are numbered in order
+				if (newRows->size() != rows) rebuilt.Rows = newRows;
+
+				if (ivf)
+				{
+					std::shared_ptr<IvfPq> index = std::make_shared<IvfPq>(*ivf);
+
+					index->remove(removed);
+					index->add(inserted);
+					rebuilt.Search = index;
+					return rebuilt;
+				}
+
+				live.insert(live.end(), std::make_move_iterator(inserted.begin()), std::make_move_iterator(inserted.end()));
+
+				fresh->build(live, metric, p);
+				rebuilt.Search = fresh;
+				return rebuilt;
+			}, std::move(stale), std::move(inserted), std::move(insertedRows)).share();
+		}
+
+		void KnnRegressor::_swapIndex(const selection& wait)
+		{
+			if (!_compaction.valid()) return;
+
+			if (wait == selection::NO && _compaction.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return;
+
+			Rebuilt rebuilt = _compaction.get();
+			_compaction = std::shared_future<Rebuilt>();
+
+			_index = rebuilt.Search;
+			_indexRows = rebuilt.Rows;
+
+			_delta.erase(_delta.begin(), _delta.begin() + static_cast<std::ptrdiff_t>(_compactionEnd - _indexEnd));
+			_indexEnd = _compactionEnd;
+			_staleRows = std::move(_compactionStaleRows);
+			_compactionStaleRows.clear();
+		}
+
+		void KnnRegressor::compact(const selection& wait)
+		{
+			/*
+				A finished rebuild is swapped in first. If none is running and there is something to compact, one is started.
+				When waiting, a rebuild started before the last insert() or erase() leaves observations out, so rebuilds are
+				repeated until none is left (nothing can be inserted or erased meanwhile, so the second one is the last)
+			*/
+			_swapIndex(selection::NO);
+
+			if (!_compaction.valid() && (_delta.size() > 0 || _staleRows.size() > 0)) _rebuildIndex();
+
+			while (wait == selection::YES && _compaction.valid())
+			{
+				_swapIndex(selection::YES);
+
+				if (_delta.size() > 0 || _staleRows.size() > 0) _rebuildIndex();
+			}
+		}
+
+		void KnnRegressor::erase(const std::vector<std::size_t>& rows) //throws std::runtime_error
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Check that the model is built and every row exists. If not throw std::runtime_error
+				2) Mark every row not yet erased and release its full precision copies (X and the brute force buffer)
+				3) Note the erased rows the index and the index being rebuilt still hold
+				4) Swap in a finished rebuild and start a new one if CompactionRatio is exceeded
+			*/
+			try
+			{
+				if (_store) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::erase()>Error :  A loaded model is read only. Use model() to build one that can be updated");
+
+				if (y.size() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::erase()>Error :  Model is not built yet. Use model() to fit the model()");
+
+				for (std::size_t row : rows)
+				{
+					if (row >= y.size()) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::erase()>Error :  Row " + std::to_string(row) + " does not exist");
+				}
+
+				_erased.resize(y.size(), 0);
+
+				for (std::size_t row : rows)
+				{
+					if (_erased[row]) continue;
+
+					_erased[row] = 1;
+					++_erasedCount;
+
+					if (_index && row < _indexEnd) _staleRows.push_back(row);
+					if (_compaction.valid() && row < _compactionEnd) _compactionStaleRows.push_back(row);
+
+					if (row < X.size()) std::vector<double>().swap(X[row]);
+					if (_index && row >= _indexEnd) std::vector<double>().swap(_delta[row - _indexEnd]);
+				}
+
+				_swapIndex(selection::NO);
+
+				if (_index && static_cast<double>(_delta.size() + _staleRows.size()) > CompactionRatio * static_cast<double>(std::max(_index->size(), static_cast<std::size_t>(1)))) _rebuildIndex();
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+		}
+
+		void KnnRegressor::insert(const data::Storage& X, const data::Storage& y) //throws std::runtime_error
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Check that the model is built and X and y have the same number of observations. If not throw std::runtime_error
+				2) Append the observations to X (when it is kept), to the codes (when quantized) and, with an index, to the brute
+				   force buffer. Every container grows geometrically so nothing stored is copied again on average
+				3) Swap in a finished rebuild and start a new one if CompactionRatio is exceeded
+			*/
+			try
+			{
+				if (_store) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::insert()>Error :  A loaded model is read only. Use model() to build one that can be updated");
+
+				if (this->y.size() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::insert()>Error :  Model is not built yet. Use model() to fit the model()");
+
+				if (X.size() != y.size()) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::insert()>Error :  X and y have different number of observations");
+
+				if (this->X.size() == this->y.size()) this->X.insert(this->X.end(), X.begin(), X.end());
+
+				if (_quantizer.rows() > 0) _quantizer.append(X);
+
+				if (_index) _delta.insert(_delta.end(), X.begin(), X.end());
+
+				this->y.insert(this->y.end(), y.begin(), y.end());
+
+				if (_erasedCount > 0) _erased.resize(this->y.size(), 0);
+
+				_swapIndex(selection::NO);
+
+				if (_index && static_cast<double>(_delta.size() + _staleRows.size()) > CompactionRatio * static_cast<double>(std::max(_index->size(), static_cast<std::size_t>(1)))) _rebuildIndex();
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+		}
+
+		void KnnRegressor::kNeighbors(const data::Storage& XTest, std::vector<std::size_t>& indexes, std::vector<double>& distances) const //throws std::runtime_error
+		{
+			try
+			{
+				if (_observations() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::kNeighbors()>Error :  Model is not built yet. Use model() to fit the model()");
+
+				std::size_t k = std::min(K, _observations() - _erasedCount);
+
+				indexes.resize(XTest.size() * k);
+				distances.resize(XTest.size() * k);
+
+				utils::parallel::forEach(0, XTest.size(), [&](std::size_t first, std::size_t last)
+				{
+					std::vector<std::size_t> blockIndexes;
+					std::vector<double> blockDistances;
+
+					_kNeighbors(XTest, first, last, blockIndexes, blockDistances);
+
+					std::copy(blockIndexes.begin(), blockIndexes.end(), indexes.begin() + static_cast<std::ptrdiff_t>(first * k));
+					std::copy(blockDistances.begin(), blockDistances.end(), distances.begin() + static_cast<std::ptrdiff_t>(first * k));
+				}, Threads, _queryBlock(XTest.size()));
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+		}
+
+		KnnRegressor::KnnRegressor(const std::size_t& k, const distanceMetric& metric, const double& p)
+		{
+			/*
+				Constructor to load defaults values for K - the number of neighbors to consider, the distance metric and value of order p for minkowski distance metric
+			*/
+			K = k;
+			Metric = metric;
+			P = p;
+			Quantization = quantization::NONE;
+			Rerank = 0;
+			Algorithm = searchAlgorithm::BRUTE;
+			LeafSize = static_cast<std::size_t>(defaults::LEAF_SIZE);
+			Threads = 0;
+			M = static_cast<std::size_t>(defaults::M);
+			EfConstruction = static_cast<std::size_t>(defaults::EF_CONSTRUCTION);
+			EfSearch = static_cast<std::size_t>(defaults::EF_SEARCH);
+			Lists = static_cast<std::size_t>(defaults::LISTS);
+			Probes = static_cast<std::size_t>(defaults::PROBES);
+			SubQuantizers = static_cast<std::size_t>(defaults::SUB_QUANTIZERS);
+			Tables = static_cast<std::size_t>(defaults::TABLES);
+			HashFunctions = static_cast<std::size_t>(defaults::HASH_FUNCTIONS);
+			Width = 0;
+			CompactionRatio = 0.1;
+			_indexEnd = 0;
+			_erasedCount = 0;
+			_compactionEnd = 0;
+			_storeX = nullptr;
+			_storeY = nullptr;
+			_storeRows = 0;
+			_storeCols = 0;
+			_storeClasses = 0;
+
+			if (Metric == distanceMetric::EUCLEDIAN)
+			{
+				DistanceCal = functions::distance::euclidean;
+			}
+
+			else if (Metric == distanceMetric::MANHATTAN)
+			{
+				DistanceCal = functions::distance::manhattan;
+			}
+
+			else if (Metric == distanceMetric::MINKOWSKI)
+			{
+				DistanceCal = functions::distance::minkowski;
+			}
+
+		}
+
+		void KnnRegressor::load(const std::string& filename) //throws std::runtime_error
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Map the file and check the header and that every section lies inside the file (see save() for the layout)
+				2) Point the training set and the labels into the mapping
+				3) Copy the tombstones and the index rows, and read the index through a stream over its section.
+				   The index points into the mapping for its observations instead of copying them (see Index::_read()),
+				   so the mapping is kept for as long as the index
+
+				The model is only replaced once the file is known to be valid
+			*/
+			try
+			{
+				std::shared_ptr<utils::MappedFile> store = std::make_shared<utils::MappedFile>(filename);
+
+				const char* bytes = store->data();
+				std::uint64_t header[16];
+				double p;
+
+				if (store->size() < 8 + sizeof(header) + sizeof(p) || std::memcmp(bytes, "CMLLKNN1", 8) != 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::load()>Error :  " + filename + " was not written by save()");
+
+				std::memcpy(header, bytes + 8, sizeof(header));
+				std::memcpy(&p, bytes + 8 + sizeof(header), sizeof(p));
+
+				std::size_t rows = static_cast<std::size_t>(header[1]), cols = static_cast<std::size_t>(header[2]);
+
+				for (std::size_t section = 6; section < 16; section += 2)
+				{
+					if (header[section] + header[section + 1] > store->size()) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::load()>Error :  " + filename + " is truncated");
+				}
+
+				if (header[0] != 1 || rows == 0 || (header[7] == 0 && header[15] == 0) || header[9] != rows * sizeof(double) || (header[7] != 0 && header[7] != rows * cols * sizeof(double)) || (header[11] != 0 && header[11] != rows)) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::load()>Error :  " + filename + " was not written by save()");
+
+				std::shared_ptr<Index> index;
+				searchAlgorithm algorithm = static_cast<searchAlgorithm>(header[5]);
+
+				if (header[15] > 0)
+				{
+					index = _createIndex(algorithm);
+
+					if (!index) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::load()>Error :  " + filename + " was not written by save()");
+
+					utils::MemoryBuffer buffer(bytes + header[14], static_cast<std::size_t>(header[15]));
+					std::istream in(&buffer);
+
+					index->load(in);
+
+					if (index->size() > rows || (header[13] > 0 && header[13] != index->size() * sizeof(std::uint64_t))) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::load()>Error :  " + filename + " was not written by save()");
+				}
+
+				const std::uint64_t* indexRows = reinterpret_cast<const std::uint64_t*>(bytes + header[12]);
+
+				for (std::size_t observation = 0; observation < header[13] / sizeof(std::uint64_t); ++observation)
+				{
+					if (indexRows[observation] >= rows) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::load()>Error :  " + filename + " was not written by save()");
+				}
+
+				model(data::Storage(), data::Storage());
+
+				Metric = static_cast<distanceMetric>(header[4]);
+				P = p;
+				Algorithm = algorithm;
+
+				if (Metric == distanceMetric::EUCLEDIAN) DistanceCal = functions::distance::euclidean;
+				else if (Metric == distanceMetric::MANHATTAN) DistanceCal = functions::distance::manhattan;
+				else if (Metric == distanceMetric::MINKOWSKI) DistanceCal = functions::distance::minkowski;
+
+				_store = store;
+				_storeX = (header[7] > 0) ? reinterpret_cast<const double*>(bytes + header[6]) : nullptr;
+				_storeY = reinterpret_cast<const double*>(bytes + header[8]);
+				_storeRows = rows;
+				_storeCols = cols;
+				_storeClasses = static_cast<std::size_t>(header[3]);
+
+				_erased.assign(bytes + header[10], bytes + header[10] + header[11]);
+				_erasedCount = static_cast<std::size_t>(std::count(_erased.begin(), _erased.end(), 1));
+
+				if (header[13] > 0) _indexRows = std::make_shared<std::vector<std::size_t>>(indexRows, indexRows + header[13] / sizeof(std::uint64_t));
+
+				_index = index;
+				_indexEnd = rows;
+
+				if (_index && _erasedCount > 0)
+				{
+					for (std::size_t observation = 0; observation < _index->size(); ++observation)
+					{
+						std::size_t row = _indexRows ? (*_indexRows)[observation] : observation;
+
+						if (_erased[row]) _staleRows.push_back(row);
+					}
+				}
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+		}
+
+		void KnnRegressor::model(const data::Storage& X, const data::Storage& y) noexcept
+		{
+			/*
+				Since this algorithm is a instance based learning, X and Y are required at time of prediction
+				Note :  The X and y should be in correct order or undefined behavior may occur. Run cmll::utils::checks::.. before
+
+				If Quantization is set or Algorithm is IVF_PQ, X is encoded. The full precision copy is then only kept if it is needed for re-ranking (Rerank > 0)
+
+				If Algorithm is not BRUTE the search structure is built from X. It holds its own copy of the observations (IVF_PQ only codes)
+				and is shared (not copied) between copies of the model. X is then not kept, since compact() and re-ranking read the observations back from it.
+
+				Inserted and erased observations are forgotten. A rebuild still running in the background is waited for
+			*/
+
+			_compaction = std::shared_future<Rebuilt>();
+			_compactionStaleRows.clear();
+			_indexRows.reset();
+			_delta.clear();
+			_erased.clear();
+			_erasedCount = 0;
+			_staleRows.clear();
+			_indexEnd = X.size();
+
+			_store.reset();
+			_storeX = nullptr;
+			_storeY = nullptr;
+			_storeRows = 0;
+			_storeCols = 0;
+			_storeClasses = 0;
+
+			_index = _createIndex(Algorithm);
+
+			if (_index) _index->build(X, Metric, P);
+			
+			this->y = y;
+
+			_quantizer.Type = Quantization;
+			_quantizer.fit(X);
+
+			if ((_index && _index->holdsObservations()) || (((Quantization != quantization::NONE && !_index) || Algorithm == searchAlgorithm::IVF_PQ) && Rerank == 0))
+			{
+				this->X.clear();
+				this->X.shrink_to_fit();
+			}
+
+			else
+			{
+				this->X = X;
+			}
+		}
+
+		void KnnRegressor::partialFit(const data::Storage& X, const data::Storage& y) //throws std::runtime_error
+		{
+			/*
+				The first batch builds the model, the following ones are inserted
+			*/
+			try
+			{
+				if (X.size() != y.size()) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::partialFit()>Error :  X and y have different number of observations");
+
+				if (_observations() == 0)
+				{
+					model(X, y);
+					return;
+				}
+
+				insert(X, y);
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+		}
+
+		void  KnnRegressor::predict(const data::Storage& XTest, data::Storage& result) //throws std::runtime_error
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Check if X and Y are defined . If not throw std::runtime_error
+				2) Hand the test set out to Threads threads in blocks of queries (see _queryBlock())
+				3) For every observation of a block find the K nearest observations in X (see _kNeighbors())
+				4) For each observation assign  mean of the labels of the K nearest observations, straight into its row of result
+
+				Every row is calculated by one thread from the same neighbors, so the result does not depend on the number of threads.
+
+				Note :  The XTest and result should be in correct order or undefined behavior may occur
+			*/
+
+			try
+			{
+				if (_observations() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor>Error :  Model is not built yet. Use model() to fit the model()");
+
+				utils::parallel::forEach(0, XTest.size(), [&](std::size_t first, std::size_t last)
+				{
+					std::vector<std::size_t> indexes;
+					std::vector<double> distances;
+
+					std::size_t k = _kNeighbors(XTest, first, last, indexes, distances);
+
+					for (std::size_t row = first; row < last; ++row)
+					{
+						double mean = 0;
+						for (std::size_t col = 0; col < k; ++col)
+						{
+							mean += _label(indexes[(row - first) * k + col]);
+						}
+						result[row][0] = mean / static_cast<double>(k);
+					}
+				}, Threads, _queryBlock(XTest.size()));
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+
+
+		}
+		void KnnRegressor::radiusNeighbors(const data::Storage& XTest, const double& radius, std::vector<std::size_t>& offsets, std::vector<std::size_t>& indexes, std::vector<double>& distances) const //throws std::runtime_error
+		{
+			try
+			{
+				if (_observations() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::radiusNeighbors()>Error :  Model is not built yet. Use model() to fit the model()");
+
+				if (radius < 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::radiusNeighbors()>Error :  radius can not be negative");
+
+				// The lists are found in parallel and then laid out one after the other
+				std::vector<std::vector<Neighbor>> neighbors(XTest.size());
+
+				utils::parallel::forEach(0, XTest.size(), [&](std::size_t first, std::size_t last)
+				{
+					for (std::size_t row = first; row < last; ++row)
+					{
+						_radiusNeighbors(XTest[row], radius, neighbors[row]);
+					}
+				}, Threads, _queryBlock(XTest.size()));
+
+				offsets.assign(1, 0);
+				offsets.reserve(XTest.size() + 1);
+				indexes.clear();
+				distances.clear();
+
+				for (const std::vector<Neighbor>& found : neighbors)
+				{
+					for (const Neighbor& neighbor : found)
+					{
+						indexes.push_back(neighbor.Index);
+						distances.push_back(neighbor.Distance);
+					}
+
+					offsets.push_back(indexes.size());
+				}
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+		}
+
+		double KnnRegressor::recall(const data::Storage& XTest) //throws std::runtime_error
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Find the K neighbors of every observation of XTest the way predict() does
+				2) Find the true K neighbors by comparing with every observation of X in full precision
+				3) recall = neighbors of 2) present in 1) / neighbors of 2)
+			*/
+
+			try
+			{
+				if (_observations() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::recall()>Error :  Model is not built yet. Use model() to fit the model()");
+
+				if (!_fullPrecision())
+				{
+					if (Algorithm == searchAlgorithm::IVF_PQ) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::recall()>Error :  The IVF_PQ index only keeps codes. Set Rerank to keep the full precision training set");
+
+					if (Quantization != quantization::NONE) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::recall()>Error :  Quantization only keeps codes. Set Rerank to keep the full precision training set");
+
+					throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::recall()>Error :  The model was saved without its full precision training set");
+				}
+
+				// Neighbors of 2) and how many of them 1) found, per observation of XTest
+				std::vector<std::size_t> found(XTest.size()), total(XTest.size());
+
+				utils::parallel::forEach(0, XTest.size(), [&](std::size_t first, std::size_t last)
+				{
+					std::vector<std::size_t> indexes;
+					std::vector<double> distances;
+
+					std::size_t k = _kNeighbors(XTest, first, last, indexes, distances);
+
+					NeighborHeap heap(k);
+					std::vector<Neighbor> exact;
+
+					for (std::size_t row = first; row < last; ++row)
+					{
+						for (std::size_t observation = 0; observation < _observations(); ++observation)
+						{
+							if (_erasedCount > 0 && _erased[observation]) continue;
+
+							heap.push(functions::distance::reduced(XTest[row].data(), _observation(observation), XTest[row].size(), Metric, P), observation);
+						}
+
+						heap.sorted(exact);
+
+						auto begin = indexes.begin() + static_cast<std::ptrdiff_t>((row - first) * k), end = begin + static_cast<std::ptrdiff_t>(k);
+
+						for (const Neighbor& neighbor : exact)
+						{
+							++total[row];
+
+							if (std::find(begin, end, neighbor.Index) != end) ++found[row];
+						}
+					}
+				}, Threads, _queryBlock(XTest.size()));
+
+				std::size_t foundSum = std::accumulate(found.begin(), found.end(), static_cast<std::size_t>(0));
+				std::size_t totalSum = std::accumulate(total.begin(), total.end(), static_cast<std::size_t>(0));
+
+				return (totalSum > 0) ? static_cast<double>(foundSum) / static_cast<double>(totalSum) : 1.0;
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+
+			return 0;
+		}
+
+		double KnnRegressor::rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept
+		{
+			/*
+				This function uses the following formula for calculating RSS
+				RSS = sum_of_((y_true - y_pred)^ 2)
+			*/
+
+			data::Storage difference(y_true.size(), std::vector<double>(1));
+
+
+			matrix::subtraction(y_true, y_pred, difference);
+
+			array::power(difference, 2);
+
+			return array::sum(difference);
+
+
+		}
+
+		void KnnRegressor::save(const std::string& filename) //throws std::runtime_error
+		{
+			/*
+				Layout (native byte order, every section starts at a multiple of 4096 bytes) :
+
+				magic "CMLLKNN1", then as uint64 : version, rows, features, classes, metric, algorithm, and the offset and bytes of
+				the training set (rows X features doubles, row major), the labels (rows doubles), the tombstones (rows bytes),
+				the index rows (uint64 each) and the index (see Index::save()), then P (double).
+				A section that is not needed has 0 bytes : the training set is left out when the index holds the observations.
+				Erased rows are written as zeros so that no row is renumbered
+			*/
+			const std::size_t page = 4096;
+
+			try
+			{
+				if (_observations() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::save()>Error :  Model is not built yet. Use model() to fit the model()");
+
+				compact(selection::YES);
+
+				if (_delta.size() > 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::save()>Error :  The inserted observations could not be added to the index");
+
+				bool full = _fullPrecision();
+
+				// The index writes the observations it holds itself
+				bool indexed = _index && _index->holdsObservations();
+
+				if (!full && !_index) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::save()>Error :  Neither the full precision training set nor an index is kept. Set Rerank when using Quantization");
+
+				std::ofstream out(filename, std::ios::binary | std::ios::trunc);
+
+				if (!out) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::save()>Error :  Could not open " + filename);
+
+				auto write = [&](const void* data, std::size_t bytes) { out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes)); };
+
+				auto align = [&]()
+				{
+					static const char zeros[4096] = { 0 };
+					std::size_t position = static_cast<std::size_t>(out.tellp());
+
+					if (position % page != 0) write(zeros, page - position % page);
+
+					return static_cast<std::uint64_t>(out.tellp());
+				};
+
+				std::size_t rows = _observations(), cols = _storeCols;
+
+				for (std::size_t row = 0; !_store && row < X.size() && cols == 0; ++row)
+				{
+					cols = X[row].size();
+				}
+
+				if (cols == 0 && _index) cols = _index->features();
+
+				std::uint64_t header[16] = { 1, rows, cols, _store ? _storeClasses : array::unique(y), static_cast<std::uint64_t>(Metric), static_cast<std::uint64_t>(Algorithm) };
+
+				write("CMLLKNN1", 8);
+				write(header, sizeof(header));
+				write(&P, sizeof(P));
+
+				if (full && !indexed)
+				{
+					std::vector<double> zeros(cols, 0);
+
+					header[6] = align();
+
+					for (std::size_t row = 0; row < rows; ++row)
+					{
+						bool erased = _erasedCount > 0 && _erased[row];
+
+						write(erased ? zeros.data() : _observation(row), cols * sizeof(double));
+					}
+
+					header[7] = rows * cols * sizeof(double);
+				}
+
+				std::vector<double> labels(rows);
+
+				for (std::size_t row = 0; row < rows; ++row)
+				{
+					labels[row] = _label(row);
+				}
+
+				header[8] = align();
+				write(labels.data(), rows * sizeof(double));
+				header[9] = rows * sizeof(double);
+
+				if (_erasedCount > 0)
+				{
+					header[10] = align();
+					write(_erased.data(), rows);
+					header[11] = rows;
+				}
+
+				if (_indexRows)
+				{
+					std::vector<std::uint64_t> indexRows(_indexRows->begin(), _indexRows->end());
+
+					header[12] = align();
+					write(indexRows.data(), indexRows.size() * sizeof(std::uint64_t));
+					header[13] = indexRows.size() * sizeof(std::uint64_t);
+				}
+
+				if (_index)
+				{
+					header[14] = align();
+					_index->save(out);
+					header[15] = static_cast<std::uint64_t>(out.tellp()) - header[14];
+				}
+
+				align();
+
+				out.seekp(8);
+				write(header, sizeof(header));
+
+				if (!out) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor::save()>Error :  Could not write " + filename);
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+		}
+
+		double KnnRegressor::score(const data::Storage& y_pred, const data::Storage& y_true) noexcept
+		{
+			/*
+				This function uses the following formula for calculating R^square
+				R^2 = 1 - RSS/TSS
+			 */
+			return (1 - (rss(y_pred, y_true) / (tss(y_true))));
+		}
+
+		double KnnRegressor::tss(const data::Storage& y) noexcept
+		{
+			/*
+				This function uses the following formula for calculating TSS
+				TSS = sum_of_((y_true - y_true.mean())^2)
+			*/
+
+			data::Storage difference(y.size(), std::vector<double>(1));
+			data::Storage yCopy = y;
+
+
+			double mean = array::average(y);
+			array::subtract(yCopy, mean);
+			array::power(yCopy, 2);
+
+			return array::sum(yCopy);
+		}
+
+		/*
+			Knn classifier class members
+		*/
+
+		KnnClassifier::KnnClassifier(const std::size_t& k, const distanceMetric& metric, const double& p) : KnnRegressor(k,metric,p)
+		{
+			/*
+				Default values are passed to base class's constructor
+			*/
+		}
+
+		void KnnClassifier::predict(const data::Storage& XTest, data::Storage& result) //throws std::runtime_error
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Check if X and Y are defined . If not throw std::runtime_error
+				2) Hand the test set out to Threads threads in blocks of queries (see _queryBlock())
+				3) For every observation of a block find the K nearest observations in X (see _kNeighbors())
+				4) For each observation assign  mode of the labels of the K nearest observations, straight into its row of result.
+				   The vote counters are allocated once per block and cleared between observations.
+				   A tie goes to the smallest label, whatever the number of threads
+
+				Note :  The XTest and result should be in correct order or undefined behavior may occur
+			*/
+
+			try
+			{
+				if (_observations() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor>Error :  Model is not built yet. Use model() to fit the model()");
+
+				data::Storage::size_type classes = _store ? _storeClasses : array::unique(y);
+
+				utils::parallel::forEach(0, XTest.size(), [&](std::size_t first, std::size_t last)
+				{
+					std::vector<std::size_t> occurrence(classes), indexes;
+					std::vector<double> distances;
+
+					std::size_t k = _kNeighbors(XTest, first, last, indexes, distances);
+
+					for (std::size_t row = first; row < last; ++row)
+					{
+						std::fill(occurrence.begin(), occurrence.end(), 0);
+						for (std::size_t col = 0; col < k; ++col)
+						{
+							occurrence[static_cast<std::size_t>(_label(indexes[(row - first) * k + col]))] += 1;
+						}
+						result[row][0] = static_cast<double>(std::distance(occurrence.begin(), std::max_element(occurrence.begin(), occurrence.end())));
+					}
+				}, Threads, _queryBlock(XTest.size()));
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+			}
+
+			
+		}
+
+		double KnnClassifier::score(const data::Storage& y_pred, const data::Storage& y) noexcept
+		{
+
+			/*
+				Function uses standard indicator function for calculating accuracy.
+
+				Note :  Y_pred and y are supposed to be in correct order of NX1.
+			*/
+
+			double count = 0;
+			data::Storage::size_type observation = y.size();
+
+			for (data::Storage::size_type value = 0; value < observation; ++value)
+			{
+				if (y[value][0] == y_pred[value][0]) ++count;
+			}
+
+			return static_cast<double>(count / observation);
+		}
+
+		/*
+			K Means class members
+		*/
+
+		KMeans::KMeans(const std::size_t& k, const distanceMetric& metric, const double& p, const initialization& init, const unsigned int& seed) : KnnClassifier(k, metric, p)
+		{
+			/*
+				Constructor to assign defaults
+				
+			*/
+			Initialization = init;
+			Seed = seed;
+			Restarts = static_cast<std::size_t>(defaults::RESTARTS);
+			ClusteringAlgorithm = kMeansAlgorithm::LLOYD;
+			ReassignmentRatio = defaultsd::REASSIGNMENT_RATIO;
+			MaximumIterations = static_cast<std::size_t>(defaults::MAXIMUM_ITERATIONS);
+			Tolerance = defaultsd::TOLERANCE;
+			Iterations = 0;
+			Inertia = 0;
+			_sinceReassignment = 0;
+			_generator.seed(seed);
+		}
+
+		double KMeans::_assign(const data::Storage& X, const std::vector<double>& norms, const std::vector<double>& centroids, std::vector<std::uint32_t>& labels, const std::size_t& threads) const
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Cut X into blocks (see _blocks()). With norms, copy the centroids in the order of their norms (see _sortCentroids())
+				2) On every thread take the next block and, for every observation of it, find the closest centroid by the
+				   reduced distance (ties go to the smaller centroid) and add the distance to the inertia of the block.
+				   With norms the search starts from the previous centroid of the observation (see _closest())
+				3) Add the inertias of the blocks in block order
+			*/
+			std::size_t rows = X.size(), cols = X[0].size();
+			std::size_t blocks = _blocks(rows, 0), blockRows = (rows + blocks - 1) / blocks;
+
+			std::vector<double> blockInertia(blocks), sortedCentroids, sortedNorms;
+			std::vector<std::size_t> order, positions;
+
+			if (!norms.empty())
+			{
+				_sortCentroids(centroids, sortedCentroids, sortedNorms, order);
+
+				positions.resize(K);
+
+				for (std::size_t position = 0; position < K; ++position)
+				{
+					positions[order[position]] = position;
+				}
+			}
+
+			labels.resize(rows);
+
+			utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t block = first; block < last; ++block)
+				{
+					double inertia = 0;
+
+					for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
+					{
+						const double* x = X[row].data();
+						double closestDistance = std::numeric_limits<double>::infinity();
+						std::size_t closest = 0;
+
+						if (norms.empty())
+						{
+							for (std::size_t centroid = 0; centroid < K; ++centroid)
+							{
+								double distance = functions::distance::reduced(x, centroids.data() + centroid * cols, cols, Metric, P);
+
+								if (distance < closestDistance)
+								{
+									closestDistance = distance;
+									closest = centroid;
+								}
+							}
+						}
+
+						else closest = _closest(x, norms[row], positions[std::min(static_cast<std::size_t>(labels[row]), K - 1)], sortedCentroids, sortedNorms, order, closestDistance);
+
+						labels[row] = static_cast<std::uint32_t>(closest);
+						inertia += closestDistance;
+					}
+
+					blockInertia[block] = inertia;
+				}
+			}, threads);
+
+			return std::accumulate(blockInertia.begin(), blockInertia.end(), 0.0);
+		}
+
+		std::size_t KMeans::_blocks(const std::size_t& rows, const std::size_t& values) const noexcept
+		{
+			const std::size_t minimumRows = 1024, maximumBlocks = 256, maximumValues = static_cast<std::size_t>(1) << 24;
+
+			std::size_t blocks = std::min((rows + minimumRows - 1) / minimumRows, maximumBlocks);
+
+			if (values > 0) blocks = std::min(blocks, maximumValues / values);
+
+			return std::max(blocks, static_cast<std::size_t>(1));
+		}
+
+		std::size_t KMeans::_boundedLloyd(const data::Storage& X, const double& threshold, std::vector<double>& centroids, std::vector<std::uint32_t>& labels, const std::size_t& threads) const
+		{
+			/*
+				The steps followed by the function are as follows
+
+				1) Find the distances between the centroids and half the distance of every centroid from its closest other centroid
+				2) For every observation (in parallel over blocks of X) :
+				   On the first iteration compare it with every centroid and set its bounds.
+				   HAMERLY : if the upper bound is at most max(lower bound, half the distance of its centroid from the closest other one)
+							 the centroid can not change. Otherwise make the upper bound exact and check again, then compare with every centroid
+				   ELKAN :   skip the observation if the upper bound is at most half the distance of its centroid from the closest other one.
+							 Otherwise skip every centroid whose lower bound, or half of whose distance from the current centroid, is at least the
+							 upper bound. The upper bound is made exact at most once and every distance calculated becomes a lower bound
+				3) Stop if the last update moved the centroids by at most threshold or after MaximumIterations updates
+				4) Move the centroids (see _centroidSums() and _centroidUpdate()) and find how far every centroid moved
+				5) Loosen the bounds : upper bound += movement of the centroid, lower bounds -= movement of their centroid
+				   (HAMERLY : the largest movement of any other centroid) and go back to 1)
+
+				The bounds rely on the triangle inequality, so they hold the actual distances, not the reduced ones
+			*/
+			bool elkan = ClusteringAlgorithm == kMeansAlgorithm::ELKAN;
+			std::size_t rows = X.size(), cols = X[0].size();
+			std::size_t blocks = _blocks(rows, 0), blockRows = (rows + blocks - 1) / blocks;
+
+			// Upper bound of the distance from the centroid and lower bounds of the distances from the other centroids (ELKAN : every centroid)
+			std::vector<double> upper(rows), lower(elkan ? rows * K : rows);
+			std::vector<double> between(elkan ? K * K : 0), half(K), movements(K), previous, sums(K * cols);
+			std::vector<std::size_t> counts(K);
+			std::size_t iterations = 0;
+			bool converged = false;
+
+			labels.assign(rows, 0);
+
+			auto distance = [&](const double* x, const double* y)
+			{
+				return functions::distance::fromReduced(functions::distance::reduced(x, y, cols, Metric, P), Metric, P);
+			};
+
+			for (; ; ++iterations)
+			{
+				utils::parallel::forEach(0, K, [&](std::size_t first, std::size_t last)
+				{
+					for (std::size_t centroid = first; centroid < last; ++centroid)
+					{
+						half[centroid] = std::numeric_limits<double>::infinity();
+
+						for (std::size_t other = 0; other < K; ++other)
+						{
+							if (other == centroid) continue;
+
+							double value = distance(centroids.data() + centroid * cols, centroids.data() + other * cols);
+
+							if (elkan) between[centroid * K + other] = value;
+
+							half[centroid] = std::min(half[centroid], value / 2);
+						}
+					}
+				}, threads);
+
+				utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+				{
+					for (std::size_t row = first * blockRows; row < std::min(rows, last * blockRows); ++row)
+					{
+						const double* x = X[row].data();
+						std::size_t label = labels[row];
+
+						if (iterations > 0 && elkan)
+						{
+							if (upper[row] <= half[label]) continue;
+
+							bool exact = false;
+
+							for (std::size_t centroid = 0; centroid < K; ++centroid)
+							{
+								if (centroid == label) continue;
+
+								double bound = std::max(lower[row * K + centroid], between[label * K + centroid] / 2);
+
+								if (upper[row] <= bound) continue;
+
+								if (!exact)
+								{
+									upper[row] = distance(x, centroids.data() + label * cols);
+									lower[row * K + label] = upper[row];
+									exact = true;
+
+									if (upper[row] <= bound) continue;
+								}
+
+								double value = distance(x, centroids.data() + centroid * cols);
+								lower[row * K + centroid] = value;
+
+								if (value < upper[row])
+								{
+									upper[row] = value;
+									label = centroid;
+								}
+							}
+
+							labels[row] = static_cast<std::uint32_t>(label);
+							continue;
+						}
+
+						if (iterations > 0)
+						{
+							double bound = std::max(half[label], lower[row]);
+
+							if (upper[row] <= bound) continue;
+
+							upper[row] = distance(x, centroids.data() + label * cols);
+
+							if (upper[row] <= bound) continue;
+						}
+
+						// Every centroid is compared, keeping the closest and the second closest
+						double closest = std::numeric_limits<double>::infinity(), second = closest;
+
+						for (std::size_t centroid = 0; centroid < K; ++centroid)
+						{
+							double value = distance(x, centroids.data() + centroid * cols);
+
+							if (elkan) lower[row * K + centroid] = value;
+
+							if (value < closest)
+							{
+								second = closest;
+								closest = value;
+								label = centroid;
+							}
+
+							else if (value < second) second = value;
+						}
+
+						labels[row] = static_cast<std::uint32_t>(label);
+						upper[row] = closest;
+
+						if (!elkan) lower[row] = second;
+					}
+				}, threads);
+
+				if (converged || iterations >= MaximumIterations) break;
+
+				previous = centroids;
+
+				_centroidSums(X, labels, sums, counts, threads);
+				converged = _centroidUpdate(sums, counts, centroids) <= threshold;
+
+				std::size_t farthest = 0;
+
+				for (std::size_t centroid = 0; centroid < K; ++centroid)
+				{
+					movements[centroid] = distance(previous.data() + centroid * cols, centroids.data() + centroid * cols);
+
+					if (movements[centroid] > movements[farthest]) farthest = centroid;
+				}
+
+				double secondFarthest = 0;
+
+				for (std::size_t centroid = 0; centroid < K; ++centroid)
+				{
+					if (centroid != farthest) secondFarthest = std::max(secondFarthest, movements[centroid]);
+				}
+
+				utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+				{
+					for (std::size_t row = first * blockRows; row < std::min(rows, last * blockRows); ++row)
+					{
+						upper[row] += movements[labels[row]];
+
+						if (elkan)
+						{
+							for (std::size_t centroid = 0; centroid < K; ++centroid)
+							{
+								lower[row * K + centroid] = std::max(lower[row * K + centroid] - movements[centroid], 0.0);
+							}
+						}
+
+						else lower[row] = std::max(lower[row] - ((labels[row] == farthest) ? secondFarthest : movements[farthest]), 0.0);
+					}
+				}, threads);
+			}
+
+			return iterations;
+		}
+
+		void KMeans::_centroidSums(const data::Storage& X, const std::vector<std::uint32_t>& labels, std::vector<double>& sums, std::vector<std::size_t>& counts, const std::size_t& threads) const
+		{
+			/*
+				Every block of X (see _blocks()) adds its observations to its own sums and counts on one thread.
+				Then every thread adds up its own centroids, each of them in block order.
+				The blocks do not depend on the number of threads and neither does the order of the additions
 			*/
-			
-			for (data::Storage::size_type observation = 0; observation < XTest.size(); ++observation)
+			std::size_t rows = X.size(), cols = X[0].size();
+			std::size_t blocks = _blocks(rows, K * cols), blockRows = (rows + blocks - 1) / blocks;
+
+			std::vector<double> blockSums(blocks * K * cols);
+			std::vector<std::size_t> blockCounts(blocks * K);
+
+			utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t block = first; block < last; ++block)
+				{
+					double* sum = blockSums.data() + block * K * cols;
+					std::size_t* count = blockCounts.data() + block * K;
+
+					for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
+					{
+						for (std::size_t col = 0; col < cols; ++col)
+						{
+							sum[labels[row] * cols + col] += X[row][col];
+						}
+						++count[labels[row]];
+					}
+				}
+			}, threads);
+
+			sums.assign(K * cols, 0.0);
+			counts.assign(K, 0);
+
+			utils::parallel::forEach(0, K, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t block = 0; block < blocks; ++block)
+				{
+					for (std::size_t centroid = first; centroid < last; ++centroid)
+					{
+						for (std::size_t col = 0; col < cols; ++col)
+						{
+							sums[centroid * cols + col] += blockSums[(block * K + centroid) * cols + col];
+						}
+						counts[centroid] += blockCounts[block * K + centroid];
+					}
+				}
+			}, threads, std::max(K / (4 * utils::parallel::threads(threads)), static_cast<std::size_t>(1)));
+		}
+
+		double KMeans::_centroidUpdate(const std::vector<double>& sums, const std::vector<std::size_t>& counts, std::vector<double>& centroids) const noexcept
+		{
+			/*
+				New centroid = sum of its observations / number of its observations
+			*/
+			std::size_t cols = (K > 0) ? centroids.size() / K : 0;
+			double shift = 0;
+
+			for (std::size_t centroid = 0; centroid < K; ++centroid)
+			{
+				if (counts[centroid] == 0) continue;
+
+				for (std::size_t col = 0; col < cols; ++col)
+				{
+					double value = sums[centroid * cols + col] / static_cast<double>(counts[centroid]);
+					double difference = value - centroids[centroid * cols + col];
+
+					shift += difference * difference;
+					centroids[centroid * cols + col] = value;
+				}
+			}
+
+			return shift;
+		}
+
+		data::Storage KMeans::_chooseCentroids(const data::Storage& X, const unsigned int& seed, const std::size_t& threads) const
+		{
+			/*
+				Every choice draws from a generator seeded with seed only, so a restart is reproduced by its seed alone
+			*/
+			std::mt19937 generator(seed);
+
+			if (Initialization == initialization::K_MEANS_PLUS_PLUS) return _kMeansPlusPlus(X, std::vector<double>(), generator, threads);
+
+			if (Initialization == initialization::K_MEANS_PARALLEL) return _kMeansParallel(X, seed, generator, threads);
+
+			return data::Storage(X.begin(), X.begin() + static_cast<std::ptrdiff_t>(std::min(K, X.size())));
+		}
+
+		std::size_t KMeans::_closest(const double* x, const double& norm, const std::size_t& start, const std::vector<double>& sortedCentroids, const std::vector<double>& sortedNorms, const std::vector<std::size_t>& order, double& distance) const noexcept
+		{
+			/*
+				|norm(x) - norm(c)| is never above the distance of x from c, so once a centroid at distance d is found only the centroids
+				whose norm lies in [norm(x) - d, norm(x) + d] can be closer. They are contiguous in sortedNorms and the window
+				shrinks as closer centroids are found. A relative margin of 1e-9 covers rounding, so no centroid that could be the
+				closest one is skipped and the result is the one comparing every centroid would give
+			*/
+			std::size_t cols = sortedCentroids.size() / K;
+			std::size_t closest = order[start];
+
+			distance = functions::distance::reduced(x, sortedCentroids.data() + start * cols, cols, Metric, P);
+
+			double reach = functions::distance::fromReduced(distance, Metric, P) * (1 + 1e-9);
+
+			for (std::size_t position = static_cast<std::size_t>(std::lower_bound(sortedNorms.begin(), sortedNorms.end(), norm - reach) - sortedNorms.begin()); position < K && sortedNorms[position] <= norm + reach; ++position)
+			{
+				if (position == start) continue;
+
+				std::size_t centroid = order[position];
+				double value = functions::distance::reduced(x, sortedCentroids.data() + position * cols, cols, Metric, P);
+
+				if (value < distance || (value == distance && centroid < closest))
+				{
+					distance = value;
+					closest = centroid;
+					reach = functions::distance::fromReduced(distance, Metric, P) * (1 + 1e-9);
+				}
+			}
+
+			return closest;
+		}
+
+		void KMeans::_cluster(const data::Storage& X, const std::size_t& restarts)
+		{
+			/*	
+				The steps followed by the function are as follows
+
+				1) Find the mean variance of the features of X and the norms of the observations (see _norms()), shared by every restart
+				2) Run the restarts on min(restarts, threads) threads, every one of them with its share of the threads.
+				   The first restart starts from Centroids, restart r from centroids chosen with a seed drawn from Seed and r (see _chooseCentroids()).
+				   Every restart runs Lloyd's algorithm (see _lloyd()). A LLOYD restart gives up at an iteration once a restart with a lower
+				   index finished in at most as many iterations with a lower inertia. It waits for every lower restart to get past that iteration
+				   (or to finish) before deciding, so which restarts give up does not depend on timing. The blocks of restarts are handed out
+				   in order, so a lower restart is always running or finished and the wait always ends
+				3) Keep the restart with the lowest inertia (the first of equal ones), copy its centroids back, list the observations
+				   of every centroid in CentroidsAssigned and index the centroids for predict() (see _indexCentroids())
+			*/
+			if (X.empty()) return;
+
+			std::size_t rows = X.size(), cols = X[0].size();
+			std::vector<double> centroids(K * cols);
+			std::vector<std::uint32_t> labels;
+
+			for (std::size_t centroid = 0; centroid < K; ++centroid)
+			{
+				std::copy(Centroids[centroid].begin(), Centroids[centroid].end(), centroids.begin() + static_cast<std::ptrdiff_t>(centroid * cols));
+			}
+
+			// Mean variance of the features, every feature summed in observation order
+			std::vector<double> variances(cols);
+
+			utils::parallel::forEach(0, cols, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t col = first; col < last; ++col)
+				{
+					double sum = 0, squares = 0;
+
+					for (std::size_t row = 0; row < rows; ++row)
+					{
+						sum += X[row][col];
+						squares += X[row][col] * X[row][col];
+					}
+
+					double mean = sum / static_cast<double>(rows);
+					variances[col] = std::max(squares / static_cast<double>(rows) - mean * mean, 0.0);
+				}
+			}, Threads);
+
+			double threshold = Tolerance * std::accumulate(variances.begin(), variances.end(), 0.0) / static_cast<double>(std::max(cols, static_cast<std::size_t>(1)));
+			std::vector<double> norms = _norms(X, Threads);
+			const std::vector<double> initial = centroids;
+
+			// The first K observations always give the same restart
+			std::size_t runs = (Initialization == initialization::FIRST) ? 1 : std::max(restarts, static_cast<std::size_t>(1));
+			std::size_t concurrent = std::min(runs, utils::parallel::threads(Threads));
+			std::size_t runThreads = std::max(utils::parallel::threads(Threads) / concurrent, static_cast<std::size_t>(1));
+
+			std::mutex mutex;
+			std::condition_variable progressed;
+			double bestInertia = std::numeric_limits<double>::infinity();
+			std::size_t bestIterations = 0, bestRun = runs;
+
+			// Per restart : the last iteration it got past without finishing and, once done, its iterations and inertia (infinity if it gave up)
+			std::vector<std::size_t> reached(runs, 0), finalIterations(runs, 0);
+			std::vector<double> finalInertia(runs, std::numeric_limits<double>::infinity());
+			std::vector<std::uint8_t> done(runs, 0);
+
+			utils::parallel::forEach(0, runs, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t run = first; run < last; ++run)
+				{
+					std::vector<double> runCentroids = initial;
+					std::vector<std::uint32_t> runLabels;
+					std::size_t iterations = 0;
+
+					if (run > 0)
+					{
+						std::seed_seq sequence{ Seed, static_cast<unsigned int>(run) };
+						std::mt19937 seeds(sequence);
+
+						data::Storage chosen = _chooseCentroids(X, static_cast<unsigned int>(seeds()), runThreads);
+
+						for (std::size_t centroid = 0; centroid < chosen.size(); ++centroid)
+						{
+							std::copy(chosen[centroid].begin(), chosen[centroid].end(), runCentroids.begin() + static_cast<std::ptrdiff_t>(centroid * cols));
+						}
+					}
+
+					auto giveUp = [&, run](std::size_t iteration, double inertia)
+					{
+						std::unique_lock<std::mutex> lock(mutex);
+
+						reached[run] = iteration;
+						progressed.notify_all();
+
+						for (std::size_t lower = 0; lower < run; ++lower)
+						{
+							progressed.wait(lock, [&]() { return done[lower] || reached[lower] >= iteration; });
+
+							if (done[lower] && finalIterations[lower] <= iteration && inertia > finalInertia[lower]) return true;
+						}
+
+						return false;
+					};
+
+					double inertia = _lloyd(X, norms, threshold, runCentroids, runLabels, iterations, runThreads, (runs > 1) ? std::function<bool(std::size_t, double)>(giveUp) : std::function<bool(std::size_t, double)>());
+
+					std::lock_guard<std::mutex> lock(mutex);
+
+					done[run] = 1;
+					finalIterations[run] = iterations;
+					finalInertia[run] = inertia;
+					progressed.notify_all();
+
+					if (inertia < bestInertia || (inertia == bestInertia && run < bestRun))
+					{
+						bestInertia = inertia;
+						bestIterations = iterations;
+						bestRun = run;
+						centroids.swap(runCentroids);
+						labels.swap(runLabels);
+					}
+				}
+			}, concurrent);
+
+			Inertia = bestInertia;
+			Iterations = bestIterations;
+
+			CentroidsAssigned.assign(K, std::vector<double>());
+
+			for (std::size_t centroid = 0; centroid < K; ++centroid)
+			{
+				std::copy(centroids.begin() + static_cast<std::ptrdiff_t>(centroid * cols), centroids.begin() + static_cast<std::ptrdiff_t>((centroid + 1) * cols), Centroids[centroid].begin());
+			}
+
+			for (std::size_t row = 0; row < rows; ++row)
+			{
+				CentroidsAssigned[labels[row]].emplace_back(static_cast<double>(row));
+			}
+
+			_indexCentroids();
+		}
+		
+		void KMeans::_indexCentroids()
+		{
+			/*
+				BRUTE : the centroids sorted by norm (see _sortCentroids()), so that predict() only compares an observation with the
+				centroids whose norm is close to its own. Other algorithms : the search structure of Algorithm built over the centroids
+			*/
+			std::vector<double> centroids;
+
+			for (const std::vector<double>& centroid : Centroids)
 			{
-				_distancesFromX(XTest[observation], distances[observation]);
+				centroids.insert(centroids.end(), centroid.begin(), centroid.end());
 			}
+
+			_sortedCentroids.clear();
+			_sortedNorms.clear();
+			_order.clear();
+
+			_centroidIndex = _createIndex(Algorithm);
+
+			if (_centroidIndex) _centroidIndex->build(Centroids, Metric, P);
+
+			else if (!(Metric == distanceMetric::MINKOWSKI && P < 1)) _sortCentroids(centroids, _sortedCentroids, _sortedNorms, _order);
 		}
 
-		void KnnRegressor::_distancesFromX(const std::vector<double>& x, std::vector<double>& result) noexcept
+		void KMeans::_initializeCentroids(const data::Storage& centroidValue)
+		{
+			/*
+				Initializes default Centroids that is the first K observations in X
+
+				Note :  Be really careful if manual Centroids are to be assigned.
+
+				Assign the Centroids in the Centroids vector and also update Centroid assigned accordingly.
+				
+			*/
+					
+			for (data::Storage::size_type row = 0; row < K; ++row)
+			{
+				for (std::vector<double>::size_type col = 0; col < centroidValue[row].size(); ++col)
+				{
+					Centroids[row][col] = centroidValue[row][col];
+				}
+
+				CentroidsAssigned[row].emplace_back(static_cast<double>(row));
+			}
+		}
+		
+		data::Storage KMeans::_kMeansParallel(const data::Storage& X, const unsigned int& seed, std::mt19937& generator, const std::size_t& threads) const
 		{
 			/*
-				For the observation x, distance from each observation in Feature Matrix X is calculated using a distance metric function
+				The steps followed by the function are as follows
+
+				1) Pick a first candidate at random and find the distance of every observation from it
+				2) For 5 rounds pick every observation with probability min(1, 2K x distance / total) and
+				   update the distances (and closest candidate) of every observation with the new candidates only
+				3) Weight every candidate by the observations closest to it
+				4) Choose K of the candidates with the weighted k-means++ and move them with weighted Lloyd's iterations
+				   until no candidate changes centroid (at most MaximumIterations times)
+
+				If fewer than K candidates are picked, the plain k-means++ is used instead
 			*/
-			for (data::Storage::size_type row = 0; row < X.size(); ++row)
+			const std::size_t rounds = 5;
+			const double oversampling = 2.0 * static_cast<double>(K);
+
+			std::size_t rows = X.size(), cols = X[0].size();
+			std::size_t blocks = _blocks(rows, 0), blockRows = (rows + blocks - 1) / blocks;
+
+			std::vector<double> closest(rows, std::numeric_limits<double>::infinity()), blockTotals(blocks);
+			std::vector<std::uint32_t> nearest(rows, 0);
+			std::vector<std::size_t> picked(1, std::uniform_int_distribution<std::size_t>(0, rows - 1)(generator));
+			std::vector<std::vector<std::size_t>> blockPicked(blocks);
+
+			// Closest distance and candidate of every observation over the candidates first .. picked.size()
+			auto update = [&](std::size_t first)
+			{
+				utils::parallel::forEach(0, blocks, [&](std::size_t blockBegin, std::size_t blockEnd)
+				{
+					for (std::size_t block = blockBegin; block < blockEnd; ++block)
+					{
+						double total = 0;
+
+						for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
+						{
+							for (std::size_t candidate = first; candidate < picked.size(); ++candidate)
+							{
+								double distance = functions::distance::reduced(X[row].data(), X[picked[candidate]].data(), cols, Metric, P);
+
+								if (distance < closest[row])
+								{
+									closest[row] = distance;
+									nearest[row] = static_cast<std::uint32_t>(candidate);
+								}
+							}
+							total += closest[row];
+						}
+
+						blockTotals[block] = total;
+					}
+				}, threads);
+
+				return std::accumulate(blockTotals.begin(), blockTotals.end(), 0.0);
+			};
+
+			double total = update(0);
+
+			for (std::size_t round = 0; round < rounds && total > 0; ++round)
+			{
+				utils::parallel::forEach(0, blocks, [&](std::size_t blockBegin, std::size_t blockEnd)
+				{
+					for (std::size_t block = blockBegin; block < blockEnd; ++block)
+					{
+						std::seed_seq sequence{ seed, static_cast<unsigned int>(round), static_cast<unsigned int>(block) };
+						std::mt19937 blockGenerator(sequence);
+						std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+						blockPicked[block].clear();
+
+						for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
+						{
+							if (uniform(blockGenerator) < oversampling * closest[row] / total) blockPicked[block].push_back(row);
+						}
+					}
+				}, threads);
+
+				std::size_t first = picked.size();
+
+				for (const std::vector<std::size_t>& rowsPicked : blockPicked)
+				{
+					picked.insert(picked.end(), rowsPicked.begin(), rowsPicked.end());
+				}
+
+				if (picked.size() == first) break;
+
+				total = update(first);
+			}
+
+			if (picked.size() < K) return _kMeansPlusPlus(X, std::vector<double>(), generator, threads);
+
+			data::Storage candidates(picked.size());
+			std::vector<double> weights(picked.size());
+
+			for (std::size_t candidate = 0; candidate < picked.size(); ++candidate)
+			{
+				candidates[candidate] = X[picked[candidate]];
+			}
+
+			for (std::size_t row = 0; row < rows; ++row)
 			{
-				result[row] = DistanceCal(X[row], x, 0);
+				weights[nearest[row]] += 1;
+			}
+
+			data::Storage centroids = _kMeansPlusPlus(candidates, weights, generator, threads);
+			std::vector<std::size_t> labels(candidates.size(), K);
+
+			for (std::size_t iteration = 0; iteration < MaximumIterations; ++iteration)
+			{
+				bool changed = false;
+				data::Storage sums(K, std::vector<double>(cols));
+				std::vector<double> counts(K);
+
+				for (std::size_t candidate = 0; candidate < candidates.size(); ++candidate)
+				{
+					double closestDistance = std::numeric_limits<double>::infinity();
+					std::size_t label = 0;
+
+					for (std::size_t centroid = 0; centroid < K; ++centroid)
+					{
+						double distance = functions::distance::reduced(candidates[candidate].data(), centroids[centroid].data(), cols, Metric, P);
+
+						if (distance < closestDistance)
+						{
+							closestDistance = distance;
+							label = centroid;
+						}
+					}
+
+					changed = changed || label != labels[candidate];
+					labels[candidate] = label;
+					counts[label] += weights[candidate];
+
+					for (std::size_t col = 0; col < cols; ++col)
+					{
+						sums[label][col] += weights[candidate] * candidates[candidate][col];
+					}
+				}
+
+				if (!changed) break;
+
+				for (std::size_t centroid = 0; centroid < K; ++centroid)
+				{
+					if (counts[centroid] == 0) continue;
+
+					for (std::size_t col = 0; col < cols; ++col)
+					{
+						centroids[centroid][col] = sums[centroid][col] / counts[centroid];
+					}
+				}
 			}
+
+			return centroids;
 		}
 
-		void KnnRegressor::_neighborKSort(const data::Storage& distances, data::Storage& sortedKDistances) noexcept
+		data::Storage KMeans::_kMeansPlusPlus(const data::Storage& X, const std::vector<double>& weights, std::mt19937& generator, const std::size_t& threads) const
 		{
 			/*
-				The distances now calculated are sorted. Then first K distances are kept 
+				The steps followed by the function are as follows
+
+				1) Pick the first centroid with probability proportional to the weights (uniformly without weights)
+				2) Update the closest distance of every observation with the last centroid picked, in parallel over blocks,
+				   and sum weight x distance per block
+				3) Draw a number in [0, total), find the block it falls in from the totals of the blocks and then the observation
+				   inside the block. Pick it and go back to 2) until K centroids are picked
+
+				Observations already picked have a distance of 0, so they are not picked again while others are left
 			*/
-			
-			std::vector<double> indexes(distances[0].size());
-			for (data::Storage::size_type row = 0; row < distances.size(); ++row)
+			std::size_t rows = X.size(), cols = X[0].size();
+			std::size_t blocks = _blocks(rows, 0), blockRows = (rows + blocks - 1) / blocks;
+
+			std::vector<double> closest(rows, std::numeric_limits<double>::infinity()), blockTotals(blocks);
+			data::Storage centroids;
+			std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+			auto weight = [&](std::size_t row) { return weights.empty() ? 1.0 : weights[row]; };
+
+			// The observation where a draw in [0, total) of the cumulative weight x distance falls
+			auto find = [&](double target)
+			{
+				std::size_t block = 0;
+
+				while (block + 1 < blocks && target >= blockTotals[block])
+				{
+					target -= blockTotals[block++];
+				}
+
+				std::size_t row = block * blockRows, last = std::min(rows, (block + 1) * blockRows);
+
+				for (; row + 1 < last; ++row)
+				{
+					double mass = weight(row) * closest[row];
+
+					if (target < mass) break;
+
+					target -= mass;
+				}
+
+				return row;
+			};
+
+			std::size_t chosen = 0;
+
+			if (weights.empty()) chosen = std::uniform_int_distribution<std::size_t>(0, rows - 1)(generator);
+
+			else
 			{
-				for (std::vector<double>::size_type innerRow = 0; innerRow < indexes.size(); ++innerRow)
+				std::fill(closest.begin(), closest.end(), 1.0);
+
+				for (std::size_t block = 0; block < blocks; ++block)
 				{
-					indexes[innerRow] = static_cast<double>(innerRow);
+					blockTotals[block] = std::accumulate(weights.begin() + static_cast<std::ptrdiff_t>(block * blockRows), weights.begin() + static_cast<std::ptrdiff_t>(std::min(rows, (block + 1) * blockRows)), 0.0);
 				}
 
+				chosen = find(uniform(generator) * std::accumulate(blockTotals.begin(), blockTotals.end(), 0.0));
+
+				std::fill(closest.begin(), closest.end(), std::numeric_limits<double>::infinity());
+			}
 
-				std::stable_sort(indexes.begin(), indexes.end(), [&](double index1, double index2) {return distances[row][static_cast<std::vector<double>::size_type>(index1)] < distances[row][static_cast<std::vector<double>::size_type>(index2)]; });
-				
-				indexes.resize(K);
+			while (true)
+			{
+				centroids.push_back(X[chosen]);
 
-				sortedKDistances[row] = indexes;
+				if (centroids.size() >= std::min(K, rows)) break;
 
-				indexes.resize(distances[0].size());
-			}
-		}
+				const double* centroid = centroids.back().data();
 
+				utils::parallel::forEach(0, blocks, [&](std::size_t blockBegin, std::size_t blockEnd)
+				{
+					for (std::size_t block = blockBegin; block < blockEnd; ++block)
+					{
+						double total = 0;
 
+						for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
+						{
+							closest[row] = std::min(closest[row], functions::distance::reduced(X[row].data(), centroid, cols, Metric, P));
+							total += weight(row) * closest[row];
+						}
 
-		KnnRegressor::KnnRegressor(const std::size_t& k, const distanceMetric& metric, const double& p)
-		{
-			/*
-				Constructor to load defaults values for K - the number of neighbors to consider, the distance metric and value of order p for minkowski distance metric
-			*/
-			K = k;
-			Metric = metric;
-			P = p;
+						blockTotals[block] = total;
+					}
+				}, threads);
 
-			if (Metric == distanceMetric::EUCLEDIAN)
-			{
-				DistanceCal = functions::distance::euclidean;
-			}
+				double total = std::accumulate(blockTotals.begin(), blockTotals.end(), 0.0);
 
-			else if (Metric == distanceMetric::MANHATTAN)
-			{
-				DistanceCal = functions::distance::manhattan;
-			}
+				// Every observation lies on a centroid
+				if (total <= 0) chosen = std::uniform_int_distribution<std::size_t>(0, rows - 1)(generator);
 
-			else if (Metric == distanceMetric::MINKOWSKI)
-			{
-				DistanceCal = functions::distance::minkowski;
+				else chosen = find(uniform(generator) * total);
 			}
 
+			return centroids;
 		}
 
-		void KnnRegressor::model(const data::Storage& X, const data::Storage& y) noexcept
+		double KMeans::_lloyd(const data::Storage& X, const std::vector<double>& norms, const double& threshold, std::vector<double>& centroids, std::vector<std::uint32_t>& labels, std::size_t& iterations, const std::size_t& threads, const std::function<bool(std::size_t, double)>& giveUp) const
 		{
 			/*
-				Since this algorithm is a instance based learning, X and Y are required at time of prediction
-				Note :  The X and y should be in correct order or undefined behavior may occur. Run cmll::utils::checks::.. before
+				LLOYD
+				1) Assign every observation to its closest centroid (see _assign())
+				2) Stop if the last update moved the centroids by at most threshold, or after MaximumIterations updates
+				3) Give up if giveUp says so
+				4) Move every centroid to the mean of its observations (see _centroidSums() and _centroidUpdate()) and go back to 1)
+
+				ELKAN and HAMERLY run 1), 2) and 4) in _boundedLloyd() instead, never give up and the inertia is calculated at the end.
+				The last assignment is done with the final centroids, so the inertia and the labels match them.
+				MINKOWSKI with P below 1 is not a metric (the triangle inequality does not hold), so their bounds are not valid
+				and LLOYD is run for it whatever ClusteringAlgorithm is
 			*/
-			
-			this->X = X;
-			this->y = y;
-		}
+			std::size_t rows = X.size(), cols = X[0].size();
 
-		void  KnnRegressor::predict(const data::Storage& XTest, data::Storage& result) //throws std::runtime_error
-		{
-			/*
-				The steps followed by the function are as follows
+			if (ClusteringAlgorithm == kMeansAlgorithm::LLOYD || (Metric == distanceMetric::MINKOWSKI && P < 1))
+			{
+				std::vector<double> sums;
+				std::vector<std::size_t> counts;
+				bool converged = false;
+				double inertia = 0;
 
-				1) Check if X and Y are defined . If not throw std::runtime_error
-				2) For every observation in the test set , find distances from each observation in X
-				3) For every observation sort the distances and keep the first K distances
-				4) For each observation assign  mean of the labels of the first K distances
+				for (iterations = 0; ; ++iterations)
+				{
+					inertia = _assign(X, norms, centroids, labels, threads);
 
-				Note :  The XTest and result should be in correct order or undefined behavior may occur
-			*/
+					if (converged || iterations >= MaximumIterations) break;
 
-			try
-			{
-				if (X.size() == 0 || y.size() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor>Error :  Model is not built yet. Use model() to fit the model()");
-				
-				data::Storage distances(XTest.size(), std::vector<double>(X.size()));
+					if (giveUp && giveUp(iterations, inertia)) return std::numeric_limits<double>::infinity();
 
-				_calculateDistances(XTest, distances);
+					_centroidSums(X, labels, sums, counts, threads);
+					converged = _centroidUpdate(sums, counts, centroids) <= threshold;
+				}
+
+				return inertia;
+			}
 
-				data::Storage KlabelsIndexes(XTest.size(), std::vector<double>(K));
+			iterations = _boundedLloyd(X, threshold, centroids, labels, threads);
 
-				_neighborKSort(distances, KlabelsIndexes);
+			std::size_t blocks = _blocks(rows, 0), blockRows = (rows + blocks - 1) / blocks;
+			std::vector<double> blockInertia(blocks);
 
-				for (data::Storage::size_type row = 0; row < KlabelsIndexes.size(); ++row)
+			utils::parallel::forEach(0, blocks, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t block = first; block < last; ++block)
 				{
-					double mean = 0;
-					for (std::vector<double>::size_type col = 0; col < KlabelsIndexes[row].size(); ++col)
+					for (std::size_t row = block * blockRows; row < std::min(rows, (block + 1) * blockRows); ++row)
 					{
-						mean += y[static_cast<data::Storage::size_type>(KlabelsIndexes[row][col])][0];
+						blockInertia[block] += functions::distance::reduced(X[row].data(), centroids.data() + labels[row] * cols, cols, Metric, P);
 					}
-					result[row][0] = mean / K;
 				}
-			}
-			catch (const std::runtime_error& e)
-			{
-				std::cerr << e.what() << '\n';
-			}
-
+			}, threads);
 
+			return std::accumulate(blockInertia.begin(), blockInertia.end(), 0.0);
 		}
-		double KnnRegressor::rss(const data::Storage& y_pred, const data::Storage& y_true) noexcept
+
+		std::vector<double> KMeans::_norms(const data::Storage& X, const std::size_t& threads) const
 		{
 			/*
-				This function uses the following formula for calculating RSS
-				RSS = sum_of_((y_true - y_pred)^ 2)
+				The norm of an observation is its distance from the origin. MINKOWSKI with P below 1 is not a norm
+				(the triangle inequality does not hold), so no norms are returned for it
 			*/
+			if (Metric == distanceMetric::MINKOWSKI && P < 1) return std::vector<double>();
 
-			data::Storage difference(y_true.size(), std::vector<double>(1));
+			std::size_t rows = X.size(), cols = X[0].size();
+			std::vector<double> origin(cols), norms(rows);
 
+			utils::parallel::forEach(0, rows, [&](std::size_t first, std::size_t last)
+			{
+				for (std::size_t row = first; row < last; ++row)
+				{
+					norms[row] = functions::distance::fromReduced(functions::distance::reduced(X[row].data(), origin.data(), cols, Metric, P), Metric, P);
+				}
+			}, threads, 1024);
 
-			matrix::subtraction(y_true, y_pred, difference);
+			return norms;
+		}
 
-			array::power(difference, 2);
+		void KMeans::_sortCentroids(const std::vector<double>& centroids, std::vector<double>& sortedCentroids, std::vector<double>& sortedNorms, std::vector<std::size_t>& order) const
+		{
+			/*
+				Ties of norms keep the order of the centroids, so the result only depends on the centroids
+			*/
+			std::size_t cols = (K > 0) ? centroids.size() / K : 0;
+			std::vector<double> origin(cols), norms(K);
 
-			return array::sum(difference);
+			for (std::size_t centroid = 0; centroid < K; ++centroid)
+			{
+				norms[centroid] = functions::distance::fromReduced(functions::distance::reduced(centroids.data() + centroid * cols, origin.data(), cols, Metric, P), Metric, P);
+			}
 
+			order.resize(K);
+			std::iota(order.begin(), order.end(), static_cast<std::size_t>(0));
+			std::sort(order.begin(), order.end(), [&](std::size_t left, std::size_t right) { return norms[left] < norms[right] || (norms[left] == norms[right] && left < right); });
 
-		}
+			sortedNorms.resize(K);
+			sortedCentroids.resize(K * cols);
 
-		double KnnRegressor::score(const data::Storage& y_pred, const data::Storage& y_true) noexcept
-		{
-			/*
-				This function uses the following formula for calculating R^square
-				R^2 = 1 - RSS/TSS
-			 */
-			return (1 - (rss(y_pred, y_true) / (tss(y_true))));
+			for (std::size_t position = 0; position < K; ++position)
+			{
+				sortedNorms[position] = norms[order[position]];
+				std::copy(centroids.begin() + static_cast<std::ptrdiff_t>(order[position] * cols), centroids.begin() + static_cast<std::ptrdiff_t>((order[position] + 1) * cols), sortedCentroids.begin() + static_cast<std::ptrdiff_t>(position * cols));
+			}
 		}
 
-		double KnnRegressor::tss(const data::Storage& y) noexcept
+		std::size_t KMeans::memoryUsage(const std::size_t& rows, const std::size_t& cols) const noexcept
 		{
 			/*
-				This function uses the following formula for calculating TSS
-				TSS = sum_of_((y_true - y_true.mean())^2)
+				Every algorithm : a label per observation, two copies of the centroids and the sums of the blocks (see _centroidSums())
+				HAMERLY : an upper and a lower bound per observation, half distances and movements per centroid
+				ELKAN :   an upper bound and K lower bounds per observation, K X K distances between the centroids
+				Each of them for every restart running at the same time, plus the norms of the observations and the labels kept
 			*/
+			std::size_t runs = (Initialization == initialization::FIRST) ? 1 : std::max(Restarts, static_cast<std::size_t>(1));
+			std::size_t concurrent = std::min(runs, utils::parallel::threads(Threads));
 
-			data::Storage difference(y.size(), std::vector<double>(1));
-			data::Storage yCopy = y;
+			std::size_t values = 3 * K * cols + _blocks(rows, K * cols) * K * (cols + 1);
+			std::size_t bytes = rows * sizeof(std::uint32_t);
 
+			if (ClusteringAlgorithm == kMeansAlgorithm::HAMERLY) values += 2 * rows + 2 * K;
 
-			double mean = array::average(y);
-			array::subtract(yCopy, mean);
-			array::power(yCopy, 2);
+			else if (ClusteringAlgorithm == kMeansAlgorithm::ELKAN) values += rows * (K + 1) + K * K + 2 * K;
 
-			return array::sum(yCopy);
+			return concurrent * (bytes + values * sizeof(double)) + rows * (sizeof(double) + sizeof(std::uint32_t));
 		}
 
-		/*
-			Knn classifier class members
-		*/
-
-		KnnClassifier::KnnClassifier(const std::size_t& k, const distanceMetric& metric, const double& p) : KnnRegressor(k,metric,p)
+		void KMeans::model(const data::Storage& X, const selection& resetCentroids)
 		{
 			/*
-				Default values are passed to base class's constructor
+				Function created default centroids if they are not pre defined or if resetCentroids is set to yes
+				
+				Note : If resetCentroids is set to no. Once the Centroids are calculated they will not be re calculated if model is called on the 
+				same object again. This can be useful when assigning different user defined centroids. However clustering of observations will occur
+				each time
 			*/
+			try
+			{
+				if (X.empty() || X.size() < K) throw std::runtime_error("<In function cmll::neighbors::KMeans::model()>Error :  X needs at least K observations");
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+				return;
+			}
+
+			if (Centroids.size() == 0 || CentroidsAssigned.size() == 0 || resetCentroids == selection::YES)
+			{
+				Centroids.resize(K, std::vector<double>(X[0].size()));
+				CentroidsAssigned.resize(K);
+
+				_generator.seed(Seed);
+				_initializeCentroids(_chooseCentroids(X, Seed, Threads));
+
+				_cluster(X, Restarts);
+			}
+
+			else _cluster(X);
+
+			// partialFit() continues with every centroid weighted by its observations
+			_weights.resize(K);
+			_sinceReassignment = 0;
+
+			for (std::size_t centroid = 0; centroid < K; ++centroid)
+			{
+				_weights[centroid] = static_cast<double>(CentroidsAssigned[centroid].size());
+			}
 		}
 
-		void KnnClassifier::predict(const data::Storage& XTest, data::Storage& result) //throws std::runtime_error
+		void KMeans::partialFit(const data::Storage& batch)
 		{
 			/*
 				The steps followed by the function are as follows
 
-				1) Check if X and Y are defined . If not throw std::runtime_error
-				2) For every observation in the test set , find distances from each observation in X
-				3) For every observation sort the distances and keep the first K distances
-				4) For each observation assign  mode of the labels of the first K distances
-
-				Note :  The XTest and result should be in correct order or undefined behavior may occur
+				1) On the first batch choose the first centroids from it (see model()), with no weight
+				2) Assign every observation of the batch to its closest centroid and add them up per centroid (see _assign() and _centroidSums()),
+				   in parallel and independently of the number of threads
+				3) Move every centroid to (weight x centroid + sum) / (weight + count) and add count to its weight.
+				   The learning rate count / (weight + count) of a centroid only depends on the observations it was given
+				4) Once 10 x K observations were learned since the last time, move the centroids whose weight is below ReassignmentRatio
+				   times the largest weight (at most half the batch of them) to distinct random observations of the batch and give them
+				   the smallest weight of the others, so clusters left empty by a bad start take over part of the data
+				5) List the observations of the batch of every centroid in CentroidsAssigned
 			*/
+			if (batch.empty()) return;
 
-			try
-			{
-				if (X.size() == 0 || y.size() == 0) throw std::runtime_error("<In function cmll::neighbors::KnnRegressor>Error :  Model is not built yet. Use model() to fit the model()");
-
-				data::Storage distances(XTest.size(), std::vector<double>(X.size()));
-				data::Storage::size_type classes = array::unique(y);
-				std::vector<double> occurrence;
+			std::size_t rows = batch.size(), cols = batch[0].size();
 
-				_calculateDistances(XTest, distances);
+			if (Centroids.size() != K || _weights.size() != K)
+			{
+				try
+				{
+					if (rows < K) throw std::runtime_error("<In function cmll::neighbors::KMeans::partialFit()>Error :  The first batch needs at least K observations");
+				}
+				catch (const std::runtime_error& e)
+				{
+					std::cerr << e.what() << '\n';
+					return;
+				}
 
-				data::Storage KlabelsIndexes(XTest.size(), std::vector<double>(K));
+				Centroids.assign(K, std::vector<double>(cols));
+				CentroidsAssigned.assign(K, std::vector<double>());
+				_generator.seed(Seed);
+				_initializeCentroids(_chooseCentroids(batch, Seed, Threads));
 
-				_neighborKSort(distances, KlabelsIndexes);
+				_weights.assign(K, 0.0);
+				_sinceReassignment = 0;
+				Iterations = 0;
+			}
 
-				for (data::Storage::size_type row = 0; row < KlabelsIndexes.size(); ++row)
-				{
-					occurrence.resize(classes);
-					for (std::vector<double>::size_type col = 0; col < KlabelsIndexes[row].size(); ++col)
-					{
-						occurrence[static_cast<std::vector<double>::size_type>(y[static_cast<data::Storage::size_type>(KlabelsIndexes[row][col])][0])]+=1;
-					}
-					result[row][0] = static_cast<double>(std::distance(occurrence.begin(), std::max_element(occurrence.begin(), occurrence.end())));
-					occurrence.clear();
-				}
+			try
+			{
+				if (cols != Centroids[0].size()) throw std::runtime_error("<In function cmll::neighbors::KMeans::partialFit()>Error :  The batch does not have as many features as the centroids");
 			}
 			catch (const std::runtime_error& e)
 			{
 				std::cerr << e.what() << '\n';
+				return;
 			}
 
-			
-		}
-
-		double KnnClassifier::score(const data::Storage& y_pred, const data::Storage& y) noexcept
-		{
-
-			/*
-				Function uses standard indicator function for calculating accuracy.
-
-				Note :  Y_pred and y are supposed to be in correct order of NX1.
-			*/
+			std::vector<double> centroids(K * cols), sums;
+			std::vector<std::size_t> counts;
+			std::vector<std::uint32_t> labels;
 
-			double count = 0;
-			data::Storage::size_type observation = y.size();
-
-			for (data::Storage::size_type value = 0; value < observation; ++value)
+			for (std::size_t centroid = 0; centroid < K; ++centroid)
 			{
-				if (y[value][0] == y_pred[value][0]) ++count;
+				std::copy(Centroids[centroid].begin(), Centroids[centroid].end(), centroids.begin() + static_cast<std::ptrdiff_t>(centroid * cols));
 			}
 
-			return static_cast<double>(count / observation);
-		}
+			Inertia = _assign(batch, _norms(batch, Threads), centroids, labels, Threads);
+			_centroidSums(batch, labels, sums, counts, Threads);
 
-		/*
-			K Means class members
-		*/
+			for (std::size_t centroid = 0; centroid < K; ++centroid)
+			{
+				if (counts[centroid] == 0) continue;
 
-		KMeans::KMeans(const std::size_t& k, const distanceMetric& metric, const double& p) : KnnClassifier(k, metric, p)
-		{
-			/*
-				Constructor to assign defaults
-				
-			*/
+				double weight = _weights[centroid] + static_cast<double>(counts[centroid]);
 
-		}
-		void KMeans::_centroidUpdate(const std::vector<double>& x,const std::ptrdiff_t& centroidIndex)
-		{
-			/*
-				Function to update the centroids
+				for (std::size_t col = 0; col < cols; ++col)
+				{
+					Centroids[centroid][col] = (_weights[centroid] * Centroids[centroid][col] + sums[centroid * cols + col]) / weight;
+				}
 
-				New centroids = (last_centroid + new_observation )/2
-			*/
-			for (std::vector<double>::size_type row = 0; row < x.size(); ++row)
-			{
-				Centroids[centroidIndex][row] = ((x[row] + Centroids[centroidIndex][row]) / 2);
+				_weights[centroid] = weight;
 			}
-		}
 
-		void KMeans::_cluster(const data::Storage& X,const selection& updateCentroids)
-		{
-			/*	
-				Assigns cluster based on the closeSt distance to the cluster
-				the update_centroid when set to false , reconfigures/recalculates the cluster to create a new cluster
-             
-			*/
-			
-			std::vector<double> temp(K);
-			
-			for (data::Storage::size_type row = K; row < X.size(); ++row)
+			_sinceReassignment += rows;
+
+			if (ReassignmentRatio > 0 && _sinceReassignment >= 10 * K)
 			{
+				double threshold = ReassignmentRatio * *std::max_element(_weights.begin(), _weights.end());
+				double smallest = std::numeric_limits<double>::infinity();
+				std::vector<std::size_t> behind;
+
 				for (std::size_t centroid = 0; centroid < K; ++centroid)
 				{
-					temp[centroid] = DistanceCal(X[row], Centroids[centroid],0);
+					if (_weights[centroid] < threshold) behind.emplace_back(centroid);
+
+					else smallest = std::min(smallest, _weights[centroid]);
 				}
 
-				auto minIndex = std::distance(temp.begin(), std::min_element(temp.begin(), temp.end()));
+				if (behind.size() > rows / 2) behind.resize(rows / 2);
 
-				if (updateCentroids == selection::YES)
-				{
-					CentroidsAssigned[minIndex].emplace_back(static_cast<double>(row));
-					_centroidUpdate(X[row],minIndex);
-				}
-				
-				else
+				// Distinct observations : an observation already picked gives way to the next one
+				std::vector<std::size_t> picked;
+
+				for (std::size_t centroid : behind)
 				{
-					Prediction.emplace_back(static_cast<double>(minIndex));
+					std::size_t row = std::uniform_int_distribution<std::size_t>(0, rows - 1)(_generator);
+
+					while (std::find(picked.begin(), picked.end(), row) != picked.end()) row = (row + 1) % rows;
+
+					picked.emplace_back(row);
+					std::copy(batch[row].begin(), batch[row].end(), Centroids[centroid].begin());
+					_weights[centroid] = std::isinf(smallest) ? 0.0 : smallest;
 				}
+
+				_sinceReassignment = 0;
+			}
+
+			CentroidsAssigned.assign(K, std::vector<double>());
+
+			for (std::size_t row = 0; row < rows; ++row)
+			{
+				CentroidsAssigned[labels[row]].emplace_back(static_cast<double>(row));
 			}
+
+			_indexCentroids();
+
+			++Iterations;
 		}
-		
-		void KMeans::_initializeCentroids(const data::Storage& centroidValue)
+
+		void KMeans::partialFit(data::BatchReader& reader) // throws std::runtime_error
 		{
 			/*
-				Initializes default Centroids that is the first K observations in X
+				Two batches take turns : while one is learned from (on Threads threads), the next one is read into the other
+			*/
+			data::Storage batch, nextBatch;
 
-				Note :  Be really careful if manual Centroids are to be assigned.
+			bool more = reader.next(batch);
 
-				Assign the Centroids in the Centroids vector and also update Centroid assigned accordingly.
-				
-			*/
-					
-			for (data::Storage::size_type row = 0; row < K; ++row)
+			while (more)
 			{
-				for (std::vector<double>::size_type col = 0; col < centroidValue[row].size(); ++col)
-				{
-					Centroids[row][col] = centroidValue[row][col];
-				}
+				std::future<bool> reading = std::async(std::launch::async, [&reader, &nextBatch]() { return reader.next(nextBatch); });
 
-				CentroidsAssigned[row].emplace_back(static_cast<double>(row));
+				partialFit(batch);
+
+				more = reading.get();
+				batch.swap(nextBatch);
 			}
 		}
 		
-		void KMeans::model(const data::Storage& X, const selection& resetCentroids)
+		void KMeans::predict(const data::Storage& XTest, data::Storage& result) const
 		{
 			/*
-				Function created default centroids if they are not pre defined or if resetCentroids is set to yes
-				
-				Note : If resetCentroids is set to no. Once the Centroids are calculated they will not be re calculated if model is called on the 
-				same object again. This can be useful when assigning different user defined centroids. However clustering of observations will occur
-				each time
+				Threads take blocks of observations of XTest (see _queryBlock()) and write the centroid of every observation
+				to its row of result. Only the centroid index built when the centroids last changed is read, so several
+				threads may predict with the same model at the same time.
+				Ties go to the smaller centroid, as in model()
 			*/
-			
-			if (Centroids.size() == 0 || CentroidsAssigned.size() == 0 || resetCentroids == selection::YES)
+			try
 			{
-				Centroids.resize(K, std::vector<double>(X[0].size()));
-				CentroidsAssigned.resize(K);
-
-				_initializeCentroids(X);
+				if (Centroids.empty() || Centroids.size() != K) throw std::runtime_error("<In function cmll::neighbors::KMeans::predict()>Error :  Centroid vector is empty. Run model() or partialFit() first");
+			}
+			catch (const std::runtime_error& e)
+			{
+				std::cerr << e.what() << '\n';
+				return;
 			}
-			_cluster(X,selection::YES);
+
+			std::size_t rows = XTest.size(), cols = Centroids[0].size();
+
+			result.resize(rows);
+
+			utils::parallel::forEach(0, rows, [&](std::size_t first, std::size_t last)
+			{
+				std::vector<Neighbor> found;
+				std::vector<double> origin(cols);
+
+				for (std::size_t row = first; row < last; ++row)
+				{
+					const double* x = XTest[row].data();
+					std::size_t closest = 0;
+					double closestDistance = std::numeric_limits<double>::infinity();
+
+					if (_centroidIndex) _centroidIndex->query(XTest[row], 1, found);
+
+					// IVF_PQ finds nothing when the probed lists are empty, the centroids are then compared below
+					if (_centroidIndex && !found.empty())
+					{
+						closest = found[0].Index;
+					}
+
+					else if (!_sortedNorms.empty())
+					{
+						double norm = functions::distance::fromReduced(functions::distance::reduced(x, origin.data(), cols, Metric, P), Metric, P);
+						std::size_t start = static_cast<std::size_t>(std::lower_bound(_sortedNorms.begin(), _sortedNorms.end(), norm) - _sortedNorms.begin());
+
+						closest = _closest(x, norm, std::min(start, K - 1), _sortedCentroids, _sortedNorms, _order, closestDistance);
+					}
+
+					else
+					{
+						for (std::size_t centroid = 0; centroid < K; ++centroid)
+						{
+							double distance = functions::distance::reduced(x, Centroids[centroid].data(), cols, Metric, P);
+
+							if (distance < closestDistance)
+							{
+								closestDistance = distance;
+								closest = centroid;
+							}
+						}
+					}
+
+					result[row].assign(1, static_cast<double>(closest));
+				}
+			}, Threads, _queryBlock(rows));
 		}
-		
+
 		void KMeans::predict(const data::Storage& XTest, data::Storage& result, const selection& updateCentroid)
 		{
 			/*
-				Function assigns clusters to the new observations and updates old centroids if updateCentroid is set to yes
+				With updateCentroid set to yes Lloyd's algorithm is first run on XTest from the current centroids (batch learning)
 			*/
-			
-			_cluster(XTest, updateCentroid);
-			
-			for (std::vector<double>::size_type row = 0; row < Prediction.size(); ++row)
-			{
-				result[row] = { Prediction[row] };
-			}
+			if (updateCentroid == selection::YES && !XTest.empty() && Centroids.size() == K) _cluster(XTest);
+
+			predict(XTest, result);
 		}
 		
 	}
@@ -0,0 +1,456 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Neighbors/Lsh.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			Lsh class members
+		*/
+
+		std::size_t Lsh::_bucket(const std::int64_t* hashes) const noexcept
+		{
+			/*
+				The hashes are mixed into 64 bits (splitmix64 finalizer) and the low bits pick the bucket.
+				Different keys may share a bucket, which only adds candidates
+			*/
+			std::uint64_t key = 0x9E3779B97F4A7C15ULL;
+
+			for (std::size_t function = 0; function < HashFunctions; ++function)
+			{
+				key ^= static_cast<std::uint64_t>(hashes[function]) + 0x9E3779B97F4A7C15ULL + (key << 6) + (key >> 2);
+			}
+
+			key = (key ^ (key >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			key = (key ^ (key >> 27)) * 0x94D049BB133111EBULL;
+			key = key ^ (key >> 31);
+
+			return static_cast<std::size_t>(key & (_buckets - 1));
+		}
+
+		void Lsh::_project(const double* x, const std::size_t& table, double* projections) const noexcept
+		{
+			for (std::size_t function = 0; function < HashFunctions; ++function)
+			{
+				const double* direction = _directions.data() + (table * HashFunctions + function) * _cols;
+				double dot = 0;
+
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					dot += direction[col] * x[col];
+				}
+
+				projections[function] = dot / _width + _shifts[table * HashFunctions + function];
+			}
+		}
+
+		Lsh::Lsh(const std::size_t& tables, const std::size_t& hashFunctions, const std::size_t& probes, const double& width, const std::size_t& threads, const unsigned int& seed)
+		{
+			Tables = std::max(tables, static_cast<std::size_t>(1));
+			HashFunctions = std::max(hashFunctions, static_cast<std::size_t>(1));
+			Probes = probes;
+			Width = width;
+			Threads = threads;
+			Seed = seed;
+			_metric = distanceMetric::EUCLEDIAN;
+			_p = static_cast<double>(defaults::P);
+			_cols = 0;
+			_buckets = 1;
+			_rows = 0;
+			_width = 1;
+		}
+
+		void Lsh::build(const data::Storage& X, const distanceMetric& metric, const double& p)
+		{
+			/*
+				1) Draw the directions (gaussian, or cauchy for MANHATTAN) and the offsets (uniform in [0, 1))
+				2) If Width is 0, it is estimated from the mean distance r between (at most) 256 evenly spaced observations and their
+				   closest observation among (at most) 4096 evenly spaced ones. A projection then puts two observations r apart in the
+				   same bucket about 3 times out of 4 : width = 3r for the gaussian and 6r for the heavier tailed cauchy projections
+				3) Single pass over X : copy every observation and find its bucket in every table (in parallel)
+				4) For every table count the observations of each bucket, turn the counts into offsets and place the indexes
+			*/
+			_metric = metric;
+			_p = p;
+
+			_points = Values<double>();
+			_directions.clear();
+			_shifts.clear();
+			_offsets.clear();
+			_ids.clear();
+			_rows = 0;
+
+			if (X.size() == 0) return;
+
+			_rows = X.size();
+			_cols = X[0].size();
+
+			std::mt19937 generator(Seed);
+			std::normal_distribution<double> gaussian(0.0, 1.0);
+			std::cauchy_distribution<double> cauchy(0.0, 1.0);
+			std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+			_directions.resize(Tables * HashFunctions * _cols);
+			for (double& value : _directions)
+			{
+				value = (_metric == distanceMetric::MANHATTAN) ? cauchy(generator) : gaussian(generator);
+			}
+
+			_shifts.resize(Tables * HashFunctions);
+			for (double& value : _shifts)
+			{
+				value = uniform(generator);
+			}
+
+			_width = Width;
+
+			if (_width <= 0)
+			{
+				std::size_t samples = std::min(_rows, static_cast<std::size_t>(256)), references = std::min(_rows, static_cast<std::size_t>(4096));
+				double total = 0;
+
+				for (std::size_t sample = 0; sample < samples && references > 1; ++sample)
+				{
+					std::size_t row = sample * _rows / samples;
+					double closest = std::numeric_limits<double>::infinity();
+
+					for (std::size_t reference = 0; reference < references; ++reference)
+					{
+						std::size_t other = reference * _rows / references;
+
+						if (other != row) closest = std::min(closest, functions::distance::reduced(X[row].data(), X[other].data(), _cols, _metric, _p));
+					}
+
+					total += functions::distance::fromReduced(closest, _metric, _p);
+				}
+
+				_width = ((_metric == distanceMetric::MANHATTAN) ? 6.0 : 3.0) * total / static_cast<double>(samples);
+
+				if (!(_width > 0)) _width = 1;
+			}
+
+			_buckets = 1;
+			while (_buckets < _rows)
+			{
+				_buckets <<= 1;
+			}
+
+			std::vector<double> points(_rows * _cols);
+			std::vector<std::uint32_t> buckets(Tables * _rows);
+
+			utils::parallel::forEach(0, _rows, [&](std::size_t begin, std::size_t end)
+			{
+				std::vector<double> projections(HashFunctions);
+				std::vector<std::int64_t> hashes(HashFunctions);
+
+				for (std::size_t row = begin; row < end; ++row)
+				{
+					std::copy(X[row].begin(), X[row].end(), points.begin() + row * _cols);
+
+					for (std::size_t table = 0; table < Tables; ++table)
+					{
+						_project(X[row].data(), table, projections.data());
+
+						for (std::size_t function = 0; function < HashFunctions; ++function)
+						{
+							hashes[function] = static_cast<std::int64_t>(std::floor(projections[function]));
+						}
+
+						buckets[table * _rows + row] = static_cast<std::uint32_t>(_bucket(hashes.data()));
+					}
+				}
+			}, Threads, 1024);
+
+			_points = Values<double>(std::move(points));
+
+			_offsets.resize(Tables);
+			_ids.resize(Tables);
+
+			utils::parallel::forEach(0, Tables, [&](std::size_t begin, std::size_t end)
+			{
+				for (std::size_t table = begin; table < end; ++table)
+				{
+					std::vector<std::uint32_t>& offsets = _offsets[table];
+					std::vector<std::uint32_t>& ids = _ids[table];
+					const std::uint32_t* bucket = buckets.data() + table * _rows;
+
+					offsets.assign(_buckets + 1, 0);
+
+					for (std::size_t row = 0; row < _rows; ++row)
+					{
+						++offsets[bucket[row] + 1];
+					}
+
+					for (std::size_t slot = 0; slot < _buckets; ++slot)
+					{
+						offsets[slot + 1] += offsets[slot];
+					}
+
+					std::vector<std::uint32_t> next(offsets.begin(), offsets.end() - 1);
+					ids.resize(_rows);
+
+					for (std::size_t row = 0; row < _rows; ++row)
+					{
+						ids[next[bucket[row]]++] = static_cast<std::uint32_t>(row);
+					}
+				}
+			}, Threads);
+		}
+
+		bool Lsh::holdsObservations() const noexcept
+		{
+			return true;
+		}
+
+		void Lsh::load(std::istream& in) // throws std::runtime_error
+		{
+			/*
+				Reads the layout written by save()
+			*/
+			std::uint64_t header[5] = { 0 };
+			double widths[2] = { 0 };
+
+			if (!_readHeader(in, "CMLLLSH1")) throw std::runtime_error("<In function cmll::neighbors::Lsh::load()>Error : The stream does not hold a LSH index");
+
+			in.read(reinterpret_cast<char*>(header), sizeof(header));
+			in.read(reinterpret_cast<char*>(widths), sizeof(widths));
+
+			Tables = static_cast<std::size_t>(header[0]);
+			HashFunctions = static_cast<std::size_t>(header[1]);
+			Probes = static_cast<std::size_t>(header[2]);
+			_buckets = static_cast<std::size_t>(header[3]);
+			_rows = static_cast<std::size_t>(header[4]);
+			Width = widths[0];
+			_width = widths[1];
+
+			_read(in, _points);
+			_read(in, _directions);
+			_read(in, _shifts);
+
+			// Every table holds at least the counts of its offsets and indexes
+			if (in && _rows > 0 && Tables > _remaining(in) / (2 * sizeof(std::uint64_t))) throw std::runtime_error("<In function cmll::neighbors::Lsh::load()>Error : The stream holds fewer tables than it counts");
+
+			_offsets.assign((in && _rows > 0) ? Tables : 0, std::vector<std::uint32_t>());
+			_ids.assign(_offsets.size(), std::vector<std::uint32_t>());
+
+			for (std::size_t table = 0; table < _offsets.size() && in; ++table)
+			{
+				_read(in, _offsets[table]);
+				_read(in, _ids[table]);
+			}
+
+			if (!in) throw std::runtime_error("<In function cmll::neighbors::Lsh::load()>Error : The stream ended before the index was read");
+		}
+
+		const double* Lsh::observation(const std::size_t& id) const noexcept
+		{
+			return _points.data() + id * _cols;
+		}
+
+		void Lsh::query(const std::vector<double>& x, const std::size_t& k, std::vector<Neighbor>& result, const std::size_t& effort) const
+		{
+			/*
+				For every table read the bucket of x and then the probes buckets with the smallest score, where moving projection i
+				one bucket down costs fraction_i^2 and one bucket up (1 - fraction_i)^2. The perturbations are generated in
+				increasing score with a heap (shift : replace the last perturbation with the next one, expand : add the next one).
+
+				While less than k observations are found, more buckets are read. Every observation found is compared once
+				(per thread tags as in Hnsw). If it still found less than k observations, the rest are compared too.
+			*/
+			result.clear();
+
+			if (_rows == 0 || k == 0) return;
+
+			thread_local std::vector<std::uint32_t> visited;
+			thread_local std::uint32_t tag = 0;
+
+			if (visited.size() < _rows)
+			{
+				visited.assign(_rows, 0);
+				tag = 0;
+			}
+
+			if (++tag == 0)
+			{
+				std::fill(visited.begin(), visited.end(), 0);
+				tag = 1;
+			}
+
+			std::size_t probes = (effort > 0) ? effort : Probes;
+
+			NeighborHeap heap(k);
+			std::size_t seen = 0;
+
+			auto scan = [&](std::size_t table, std::size_t bucket)
+			{
+				const std::vector<std::uint32_t>& ids = _ids[table];
+
+				for (std::uint32_t slot = _offsets[table][bucket]; slot < _offsets[table][bucket + 1]; ++slot)
+				{
+					std::uint32_t id = ids[slot];
+
+					if (visited[id] == tag) continue;
+
+					visited[id] = tag;
+					++seen;
+					heap.push(functions::distance::reduced(x.data(), _points.data() + static_cast<std::size_t>(id) * _cols, _cols, _metric, _p), id);
+				}
+			};
+
+			typedef std::pair<double, std::vector<std::size_t>> Perturbation;
+			auto larger = [](const Perturbation& first, const Perturbation& second) { return first.first > second.first; };
+
+			std::vector<double> projections(HashFunctions);
+			std::vector<std::int64_t> hashes(HashFunctions), probe(HashFunctions);
+			std::vector<std::pair<double, std::size_t>> boundaries(2 * HashFunctions);
+
+			for (std::size_t table = 0; table < Tables; ++table)
+			{
+				_project(x.data(), table, projections.data());
+
+				for (std::size_t function = 0; function < HashFunctions; ++function)
+				{
+					hashes[function] = static_cast<std::int64_t>(std::floor(projections[function]));
+
+					double fraction = projections[function] - static_cast<double>(hashes[function]);
+
+					boundaries[2 * function] = { fraction * fraction, 2 * function };
+					boundaries[2 * function + 1] = { (1 - fraction) * (1 - fraction), 2 * function + 1 };
+				}
+
+				scan(table, _bucket(hashes.data()));
+
+				if (probes == 0 && seen >= k) continue;
+
+				std::sort(boundaries.begin(), boundaries.end());
+
+				std::priority_queue<Perturbation, std::vector<Perturbation>, decltype(larger)> perturbations(larger);
+				perturbations.push({ boundaries[0].first, { 0 } });
+
+				std::size_t probed = 0;
+
+				while ((probed < probes || seen < k) && probed < probes + 4096 && !perturbations.empty())
+				{
+					Perturbation current = perturbations.top();
+					perturbations.pop();
+
+					std::size_t last = current.second.back();
+
+					if (last + 1 < boundaries.size())
+					{
+						Perturbation shifted = current, expanded = current;
+
+						shifted.first += boundaries[last + 1].first - boundaries[last].first;
+						shifted.second.back() = last + 1;
+
+						expanded.first += boundaries[last + 1].first;
+						expanded.second.push_back(last + 1);
+
+						perturbations.push(shifted);
+						perturbations.push(expanded);
+					}
+
+					// A projection can not move both up and down
+					probe = hashes;
+					bool valid = true;
+
+					for (std::size_t index : current.second)
+					{
+						std::size_t function = boundaries[index].second / 2;
+
+						if (probe[function] != hashes[function])
+						{
+							valid = false;
+							break;
+						}
+
+						probe[function] += (boundaries[index].second % 2 == 1) ? 1 : -1;
+					}
+
+					if (!valid) continue;
+
+					scan(table, _bucket(probe.data()));
+					++probed;
+				}
+			}
+
+			if (seen < std::min(k, _rows))
+			{
+				for (std::size_t row = 0; row < _rows; ++row)
+				{
+					if (visited[row] != tag) heap.push(functions::distance::reduced(x.data(), _points.data() + row * _cols, _cols, _metric, _p), row);
+				}
+			}
+
+			heap.sorted(result);
+
+			for (Neighbor& neighbor : result)
+			{
+				neighbor.Distance = functions::distance::fromReduced(neighbor.Distance, _metric, _p);
+			}
+		}
+
+		void Lsh::save(std::ostream& out) const
+		{
+			/*
+				Layout (native byte order) :
+
+				header (see Index), Tables, HashFunctions, Probes, buckets, observations (uint64 each), Width and the width used (double each),
+				then observations, directions, offsets of the projections and the bucket offsets and indexes of every table, each preceded by its count
+			*/
+			std::uint64_t header[5] = { Tables, HashFunctions, Probes, _buckets, _rows };
+			double widths[2] = { Width, _width };
+
+			_writeHeader(out, "CMLLLSH1");
+			out.write(reinterpret_cast<const char*>(header), sizeof(header));
+			out.write(reinterpret_cast<const char*>(widths), sizeof(widths));
+
+			_write(out, _points);
+			_write(out, _directions);
+			_write(out, _shifts);
+
+			for (std::size_t table = 0; table < _offsets.size(); ++table)
+			{
+				_write(out, _offsets[table]);
+				_write(out, _ids[table]);
+			}
+		}
+
+		std::size_t Lsh::size() const noexcept
+		{
+			return _rows;
+		}
+	}
+}
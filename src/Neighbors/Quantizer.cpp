@@ -0,0 +1,424 @@
+
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include "../../includes/Neighbors/Quantizer.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	/*
+		neighbors name space : For algorithms using neighbors approach
+	*/
+	namespace neighbors
+	{
+		/*
+			Scalar Quantizer class members
+		*/
+
+		float ScalarQuantizer::_fromHalf(std::uint16_t half) noexcept
+		{
+			/*
+				The half precision layout is 1 sign bit, 5 exponent bits (bias 15) and 10 mantissa bits.
+				The bits are moved into the single precision layout (bias 127). Subnormal halves are normalized first.
+			*/
+
+			std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000u) << 16;
+			std::uint32_t exponent = (half >> 10) & 0x1fu;
+			std::uint32_t mantissa = half & 0x3ffu;
+			std::uint32_t bits;
+
+			if (exponent == 0x1fu)
+			{
+				// Infinity and NaN
+				bits = sign | 0x7f800000u | (mantissa << 13);
+			}
+
+			else if (exponent != 0)
+			{
+				bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+			}
+
+			else if (mantissa == 0)
+			{
+				bits = sign;
+			}
+
+			else
+			{
+				exponent = 113;
+				while (!(mantissa & 0x400u))
+				{
+					mantissa <<= 1;
+					--exponent;
+				}
+				bits = sign | (exponent << 23) | ((mantissa & 0x3ffu) << 13);
+			}
+
+			float value;
+			std::memcpy(&value, &bits, sizeof(value));
+			return value;
+		}
+
+		const float* ScalarQuantizer::_halves() noexcept
+		{
+			/*
+				A function local static is initialized once, even when several threads call this at the same time
+			*/
+			static const std::vector<float> table = []()
+			{
+				std::vector<float> values(65536);
+
+				for (std::uint32_t half = 0; half < 65536; ++half)
+				{
+					values[half] = _fromHalf(static_cast<std::uint16_t>(half));
+				}
+
+				return values;
+			}();
+
+			return table.data();
+		}
+
+		std::uint16_t ScalarQuantizer::_toHalf(float value) noexcept
+		{
+			/*
+				Inverse of _fromHalf(). The dropped mantissa bits are rounded to the nearest even value,
+				values too large for half precision become infinity and values too small become (signed) zero
+			*/
+
+			std::uint32_t bits;
+			std::memcpy(&bits, &value, sizeof(bits));
+
+			std::uint32_t sign = (bits >> 16) & 0x8000u;
+			std::uint32_t floatExponent = (bits >> 23) & 0xffu;
+			std::uint32_t mantissa = bits & 0x7fffffu;
+			long exponent = static_cast<long>(floatExponent) - 112;
+
+			if (floatExponent == 0xffu) return static_cast<std::uint16_t>(sign | 0x7c00u | (mantissa ? 0x200u : 0u));
+
+			if (exponent >= 31) return static_cast<std::uint16_t>(sign | 0x7c00u);
+
+			if (exponent <= 0)
+			{
+				if (exponent < -10) return static_cast<std::uint16_t>(sign);
+
+				mantissa |= 0x800000u;
+
+				std::uint32_t shift = static_cast<std::uint32_t>(14 - exponent);
+				std::uint32_t half = mantissa >> shift;
+				std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+				std::uint32_t halfway = 1u << (shift - 1);
+
+				if (remainder > halfway || (remainder == halfway && (half & 1u))) ++half;
+
+				return static_cast<std::uint16_t>(sign | half);
+			}
+
+			std::uint32_t half = sign | (static_cast<std::uint32_t>(exponent) << 10) | (mantissa >> 13);
+			std::uint32_t remainder = mantissa & 0x1fffu;
+
+			// A carry out of the mantissa correctly increments the exponent
+			if (remainder > 0x1000u || (remainder == 0x1000u && (half & 1u))) ++half;
+
+			return static_cast<std::uint16_t>(half);
+		}
+
+		ScalarQuantizer::ScalarQuantizer(const quantization& type)
+		{
+			/*
+				Constructor to load the precision
+			*/
+			Type = type;
+			_rows = 0;
+			_cols = 0;
+		}
+
+		void ScalarQuantizer::append(const data::Storage& X) noexcept
+		{
+			/*
+				The observations are encoded with the parameters found by fit(). For INT8 values outside the range seen by fit()
+				are clamped to [-128, 127]
+			*/
+			if (Type == quantization::NONE || X.size() == 0 || _cols == 0) return;
+
+			std::size_t first = _rows;
+			_rows += X.size();
+
+			if (Type == quantization::INT8)
+			{
+				_codes8.resize(_rows * _cols);
+
+				for (data::Storage::size_type row = 0; row < X.size(); ++row)
+				{
+					std::int8_t* codes = _codes8.data() + (first + row) * _cols;
+
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						double code = std::round((X[row][col] - _offset[col]) / _scale[col]);
+						codes[col] = static_cast<std::int8_t>(std::min(127.0, std::max(-128.0, code)));
+					}
+				}
+			}
+
+			else if (Type == quantization::FLOAT16)
+			{
+				_codes16.resize(_rows * _cols);
+
+				for (data::Storage::size_type row = 0; row < X.size(); ++row)
+				{
+					std::uint16_t* codes = _codes16.data() + (first + row) * _cols;
+
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						codes[col] = _toHalf(static_cast<float>(X[row][col]));
+					}
+				}
+			}
+		}
+
+		void ScalarQuantizer::clear() noexcept
+		{
+			/*
+				Releasing every code and parameter
+			*/
+			_codes8.clear();
+			_codes8.shrink_to_fit();
+			_codes16.clear();
+			_codes16.shrink_to_fit();
+			_scale.clear();
+			_scaleSquare.clear();
+			_offset.clear();
+
+			_rows = 0;
+			_cols = 0;
+		}
+
+		void ScalarQuantizer::decode(const std::size_t& row, std::vector<double>& result) const noexcept
+		{
+			/*
+				INT8 :  value = offset + scale * code
+				FLOAT16 : value = float(code)
+			*/
+			if (Type == quantization::INT8)
+			{
+				const std::int8_t* codes = _codes8.data() + row * _cols;
+
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					result[col] = _offset[col] + static_cast<double>(_scale[col]) * codes[col];
+				}
+			}
+
+			else if (Type == quantization::FLOAT16)
+			{
+				const std::uint16_t* codes = _codes16.data() + row * _cols;
+				const float* halves = _halves();
+
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					result[col] = static_cast<double>(halves[codes[col]]);
+				}
+			}
+		}
+
+		double ScalarQuantizer::distance(const std::vector<float>& query, const std::size_t& row, const distanceMetric& metric, const double& p) const noexcept
+		{
+			/*
+				For INT8 the query is already in code space ( (x - offset) / scale ). So for every feature
+
+								x - value = scale * (query - code)
+
+				and the kernels below only read the contiguous codes of the row. For FLOAT16 a code is decoded by a load
+				from the table of _halves(). The loops have no branches so that they can be vectorized by the compiler
+				(the FLOAT16 loads need gather instructions).
+			*/
+
+			float sum = 0;
+
+			if (Type == quantization::INT8)
+			{
+				const std::int8_t* codes = _codes8.data() + row * _cols;
+				const float* q = query.data();
+
+				if (metric == distanceMetric::EUCLEDIAN)
+				{
+					const float* weight = _scaleSquare.data();
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						float difference = q[col] - static_cast<float>(codes[col]);
+						sum += weight[col] * difference * difference;
+					}
+				}
+
+				else if (metric == distanceMetric::MANHATTAN)
+				{
+					const float* weight = _scale.data();
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						sum += weight[col] * std::abs(q[col] - static_cast<float>(codes[col]));
+					}
+				}
+
+				else
+				{
+					double total = 0;
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						total += std::pow(static_cast<double>(_scale[col] * std::abs(q[col] - static_cast<float>(codes[col]))), p);
+					}
+					return total;
+				}
+			}
+
+			else if (Type == quantization::FLOAT16)
+			{
+				const std::uint16_t* codes = _codes16.data() + row * _cols;
+				const float* halves = _halves();
+				const float* q = query.data();
+
+				if (metric == distanceMetric::EUCLEDIAN)
+				{
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						float difference = q[col] - halves[codes[col]];
+						sum += difference * difference;
+					}
+				}
+
+				else if (metric == distanceMetric::MANHATTAN)
+				{
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						sum += std::abs(q[col] - halves[codes[col]]);
+					}
+				}
+
+				else
+				{
+					double total = 0;
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						total += std::pow(static_cast<double>(std::abs(q[col] - halves[codes[col]])), p);
+					}
+					return total;
+				}
+			}
+
+			return static_cast<double>(sum);
+		}
+
+		void ScalarQuantizer::fit(const data::Storage& X) noexcept
+		{
+			/*
+				INT8 :  For every feature the range [minimum, maximum] is mapped onto [-128, 127]
+
+								scale = (maximum - minimum) / 255
+								offset = minimum + 128 * scale
+								code = round( (x - offset) / scale )
+
+						Constant features get a scale of 1 so that they are reconstructed exactly.
+
+				FLOAT16 :  Every value is rounded to the nearest half precision float
+			*/
+
+			clear();
+
+			if (Type == quantization::NONE || X.size() == 0) return;
+
+			_cols = X[0].size();
+
+			if (Type == quantization::INT8)
+			{
+				std::vector<double> minimum(X[0]), maximum(X[0]);
+
+				for (data::Storage::size_type row = 1; row < X.size(); ++row)
+				{
+					for (std::size_t col = 0; col < _cols; ++col)
+					{
+						minimum[col] = std::min(minimum[col], X[row][col]);
+						maximum[col] = std::max(maximum[col], X[row][col]);
+					}
+				}
+
+				_scale.resize(_cols);
+				_scaleSquare.resize(_cols);
+				_offset.resize(_cols);
+
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					double scale = (maximum[col] - minimum[col]) / 255;
+					if (scale <= 0) scale = 1;
+
+					_scale[col] = static_cast<float>(scale);
+					_scaleSquare[col] = _scale[col] * _scale[col];
+					_offset[col] = minimum[col] + 128 * static_cast<double>(_scale[col]);
+				}
+			}
+
+			append(X);
+		}
+
+		std::size_t ScalarQuantizer::memoryUsage() const noexcept
+		{
+			/*
+				Bytes held by the codes plus the per feature parameters
+			*/
+			return _codes8.size() * sizeof(std::int8_t) + _codes16.size() * sizeof(std::uint16_t) + (_scale.size() + _scaleSquare.size()) * sizeof(float) + _offset.size() * sizeof(double);
+		}
+
+		void ScalarQuantizer::prepare(const std::vector<double>& x, std::vector<float>& query) const noexcept
+		{
+			/*
+				INT8 :  query = (x - offset) / scale
+				FLOAT16 : query = x
+			*/
+			query.resize(_cols);
+
+			if (Type == quantization::INT8)
+			{
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					query[col] = static_cast<float>((x[col] - _offset[col]) / _scale[col]);
+				}
+			}
+
+			else
+			{
+				for (std::size_t col = 0; col < _cols; ++col)
+				{
+					query[col] = static_cast<float>(x[col]);
+				}
+			}
+		}
+
+		std::size_t ScalarQuantizer::rows() const noexcept
+		{
+			return _rows;
+		}
+	}
+}
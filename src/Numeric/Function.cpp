@@ -14,7 +14,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 8, 2020
-	* Last modified : April 10, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (0.1.0)
 
@@ -118,6 +118,18 @@ namespace cmll
 				return std::sqrt(sum);
 			}
 
+			double fromReduced(const double& value, const neighbors::distanceMetric& metric, const double& p) noexcept
+			{
+				/*
+					Applies the root skipped by reduced()
+				*/
+				if (metric == neighbors::distanceMetric::EUCLEDIAN) return std::sqrt(value);
+
+				if (metric == neighbors::distanceMetric::MINKOWSKI) return std::pow(value, 1 / p);
+
+				return value;
+			}
+
 			double manhattan(const std::vector<double>& x, const std::vector<double>& y, const double &none)
 			{
 				double sum = 0;
@@ -134,11 +146,105 @@ namespace cmll
 				double sum = 0;
 				for (std::vector<double>::size_type di = 0; di < x.size(); ++di)
 				{
-					sum += std::pow((x[di] - y[di]), p);
+					sum += std::pow(std::abs(x[di] - y[di]), p);
 				}
 
 				return std::pow(sum, (1 / p));
 			}
+
+			double reduced(const double* x, const double* y, const std::size_t& size, const neighbors::distanceMetric& metric, const double& p) noexcept
+			{
+				/*
+					EUCLEDIAN :  sum( (x[i]-y[i])^2 )
+					MANHATTAN :  sum( |x[i]-y[i]| )
+					MINKOWSKI :  sum( |x[i]-y[i]|^p )
+
+					The loops are kept free of branches so that they can be vectorized
+				*/
+				double sum = 0;
+
+				if (metric == neighbors::distanceMetric::EUCLEDIAN)
+				{
+					for (std::size_t di = 0; di < size; ++di)
+					{
+						double difference = x[di] - y[di];
+						sum += difference * difference;
+					}
+				}
+
+				else if (metric == neighbors::distanceMetric::MANHATTAN)
+				{
+					for (std::size_t di = 0; di < size; ++di)
+					{
+						sum += std::abs(x[di] - y[di]);
+					}
+				}
+
+				else
+				{
+					for (std::size_t di = 0; di < size; ++di)
+					{
+						sum += std::pow(std::abs(x[di] - y[di]), p);
+					}
+				}
+
+				return sum;
+			}
+
+			double reducedWithin(const double* x, const double* y, const std::size_t& size, const neighbors::distanceMetric& metric, const double& p, const double& bound) noexcept
+			{
+				/*
+					Same sums as reduced(), over blocks of 8 features.
+					The sum only grows, so once it is larger than bound the observation can not be within it
+				*/
+				double sum = 0;
+
+				for (std::size_t begin = 0; begin < size; begin += 8)
+				{
+					std::size_t end = std::min(begin + 8, size);
+
+					if (metric == neighbors::distanceMetric::EUCLEDIAN)
+					{
+						for (std::size_t di = begin; di < end; ++di)
+						{
+							double difference = x[di] - y[di];
+							sum += difference * difference;
+						}
+					}
+
+					else if (metric == neighbors::distanceMetric::MANHATTAN)
+					{
+						for (std::size_t di = begin; di < end; ++di)
+						{
+							sum += std::abs(x[di] - y[di]);
+						}
+					}
+
+					else
+					{
+						for (std::size_t di = begin; di < end; ++di)
+						{
+							sum += std::pow(std::abs(x[di] - y[di]), p);
+						}
+					}
+
+					if (sum > bound) return sum;
+				}
+
+				return sum;
+			}
+
+			double toReduced(const double& value, const neighbors::distanceMetric& metric, const double& p) noexcept
+			{
+				/*
+					Inverse of fromReduced()
+				*/
+				if (metric == neighbors::distanceMetric::EUCLEDIAN) return value * value;
+
+				if (metric == neighbors::distanceMetric::MINKOWSKI) return std::pow(value, p);
+
+				return value;
+			}
 		}
 	}
 }
\ No newline at end of file
@@ -14,7 +14,7 @@
 	* Project version 0.1.0
 	* File version 0.1.0
 	* Date created : February 8, 2020
-	* Last modified : April 10, 2020
+	* Last modified : October 19, 2026
 
 	* Change logs (0.1.0)
 
@@ -67,6 +67,75 @@ namespace cmll
 			}
 		}
 
+		bool cholesky(const data::Storage& matrix, data::Storage& l) noexcept
+		{
+			/*
+					The Cholesky-Banachiewicz algorithm, row by row :
+
+							l[i][j] = ( matrix[i][j] - sum_{k<j} l[i][k].l[j][k] ) / l[j][j]		j < i
+							l[i][i] = sqrt( matrix[i][i] - sum_{k<i} l[i][k]^2 )
+
+					The matrix should be in order of NXN or undefined behavior may occur.
+			*/
+			data::Storage::size_type rows = matrix.size();
+
+			l.assign(rows, std::vector<double>(rows, 0));
+
+			for (data::Storage::size_type i = 0; i < rows; i++)
+			{
+				for (data::Storage::size_type j = 0; j <= i; j++)
+				{
+					double sum = matrix[i][j];
+
+					for (data::Storage::size_type k = 0; k < j; k++)
+						sum -= l[i][k] * l[j][k];
+
+					if (i != j)
+					{
+						l[i][j] = sum / l[j][j];
+					}
+					else
+					{
+						if (!(sum > 0)) return false;
+
+						l[i][i] = std::sqrt(sum);
+					}
+				}
+			}
+
+			return true;
+		}
+
+		void choleskySolve(const data::Storage& l, const data::Storage& vector, data::Storage& result) noexcept
+		{
+			/*
+					l.u = vector is solved by forward substitution and then l^T.result = u by backward substitution
+			*/
+			data::Storage::size_type rows = l.size();
+
+			result.assign(rows, std::vector<double>(1));
+
+			for (data::Storage::size_type i = 0; i < rows; i++)
+			{
+				double sum = vector[i][0];
+
+				for (data::Storage::size_type k = 0; k < i; k++)
+					sum -= l[i][k] * result[k][0];
+
+				result[i][0] = sum / l[i][i];
+			}
+
+			for (data::Storage::size_type i = rows; i-- > 0;)
+			{
+				double sum = result[i][0];
+
+				for (data::Storage::size_type k = i + 1; k < rows; k++)
+					sum -= l[k][i] * result[k][0];
+
+				result[i][0] = sum / l[i][i];
+			}
+		}
+
 		void diagonalAddition(const data::Storage& matrixLhs, const data::Storage& vector, data::Storage& result) noexcept
 		{
 			/*
@@ -180,6 +249,241 @@ namespace cmll
 
 		}
 
+		void eigen(const data::Storage& matrix, data::Storage& values, data::Storage& vectors) noexcept
+		{
+			/*
+					The EISPACK routines tred2 (Householder tridiagonalization, the transformations accumulated in vectors)
+					and tql2 (QL iterations with implicit shifts on the tridiagonal matrix d, e), as in JAMA.
+
+					The matrix should be symmetric and in order of NXN or undefined behavior may occur.
+			*/
+			long n = static_cast<long>(matrix.size());
+
+			vectors = matrix;
+			values.assign(n, std::vector<double>(1));
+
+			if (n == 0) return;
+
+			std::vector<double> d(n), e(n);
+
+			// Householder reduction to tridiagonal form
+			for (long j = 0; j < n; j++)
+				d[j] = vectors[n - 1][j];
+
+			for (long i = n - 1; i > 0; i--)
+			{
+				double scale = 0, h = 0;
+
+				for (long k = 0; k < i; k++)
+					scale += std::abs(d[k]);
+
+				if (scale == 0)
+				{
+					e[i] = d[i - 1];
+
+					for (long j = 0; j < i; j++)
+					{
+						d[j] = vectors[i - 1][j];
+						vectors[i][j] = 0;
+						vectors[j][i] = 0;
+					}
+				}
+				else
+				{
+					for (long k = 0; k < i; k++)
+					{
+						d[k] /= scale;
+						h += d[k] * d[k];
+					}
+
+					double f = d[i - 1], g = std::sqrt(h);
+
+					if (f > 0) g = -g;
+
+					e[i] = scale * g;
+					h -= f * g;
+					d[i - 1] = f - g;
+
+					for (long j = 0; j < i; j++)
+						e[j] = 0;
+
+					for (long j = 0; j < i; j++)
+					{
+						f = d[j];
+						vectors[j][i] = f;
+						g = e[j] + vectors[j][j] * f;
+
+						for (long k = j + 1; k <= i - 1; k++)
+						{
+							g += vectors[k][j] * d[k];
+							e[k] += vectors[k][j] * f;
+						}
+
+						e[j] = g;
+					}
+
+					f = 0;
+
+					for (long j = 0; j < i; j++)
+					{
+						e[j] /= h;
+						f += e[j] * d[j];
+					}
+
+					double hh = f / (h + h);
+
+					for (long j = 0; j < i; j++)
+						e[j] -= hh * d[j];
+
+					for (long j = 0; j < i; j++)
+					{
+						f = d[j];
+						g = e[j];
+
+						for (long k = j; k <= i - 1; k++)
+							vectors[k][j] -= (f * e[k] + g * d[k]);
+
+						d[j] = vectors[i - 1][j];
+						vectors[i][j] = 0;
+					}
+				}
+
+				d[i] = h;
+			}
+
+			// Accumulate the transformations
+			for (long i = 0; i < n - 1; i++)
+			{
+				vectors[n - 1][i] = vectors[i][i];
+				vectors[i][i] = 1;
+
+				double h = d[i + 1];
+
+				if (h != 0)
+				{
+					for (long k = 0; k <= i; k++)
+						d[k] = vectors[k][i + 1] / h;
+
+					for (long j = 0; j <= i; j++)
+					{
+						double g = 0;
+
+						for (long k = 0; k <= i; k++)
+							g += vectors[k][i + 1] * vectors[k][j];
+
+						for (long k = 0; k <= i; k++)
+							vectors[k][j] -= g * d[k];
+					}
+				}
+
+				for (long k = 0; k <= i; k++)
+					vectors[k][i + 1] = 0;
+			}
+
+			for (long j = 0; j < n; j++)
+			{
+				d[j] = vectors[n - 1][j];
+				vectors[n - 1][j] = 0;
+			}
+
+			vectors[n - 1][n - 1] = 1;
+			e[0] = 0;
+
+			// QL iterations on the tridiagonal matrix
+			for (long i = 1; i < n; i++)
+				e[i - 1] = e[i];
+
+			e[n - 1] = 0;
+
+			double f = 0, tst1 = 0, eps = std::pow(2.0, -52.0);
+
+			for (long l = 0; l < n; l++)
+			{
+				tst1 = std::max(tst1, std::abs(d[l]) + std::abs(e[l]));
+
+				long m = l;
+
+				while (m < n - 1 && std::abs(e[m]) > eps * tst1)
+					m++;
+
+				if (m > l)
+				{
+					do
+					{
+						double g = d[l];
+						double p = (d[l + 1] - g) / (2 * e[l]);
+						double r = std::hypot(p, 1.0);
+
+						if (p < 0) r = -r;
+
+						d[l] = e[l] / (p + r);
+						d[l + 1] = e[l] * (p + r);
+
+						double dl1 = d[l + 1], h = g - d[l];
+
+						for (long i = l + 2; i < n; i++)
+							d[i] -= h;
+
+						f += h;
+
+						p = d[m];
+
+						double c = 1, c2 = c, c3 = c, el1 = e[l + 1], s = 0, s2 = 0;
+
+						for (long i = m - 1; i >= l; i--)
+						{
+							c3 = c2;
+							c2 = c;
+							s2 = s;
+							g = c * e[i];
+							h = c * p;
+							r = std::hypot(p, e[i]);
+							e[i + 1] = s * r;
+							s = e[i] / r;
+							c = p / r;
+							p = c * d[i] - s * g;
+							d[i + 1] = h + s * (c * g + s * d[i]);
+
+							for (long k = 0; k < n; k++)
+							{
+								h = vectors[k][i + 1];
+								vectors[k][i + 1] = s * vectors[k][i] + c * h;
+								vectors[k][i] = c * vectors[k][i] - s * h;
+							}
+						}
+
+						p = -s * s2 * c3 * el1 * e[l] / dl1;
+						e[l] = s * p;
+						d[l] = c * p;
+
+					} while (std::abs(e[l]) > eps * tst1);
+				}
+
+				d[l] += f;
+				e[l] = 0;
+			}
+
+			// Sort the values (and the vectors) in increasing order
+			for (long i = 0; i < n - 1; i++)
+			{
+				long k = i;
+
+				for (long j = i + 1; j < n; j++)
+					if (d[j] < d[k]) k = j;
+
+				if (k != i)
+				{
+					std::swap(d[k], d[i]);
+
+					for (long j = 0; j < n; j++)
+						std::swap(vectors[j][i], vectors[j][k]);
+				}
+			}
+
+			for (long i = 0; i < n; i++)
+				values[i][0] = d[i];
+		}
+
 
 		void inverse(const data::Storage& l, const data::Storage& u, data::Storage& result) noexcept
 		{
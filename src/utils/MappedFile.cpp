@@ -0,0 +1,174 @@
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+
+#include"../../includes/utils/MappedFile.h"
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include<windows.h>
+#else
+#include<fcntl.h>
+#include<sys/mman.h>
+#include<sys/stat.h>
+#include<unistd.h>
+#endif
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	namespace utils
+	{
+		/*
+			Mapped file class members
+		*/
+
+		MappedFile::MappedFile(const std::string& filename) // throws std::runtime_error
+		{
+			/*
+				The whole file is mapped read only and shared, so every process mapping it reads the same pages of the page cache
+			*/
+			_data = nullptr;
+			_size = 0;
+			_file = nullptr;
+			_mapping = nullptr;
+
+#ifdef _WIN32
+			HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+			if (file == INVALID_HANDLE_VALUE) throw std::runtime_error("<In function cmll::utils::MappedFile::MappedFile()>Error : Could not open " + filename);
+
+			LARGE_INTEGER size;
+
+			if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+			{
+				CloseHandle(file);
+				throw std::runtime_error("<In function cmll::utils::MappedFile::MappedFile()>Error : " + filename + " is empty");
+			}
+
+			HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			const void* view = (mapping != nullptr) ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+
+			if (view == nullptr)
+			{
+				if (mapping != nullptr) CloseHandle(mapping);
+				CloseHandle(file);
+				throw std::runtime_error("<In function cmll::utils::MappedFile::MappedFile()>Error : Could not map " + filename);
+			}
+
+			_data = static_cast<const char*>(view);
+			_size = static_cast<std::size_t>(size.QuadPart);
+			_file = file;
+			_mapping = mapping;
+#else
+			int descriptor = open(filename.c_str(), O_RDONLY);
+
+			if (descriptor < 0) throw std::runtime_error("<In function cmll::utils::MappedFile::MappedFile()>Error : Could not open " + filename);
+
+			struct stat status;
+
+			if (fstat(descriptor, &status) != 0 || status.st_size == 0)
+			{
+				close(descriptor);
+				throw std::runtime_error("<In function cmll::utils::MappedFile::MappedFile()>Error : " + filename + " is empty");
+			}
+
+			void* view = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED, descriptor, 0);
+
+			// The mapping stays valid after the descriptor is closed
+			close(descriptor);
+
+			if (view == MAP_FAILED) throw std::runtime_error("<In function cmll::utils::MappedFile::MappedFile()>Error : Could not map " + filename);
+
+			_data = static_cast<const char*>(view);
+			_size = static_cast<std::size_t>(status.st_size);
+#endif
+		}
+
+		MappedFile::~MappedFile()
+		{
+#ifdef _WIN32
+			if (_data != nullptr) UnmapViewOfFile(_data);
+			if (_mapping != nullptr) CloseHandle(static_cast<HANDLE>(_mapping));
+			if (_file != nullptr) CloseHandle(static_cast<HANDLE>(_file));
+#else
+			if (_data != nullptr) munmap(const_cast<char*>(_data), _size);
+#endif
+		}
+
+		const char* MappedFile::data() const noexcept
+		{
+			return _data;
+		}
+
+		std::size_t MappedFile::size() const noexcept
+		{
+			return _size;
+		}
+
+		/*
+			Memory buffer class members
+		*/
+
+		MemoryBuffer::MemoryBuffer(const char* data, const std::size_t& size)
+		{
+			/*
+				The get area is the whole block. std::streambuf only reads through it, the const_cast does not lead to writes
+			*/
+			char* begin = const_cast<char*>(data);
+
+			setg(begin, begin, begin + size);
+		}
+
+		const char* MemoryBuffer::position() const noexcept
+		{
+			return gptr();
+		}
+
+		MemoryBuffer::pos_type MemoryBuffer::seekoff(off_type offset, std::ios_base::seekdir direction, std::ios_base::openmode which)
+		{
+			/*
+				Only the get area exists, so a request for the put position fails
+			*/
+			char* base = (direction == std::ios_base::beg) ? eback() : (direction == std::ios_base::cur) ? gptr() : egptr();
+
+			if (!(which & std::ios_base::in) || (which & std::ios_base::out)) return pos_type(off_type(-1));
+
+			if (offset < eback() - base || offset > egptr() - base) return pos_type(off_type(-1));
+
+			setg(eback(), base + offset, egptr());
+
+			return pos_type(gptr() - eback());
+		}
+
+		MemoryBuffer::pos_type MemoryBuffer::seekpos(pos_type position, std::ios_base::openmode which)
+		{
+			return seekoff(off_type(position), std::ios_base::beg, which);
+		}
+	}
+}
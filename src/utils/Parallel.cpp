@@ -0,0 +1,89 @@
+/*
+
+	* Project title : CMLL :  C++'s Machine Learning Library
+
+	* Project Author : Imanpal Singh <Imanpalsingh@gmail.com>
+
+	* Project creation date : February 8, 2020
+
+	* Project description : A modern C++ Machine Learning library that uses the STL for easier creation and deployment of Machine Learning models
+*/
+
+/*
+
+	* Project version 0.1.0
+	* File version 0.1.0
+	* Date created : October 19, 2026
+	* Last modified : October 19, 2026
+
+	* Change logs (0.1.0)
+
+			None
+
+	Note :  For earlier change logs of version before the current one, refer to backups folder
+*/
+
+#include"../../includes/utils/Parallel.h"
+
+/*
+	Parent name space : All name spaces lie under this parent name space
+*/
+namespace cmll
+{
+	namespace utils
+	{
+		namespace parallel
+		{
+			void forEach(const std::size_t& begin, const std::size_t& end, const std::function<void(std::size_t, std::size_t)>& body, const std::size_t& threads, const std::size_t& grain)
+			{
+				/*
+					A shared counter hands out the blocks. The calling thread works too, so a single thread (or a single block)
+					never starts a new thread
+				*/
+				if (end <= begin) return;
+
+				std::size_t block = (grain == 0) ? 1 : grain;
+				std::size_t blocks = (end - begin + block - 1) / block;
+				std::size_t workers = std::min(parallel::threads(threads), blocks);
+
+				std::atomic<std::size_t> next(0);
+
+				auto work = [&]()
+				{
+					for (std::size_t index = next.fetch_add(1); index < blocks; index = next.fetch_add(1))
+					{
+						std::size_t first = begin + index * block;
+						body(first, std::min(end, first + block));
+					}
+				};
+
+				std::vector<std::thread> pool;
+				pool.reserve(workers - 1);
+
+				for (std::size_t worker = 1; worker < workers; ++worker)
+				{
+					pool.emplace_back(work);
+				}
+
+				work();
+
+				for (std::thread& thread : pool)
+				{
+					thread.join();
+				}
+			}
+
+			std::size_t threads(const std::size_t& requested) noexcept
+			{
+				/*
+					hardware_concurrency() may return 0 when it is not known
+				*/
+				if (requested > 0) return requested;
+
+				std::size_t hardware = std::thread::hardware_concurrency();
+
+				return (hardware > 0) ? hardware : 1;
+			}
+		}
+	}
+}